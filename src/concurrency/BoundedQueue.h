@@ -0,0 +1,143 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "exceptions/PhotoStudioExceptions.h"
+
+/**
+ * BoundedQueue - Fixed-capacity lock-free multi-producer queue
+ *
+ * Each cell carries a sequence number that tells producers and consumers
+ * whose turn it is, so a push or pop is one compare-and-swap on a shared
+ * position plus a move into or out of the cell. The queue never blocks
+ * and never allocates after construction: tryPush fails when the queue
+ * is full and tryPop fails when it is empty.
+ *
+ * Capacity is rounded up to a power of two.
+ */
+template <typename T>
+class BoundedQueue
+{
+private:
+  struct Cell
+  {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  Cell *cells;
+  std::size_t capacity;
+  std::size_t mask;
+
+  // Kept on separate cache lines so producers and the consumer don't share one
+  alignas(64) std::atomic<std::size_t> enqueuePos;
+  alignas(64) std::atomic<std::size_t> dequeuePos;
+
+public:
+  explicit BoundedQueue(std::size_t requestedCapacity)
+      : cells(nullptr), capacity(1), mask(0), enqueuePos(0), dequeuePos(0)
+  {
+    if (requestedCapacity == 0)
+    {
+      throw InvalidDataException(
+          "Queue capacity must be positive",
+          "Precondition violation: requestedCapacity == 0");
+    }
+
+    while (capacity < requestedCapacity)
+    {
+      capacity *= 2;
+    }
+    mask = capacity - 1;
+
+    cells = new Cell[capacity];
+    for (std::size_t i = 0; i < capacity; i++)
+    {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~BoundedQueue()
+  {
+    delete[] cells;
+    cells = nullptr;
+  }
+
+  // Disable copy - cells are owned by the queue
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+  bool tryPush(T &&value)
+  {
+    std::size_t position = enqueuePos.load(std::memory_order_relaxed);
+    Cell *cell;
+    while (true)
+    {
+      cell = &cells[position & mask];
+      std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+      if (difference == 0)
+      {
+        if (enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (difference < 0)
+      {
+        return false; // Full
+      }
+      else
+      {
+        position = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->value = std::move(value);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool tryPop(T &value)
+  {
+    std::size_t position = dequeuePos.load(std::memory_order_relaxed);
+    Cell *cell;
+    while (true)
+    {
+      cell = &cells[position & mask];
+      std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+
+      if (difference == 0)
+      {
+        if (dequeuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (difference < 0)
+      {
+        return false; // Empty, or the next push is still being written
+      }
+      else
+      {
+        position = dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+
+    value = std::move(cell->value);
+    cell->sequence.store(position + capacity, std::memory_order_release);
+    return true;
+  }
+
+  std::size_t getCapacity() const
+  {
+    return capacity;
+  }
+};
+
+#endif // BOUNDED_QUEUE_H
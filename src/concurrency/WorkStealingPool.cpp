@@ -0,0 +1,167 @@
+#include "concurrency/WorkStealingPool.h"
+
+thread_local const WorkStealingPool *WorkStealingPool::currentPool = nullptr;
+thread_local unsigned WorkStealingPool::currentWorker = 0;
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount)
+    : queuedTasks(0), unfinishedTasks(0), nextQueue(0), stealCount(0),
+      failedTaskCount(0), stopping(false)
+{
+  if (threadCount == 0)
+  {
+    threadCount = std::thread::hardware_concurrency();
+  }
+  if (threadCount == 0)
+  {
+    threadCount = 1;
+  }
+
+  for (unsigned i = 0; i < threadCount; i++)
+  {
+    queues.push_back(std::make_unique<WorkerQueue>());
+  }
+
+  for (unsigned i = 0; i < threadCount; i++)
+  {
+    workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+  }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+  waitIdle();
+
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    stopping = true;
+  }
+  workAvailable.notify_all();
+
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+}
+
+void WorkStealingPool::push(unsigned index, Task task)
+{
+  unfinishedTasks++;
+  {
+    // Counted under stateMutex so a worker about to sleep cannot miss it
+    std::lock_guard<std::mutex> lock(stateMutex);
+    queuedTasks++;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(queues[index]->mutex);
+    queues[index]->tasks.push_back(std::move(task));
+  }
+  workAvailable.notify_one();
+}
+
+void WorkStealingPool::submit(Task task)
+{
+  unsigned index;
+  if (currentPool == this)
+  {
+    index = currentWorker;
+  }
+  else
+  {
+    index = nextQueue.fetch_add(1) % queues.size();
+  }
+  push(index, std::move(task));
+}
+
+bool WorkStealingPool::popLocal(unsigned index, Task &task)
+{
+  std::lock_guard<std::mutex> lock(queues[index]->mutex);
+  if (queues[index]->tasks.empty())
+  {
+    return false;
+  }
+  task = std::move(queues[index]->tasks.back());
+  queues[index]->tasks.pop_back();
+  return true;
+}
+
+bool WorkStealingPool::steal(unsigned thief, Task &task)
+{
+  for (std::size_t offset = 1; offset < queues.size(); offset++)
+  {
+    WorkerQueue &victim = *queues[(thief + offset) % queues.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty())
+    {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      stealCount++;
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingPool::finishTask()
+{
+  if (--unfinishedTasks == 0)
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    allIdle.notify_all();
+  }
+}
+
+void WorkStealingPool::workerLoop(unsigned index)
+{
+  currentPool = this;
+  currentWorker = index;
+
+  while (true)
+  {
+    Task task;
+    if (popLocal(index, task) || steal(index, task))
+    {
+      queuedTasks--;
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+        failedTaskCount++;
+      }
+      finishTask();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+    workAvailable.wait(lock, [this]()
+                       { return stopping || queuedTasks.load() > 0; });
+    if (stopping && queuedTasks.load() == 0)
+    {
+      return;
+    }
+  }
+}
+
+void WorkStealingPool::waitIdle()
+{
+  std::unique_lock<std::mutex> lock(stateMutex);
+  allIdle.wait(lock, [this]()
+               { return unfinishedTasks.load() == 0; });
+}
+
+unsigned WorkStealingPool::getThreadCount() const
+{
+  return static_cast<unsigned>(workers.size());
+}
+
+std::uint64_t WorkStealingPool::getStealCount() const
+{
+  return stealCount.load();
+}
+
+std::uint64_t WorkStealingPool::getFailedTaskCount() const
+{
+  return failedTaskCount.load();
+}
@@ -0,0 +1,79 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * WorkStealingPool - Fixed set of worker threads with one task deque each
+ *
+ * - submit() spreads tasks round-robin over the worker deques; a task
+ *   submitted from inside a worker goes to that worker's own deque
+ * - a worker takes its own tasks from the back (most recent first)
+ * - a worker whose deque is empty steals from the front of another
+ *   worker's deque, so uneven chunks of work even out across cores
+ * - waitIdle() blocks until every submitted task has finished
+ *
+ * Each deque has its own small mutex; there is no global queue lock.
+ * Exceptions escaping a task are caught and counted, not rethrown.
+ */
+class WorkStealingPool
+{
+public:
+  typedef std::function<void()> Task;
+
+private:
+  struct WorkerQueue
+  {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  std::vector<std::thread> workers;
+
+  std::mutex stateMutex;
+  std::condition_variable workAvailable;
+  std::condition_variable allIdle;
+
+  std::atomic<std::size_t> queuedTasks;     // Tasks waiting in some deque
+  std::atomic<std::size_t> unfinishedTasks; // Queued or running
+  std::atomic<unsigned> nextQueue;
+  std::atomic<std::uint64_t> stealCount;
+  std::atomic<std::uint64_t> failedTaskCount;
+  bool stopping;
+
+  // Pool and deque index of the worker running on the current thread, if any
+  static thread_local const WorkStealingPool *currentPool;
+  static thread_local unsigned currentWorker;
+
+  void workerLoop(unsigned index);
+  bool popLocal(unsigned index, Task &task);
+  bool steal(unsigned thief, Task &task);
+  void push(unsigned index, Task task);
+  void finishTask();
+
+public:
+  explicit WorkStealingPool(unsigned threadCount = 0); // 0 = one per hardware thread
+  ~WorkStealingPool();
+
+  // Disable copy - workers hold a pointer to the pool
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  void submit(Task task);
+  void waitIdle();
+
+  unsigned getThreadCount() const;
+  std::uint64_t getStealCount() const;
+  std::uint64_t getFailedTaskCount() const;
+};
+
+#endif // WORK_STEALING_POOL_H
@@ -5,12 +5,12 @@ Client::Client(const std::string &id, const std::string &sname)
 {
 }
 
-std::string Client::getSurname() const
+const std::string &Client::getSurname() const
 {
   return surname;
 }
 
-std::string Client::getID() const
+const std::string &Client::getID() const
 {
   return clientID;
 }
@@ -12,8 +12,8 @@ private:
 public:
   Client(const std::string &id, const std::string &sname);
 
-  std::string getSurname() const;
-  std::string getID() const;
+  const std::string &getSurname() const;
+  const std::string &getID() const;
 };
 
 #endif // CLIENT_H
@@ -1,70 +1,367 @@
 #include "entities/Consumable.h"
 #include "exceptions/PhotoStudioExceptions.h"
+#include <cmath>
 
-Consumable::Consumable(const std::string &id, const std::string &n, int stock, const std::string &unit)
-    : consumableID(id), name(n), currentStock(stock), unitOfMeasure(unit)
+Consumable::Consumable(const std::string &id, const std::string &n, int stock, const std::string &unit,
+                       double unitCost)
+    : consumableID(id), name(n), stockState(packStock(stock, 0)), unitOfMeasure(unit),
+      unitCostCents(std::llround(unitCost * 100.0)),
+      reorderLevel(-1), reorderHysteresis(0)
 {
   // Data validation in constructor
+  tryValidate(id, n, stock, unit, unitCost).throwIfError();
+}
+
+ValidationResult Consumable::tryValidate(const std::string &id, const std::string &n, int stock,
+                                         const std::string &unit, double unitCost)
+{
   if (id.empty())
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Consumable ID cannot be empty",
         "Data validation failed in Consumable constructor");
   }
 
   if (n.empty())
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Consumable name cannot be empty",
         "Data validation failed in Consumable constructor");
   }
 
   if (stock < 0)
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Initial stock cannot be negative",
         "Data validation failed: stock < 0");
   }
 
   if (unit.empty())
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Unit of measure cannot be empty",
         "Data validation failed in Consumable constructor");
   }
+
+  if (!(unitCost >= 0.0))
+  {
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
+        "Unit cost cannot be negative",
+        "Data validation failed: unitCost < 0");
+  }
+
+  return ValidationResult::ok();
+}
+
+std::uint64_t Consumable::packStock(int stock, int reserved)
+{
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(stock)) << 32) |
+         static_cast<std::uint32_t>(reserved);
+}
+
+int Consumable::stockOf(std::uint64_t packed)
+{
+  return static_cast<int>(static_cast<std::uint32_t>(packed >> 32) & 0x7FFFFFFFu);
+}
+
+int Consumable::reservedOf(std::uint64_t packed)
+{
+  return static_cast<int>(static_cast<std::uint32_t>(packed));
+}
+
+void Consumable::showStock(int stock, const IDisplay *display) const
+{
+  if (display)
+  {
+    display->log(LogLevel::INFO, "Stock updated for {}: {} {}", name, stock, unitOfMeasure);
+  }
+}
+
+/**
+ * NextState - Packed state after a change to stock and reserved
+ *
+ * Carries the low-stock flag over from current, setting it at or below
+ * the reorder level and clearing it at the reorder level plus hysteresis.
+ */
+std::uint64_t Consumable::nextState(std::uint64_t current, int stock, int reserved) const
+{
+  bool low = (current & LOW_STOCK_FLAG) != 0;
+  if (reorderLevel >= 0)
+  {
+    if (stock <= reorderLevel)
+    {
+      low = true;
+    }
+    else if (stock - reorderHysteresis >= reorderLevel)
+    {
+      low = false;
+    }
+  }
+  return packStock(stock, reserved) | (low ? LOW_STOCK_FLAG : 0);
+}
+
+// Called by the thread whose compare-and-swap moved the state from before to after
+void Consumable::stockChanged(std::uint64_t before, std::uint64_t after, const IDisplay *display)
+{
+  showStock(stockOf(after), display);
+
+  bool wasLow = (before & LOW_STOCK_FLAG) != 0;
+  bool isLow = (after & LOW_STOCK_FLAG) != 0;
+  if (!wasLow && isLow)
+  {
+    publishAlert(StockAlertType::LOW_STOCK, stockOf(after));
+  }
+  else if (wasLow && !isLow)
+  {
+    publishAlert(StockAlertType::RECOVERED, stockOf(after));
+  }
+}
+
+void Consumable::publishAlert(StockAlertType type, int stock)
+{
+  StockAlert alert{this, type, stock, reorderLevel};
+  for (IStockAlertListener *listener : alertListeners)
+  {
+    listener->onStockAlert(alert);
+  }
+}
+
+void Consumable::setReorderLevel(int level, int hysteresis)
+{
+  if (hysteresis < 0)
+  {
+    throw InvalidDataException(
+        "Reorder hysteresis cannot be negative",
+        "Precondition violation: hysteresis < 0");
+  }
+  reorderLevel = level;
+  reorderHysteresis = hysteresis;
+
+  // Decided from the stock in the same compare-and-swap, so a stock
+  // already at or below the new level raises the alert right away
+  std::uint64_t current = stockState.load(std::memory_order_acquire);
+  std::uint64_t next;
+  do
+  {
+    next = nextState(current & ~LOW_STOCK_FLAG, stockOf(current), reservedOf(current));
+  } while (!stockState.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_acquire));
+
+  bool wasLow = (current & LOW_STOCK_FLAG) != 0;
+  bool isLow = (next & LOW_STOCK_FLAG) != 0;
+  if (!wasLow && isLow)
+  {
+    publishAlert(StockAlertType::LOW_STOCK, stockOf(next));
+  }
+  else if (wasLow && !isLow)
+  {
+    publishAlert(StockAlertType::RECOVERED, stockOf(next));
+  }
+}
+
+int Consumable::getReorderLevel() const
+{
+  return reorderLevel;
+}
+
+int Consumable::getReorderHysteresis() const
+{
+  return reorderHysteresis;
+}
+
+bool Consumable::isLowStock() const
+{
+  return (stockState.load(std::memory_order_acquire) & LOW_STOCK_FLAG) != 0;
+}
+
+void Consumable::addAlertListener(IStockAlertListener *listener)
+{
+  if (listener == nullptr)
+  {
+    throw InvalidDataException(
+        "Stock alert listener cannot be null",
+        "Precondition violation: listener == nullptr");
+  }
+  alertListeners.push_back(listener);
+}
+
+void Consumable::removeAlertListener(IStockAlertListener *listener)
+{
+  for (auto it = alertListeners.begin(); it != alertListeners.end(); ++it)
+  {
+    if (*it == listener)
+    {
+      alertListeners.erase(it);
+      return;
+    }
+  }
 }
 
 void Consumable::updateStock(int quantity, const IDisplay *display)
 {
-  int newStock = currentStock + quantity;
+  std::uint64_t current = stockState.load(std::memory_order_acquire);
+  std::uint64_t next;
+  do
+  {
+    long long newStock = static_cast<long long>(stockOf(current)) + quantity;
 
-  if (newStock < 0)
+    if (newStock > MAX_STOCK)
+    {
+      throw InvalidDataException(
+          "Stock cannot exceed " + std::to_string(MAX_STOCK) + " " + unitOfMeasure,
+          "Stock update would overflow: current=" + std::to_string(stockOf(current)) +
+              ", change=" + std::to_string(quantity));
+    }
+
+    if (newStock < 0)
+    {
+      throw BusinessRuleException(
+          "Cannot reduce stock below zero",
+          "Stock update would result in negative stock: current=" +
+              std::to_string(stockOf(current)) + ", change=" + std::to_string(quantity));
+    }
+
+    if (newStock < reservedOf(current))
+    {
+      throw BusinessRuleException(
+          "Cannot reduce stock below the reserved amount",
+          "Stock update would break reservations: current=" + std::to_string(stockOf(current)) +
+              ", reserved=" + std::to_string(reservedOf(current)) + ", change=" + std::to_string(quantity));
+    }
+    next = nextState(current, static_cast<int>(newStock), reservedOf(current));
+  } while (!stockState.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_acquire));
+
+  stockChanged(current, next, display);
+}
+
+/**
+ * TryConsume - Take quantity units if that many are available
+ *
+ * Retries the compare-and-swap until it either succeeds or sees that the
+ * available stock (on hand minus reserved) is too small.
+ */
+bool Consumable::tryConsume(int quantity, const IDisplay *display)
+{
+  if (quantity <= 0)
   {
-    throw BusinessRuleException(
-        "Cannot reduce stock below zero",
-        "Stock update would result in negative stock: current=" +
-            std::to_string(currentStock) + ", change=" + std::to_string(quantity));
+    throw InvalidDataException(
+        "Quantity must be greater than zero",
+        "Precondition violation: quantity <= 0");
   }
 
-  currentStock = newStock;
+  std::uint64_t current = stockState.load(std::memory_order_acquire);
+  std::uint64_t next;
+  do
+  {
+    if (stockOf(current) - reservedOf(current) < quantity)
+    {
+      return false;
+    }
+    next = nextState(current, stockOf(current) - quantity, reservedOf(current));
+  } while (!stockState.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_acquire));
 
-  if (display)
+  stockChanged(current, next, display);
+  return true;
+}
+
+bool Consumable::tryReserve(int quantity)
+{
+  if (quantity <= 0)
   {
-    display->showLine("Stock updated for " + name + ": " + std::to_string(currentStock) + " " + unitOfMeasure);
+    throw InvalidDataException(
+        "Quantity must be greater than zero",
+        "Precondition violation: quantity <= 0");
   }
+
+  // Reserved never exceeds stock on hand, so passing this check also keeps
+  // the sum inside the 32-bit reserved field
+  std::uint64_t current = stockState.load(std::memory_order_acquire);
+  do
+  {
+    long long reserved = static_cast<long long>(reservedOf(current)) + quantity;
+    if (reserved > stockOf(current))
+    {
+      return false;
+    }
+  } while (!stockState.compare_exchange_weak(current,
+                                             packStock(stockOf(current), reservedOf(current) + quantity) |
+                                                 (current & LOW_STOCK_FLAG),
+                                             std::memory_order_acq_rel, std::memory_order_acquire));
+  return true;
+}
+
+void Consumable::commitReserved(int quantity, const IDisplay *display)
+{
+  std::uint64_t current = stockState.load(std::memory_order_acquire);
+  std::uint64_t next;
+  do
+  {
+    if (quantity <= 0 || reservedOf(current) < quantity)
+    {
+      throw BusinessRuleException(
+          "Cannot commit more stock than was reserved",
+          "Reservation violation: reserved=" + std::to_string(reservedOf(current)) +
+              ", commit=" + std::to_string(quantity));
+    }
+    next = nextState(current, stockOf(current) - quantity, reservedOf(current) - quantity);
+  } while (!stockState.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_acquire));
+
+  stockChanged(current, next, display);
+}
+
+void Consumable::releaseReserved(int quantity)
+{
+  std::uint64_t current = stockState.load(std::memory_order_acquire);
+  do
+  {
+    if (quantity <= 0 || reservedOf(current) < quantity)
+    {
+      throw BusinessRuleException(
+          "Cannot release more stock than was reserved",
+          "Reservation violation: reserved=" + std::to_string(reservedOf(current)) +
+              ", release=" + std::to_string(quantity));
+    }
+  } while (!stockState.compare_exchange_weak(current,
+                                             packStock(stockOf(current), reservedOf(current) - quantity) |
+                                                 (current & LOW_STOCK_FLAG),
+                                             std::memory_order_acq_rel, std::memory_order_acquire));
+}
+
+StockReservation Consumable::reserve(int quantity)
+{
+  if (!tryReserve(quantity))
+  {
+    return StockReservation();
+  }
+  return StockReservation(this, quantity);
 }
 
 int Consumable::getCurrentStock() const
 {
-  return currentStock;
+  return stockOf(stockState.load(std::memory_order_acquire));
 }
 
-std::string Consumable::getName() const
+int Consumable::getReservedStock() const
+{
+  return reservedOf(stockState.load(std::memory_order_acquire));
+}
+
+int Consumable::getAvailableStock() const
+{
+  std::uint64_t current = stockState.load(std::memory_order_acquire);
+  return stockOf(current) - reservedOf(current);
+}
+
+const std::string &Consumable::getName() const
 {
   return name;
 }
 
-std::string Consumable::getConsumableID() const
+const std::string &Consumable::getConsumableID() const
 {
   return consumableID;
 }
@@ -73,3 +370,84 @@ std::string Consumable::getUnitOfMeasure() const
 {
   return unitOfMeasure;
 }
+
+void Consumable::setUnitCost(double cost)
+{
+  if (!(cost >= 0.0))
+  {
+    throw InvalidDataException(
+        "Unit cost cannot be negative",
+        "Precondition violation: cost < 0");
+  }
+  unitCostCents.store(std::llround(cost * 100.0), std::memory_order_relaxed);
+}
+
+double Consumable::getUnitCost() const
+{
+  return unitCostCents.load(std::memory_order_relaxed) / 100.0;
+}
+
+long long Consumable::getUnitCostCents() const
+{
+  return unitCostCents.load(std::memory_order_relaxed);
+}
+
+StockReservation::~StockReservation()
+{
+  releaseQuietly();
+}
+
+StockReservation::StockReservation(StockReservation &&other) noexcept
+    : consumable(other.consumable), quantity(other.quantity)
+{
+  other.consumable = nullptr;
+  other.quantity = 0;
+}
+
+StockReservation &StockReservation::operator=(StockReservation &&other) noexcept
+{
+  if (this != &other)
+  {
+    releaseQuietly();
+    consumable = other.consumable;
+    quantity = other.quantity;
+    other.consumable = nullptr;
+    other.quantity = 0;
+  }
+  return *this;
+}
+
+void StockReservation::commit(const IDisplay *display)
+{
+  if (!consumable)
+  {
+    throw BusinessRuleException(
+        "Stock reservation is no longer active",
+        "Precondition violation: commit on an inactive reservation");
+  }
+  Consumable *target = consumable;
+  consumable = nullptr;
+  target->commitReserved(quantity, display);
+}
+
+void StockReservation::releaseQuietly() noexcept
+{
+  try
+  {
+    release();
+  }
+  catch (const PhotoStudioException &)
+  {
+    // Only possible if the reserved count was changed behind our back
+  }
+}
+
+void StockReservation::release()
+{
+  if (consumable)
+  {
+    Consumable *target = consumable;
+    consumable = nullptr;
+    target->releaseReserved(quantity);
+  }
+}
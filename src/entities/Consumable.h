@@ -1,27 +1,138 @@
 #ifndef CONSUMABLE_H
 #define CONSUMABLE_H
 
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "interfaces/IDisplay.h"
+#include "interfaces/IStockAlertListener.h"
 #include "exceptions/PhotoStudioExceptions.h"
+#include "types/ValidationResult.h"
 
+class StockReservation;
+
+/**
+ * Consumable - A stocked material (paper, developer, ...)
+ *
+ * Stock on hand and the amount held by reservations are packed into one
+ * atomic word, so every check-and-change is a single compare-and-swap:
+ * - tryConsume(n) takes n units if that many are available right now
+ * - tryReserve(n) holds n units for later; commitReserved(n) takes them,
+ *   releaseReserved(n) gives them back
+ * Available stock is stock on hand minus reserved stock, so concurrent
+ * callers can never take or reserve more than exists.
+ *
+ * An optional reorder level is checked after every change of stock on
+ * hand with one comparison. Falling to or below it sends LOW_STOCK to the
+ * alert listeners once; RECOVERED is sent, and the alert re-armed, only
+ * when stock climbs back to the reorder level plus the hysteresis, so a
+ * level hovering around the threshold does not repeat the alert. The
+ * alert state is a bit in the same atomic word and is decided in the same
+ * compare-and-swap as the stock change. So it always matches the stock,
+ * and each crossing is reported by exactly one thread.
+ */
 class Consumable
 {
 private:
   std::string consumableID;
   std::string name;
-  int currentStock;
+  // Low-stock alert flag (bit 63), stock on hand (bits 32-62) and
+  // reserved amount (low 32 bits)
+  std::atomic<std::uint64_t> stockState;
   std::string unitOfMeasure;
+  std::atomic<long long> unitCostCents; // Purchase cost of one unit
+
+  // Reorder alerting; configured before worker threads start
+  int reorderLevel; // Negative = no alerts
+  int reorderHysteresis;
+  std::vector<IStockAlertListener *> alertListeners;
+
+  static const std::uint64_t LOW_STOCK_FLAG = 1ULL << 63;
+
+  static std::uint64_t packStock(int stock, int reserved);
+  static int stockOf(std::uint64_t packed);
+  static int reservedOf(std::uint64_t packed);
+  std::uint64_t nextState(std::uint64_t current, int stock, int reserved) const;
+  void showStock(int stock, const IDisplay *display) const;
+  void stockChanged(std::uint64_t before, std::uint64_t after, const IDisplay *display);
+  void publishAlert(StockAlertType type, int stock);
 
 public:
-  Consumable(const std::string &id, const std::string &n, int stock, const std::string &unit);
+  static const int MAX_STOCK = 0x7FFFFFFF; // Largest stock the 31-bit field holds
+
+  Consumable(const std::string &id, const std::string &n, int stock, const std::string &unit,
+             double unitCost = 0.0);
+
+  // Constructor checks without throwing (for bulk imports)
+  static ValidationResult tryValidate(const std::string &id, const std::string &n, int stock,
+                                      const std::string &unit, double unitCost = 0.0);
+
+  // Disable copy - stock is shared state
+  Consumable(const Consumable &) = delete;
+  Consumable &operator=(const Consumable &) = delete;
 
   void updateStock(int quantity, const IDisplay *display);
 
+  // Lock-free stock operations; false means not enough available stock
+  bool tryConsume(int quantity, const IDisplay *display = nullptr);
+  bool tryReserve(int quantity);
+  void commitReserved(int quantity, const IDisplay *display = nullptr);
+  void releaseReserved(int quantity);
+  StockReservation reserve(int quantity); // Inactive reservation if not enough stock
+
   int getCurrentStock() const;
-  std::string getName() const;
-  std::string getConsumableID() const;
+  int getReservedStock() const;
+  int getAvailableStock() const;
+
+  // Re-arms the alert and checks the current stock against the new level
+  void setReorderLevel(int level, int hysteresis = 0);
+  int getReorderLevel() const;
+  int getReorderHysteresis() const;
+  bool isLowStock() const; // Between a LOW_STOCK alert and its RECOVERED
+  void addAlertListener(IStockAlertListener *listener);
+  void removeAlertListener(IStockAlertListener *listener);
+  const std::string &getName() const;
+  const std::string &getConsumableID() const;
   std::string getUnitOfMeasure() const;
+
+  // Cost is kept in whole cents so that material cost sums are exact
+  void setUnitCost(double cost);
+  double getUnitCost() const;
+  long long getUnitCostCents() const;
+};
+
+/**
+ * StockReservation - Units held on one consumable until committed
+ *
+ * Move-only. A reservation that is neither committed nor released gives
+ * its units back when it is destroyed, so an abandoned job never leaks
+ * reserved stock.
+ */
+class StockReservation
+{
+private:
+  Consumable *consumable;
+  int quantity;
+
+  void releaseQuietly() noexcept;
+
+public:
+  StockReservation() : consumable(nullptr), quantity(0) {}
+  StockReservation(Consumable *c, int qty) : consumable(c), quantity(qty) {}
+  ~StockReservation();
+
+  StockReservation(StockReservation &&other) noexcept;
+  StockReservation &operator=(StockReservation &&other) noexcept;
+  StockReservation(const StockReservation &) = delete;
+  StockReservation &operator=(const StockReservation &) = delete;
+
+  bool isActive() const { return consumable != nullptr; }
+  Consumable *getConsumable() const { return consumable; }
+  int getQuantity() const { return quantity; }
+
+  void commit(const IDisplay *display = nullptr);
+  void release();
 };
 
 #endif // CONSUMABLE_H
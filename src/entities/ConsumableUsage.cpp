@@ -1,30 +1,46 @@
 #include "entities/ConsumableUsage.h"
 #include "exceptions/PhotoStudioExceptions.h"
+#include <chrono>
 
 ConsumableUsage::ConsumableUsage(const std::string &id, const std::string &name, int qty)
-    : usageID(id), consumableName(name), quantityUsed(qty)
+    : ConsumableUsage(id, name, qty, now())
+{
+}
+
+ConsumableUsage::ConsumableUsage(const std::string &id, const std::string &name, int qty, std::int64_t timestamp)
+    : usageID(id), consumableName(name), quantityUsed(qty), usedAt(timestamp), orderID("")
 {
   // Data validation in constructor
+  tryValidate(id, name, qty).throwIfError();
+}
+
+ValidationResult ConsumableUsage::tryValidate(const std::string &id, const std::string &name, int qty)
+{
   if (id.empty())
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Usage ID cannot be empty",
         "Data validation failed in ConsumableUsage constructor");
   }
 
   if (name.empty())
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Consumable name cannot be empty",
         "Data validation failed in ConsumableUsage constructor");
   }
 
   if (qty <= 0)
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Usage quantity must be positive",
         "Data validation failed: quantity <= 0");
   }
+
+  return ValidationResult::ok();
 }
 
 std::string ConsumableUsage::getUsageID() const
@@ -32,7 +48,7 @@ std::string ConsumableUsage::getUsageID() const
   return usageID;
 }
 
-std::string ConsumableUsage::getConsumableName() const
+const std::string &ConsumableUsage::getConsumableName() const
 {
   return consumableName;
 }
@@ -41,3 +57,30 @@ int ConsumableUsage::getQuantityUsed() const
 {
   return quantityUsed;
 }
+
+std::int64_t ConsumableUsage::getUsedAt() const
+{
+  return usedAt;
+}
+
+void ConsumableUsage::assignOrder(const std::string &oID)
+{
+  orderID = oID;
+}
+
+const std::string &ConsumableUsage::getOrderID() const
+{
+  return orderID;
+}
+
+bool ConsumableUsage::hasOrder() const
+{
+  return !orderID.empty();
+}
+
+std::int64_t ConsumableUsage::now()
+{
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
@@ -1,8 +1,10 @@
 #ifndef CONSUMABLE_USAGE_H
 #define CONSUMABLE_USAGE_H
 
+#include <cstdint>
 #include <string>
 #include "exceptions/PhotoStudioExceptions.h"
+#include "types/ValidationResult.h"
 
 class ConsumableUsage
 {
@@ -10,13 +12,27 @@ private:
   std::string usageID;
   std::string consumableName;
   int quantityUsed;
+  std::int64_t usedAt; // Seconds since the Unix epoch
+  std::string orderID; // Order the material was used for, empty if none
 
 public:
   ConsumableUsage(const std::string &id, const std::string &name, int qty);
+  ConsumableUsage(const std::string &id, const std::string &name, int qty, std::int64_t timestamp);
+
+  // Constructor checks without throwing (for bulk imports)
+  static ValidationResult tryValidate(const std::string &id, const std::string &name, int qty);
 
   std::string getUsageID() const;
-  std::string getConsumableName() const;
+  const std::string &getConsumableName() const;
   int getQuantityUsed() const;
+  std::int64_t getUsedAt() const;
+
+  // Links the usage to an order by its ID, which stays valid across restarts
+  void assignOrder(const std::string &oID);
+  const std::string &getOrderID() const;
+  bool hasOrder() const;
+
+  static std::int64_t now();
 };
 
 #endif // CONSUMABLE_USAGE_H
@@ -1,11 +1,11 @@
 #include "entities/Report.h"
 
-Report::Report(const std::string &id, ReportType type, const std::string &cont)
-    : reportID(id), reportType(type), content(cont)
+Report::Report(const std::string &id, ReportType type, std::string cont)
+    : reportID(id), reportType(type), content(std::move(cont))
 {
 }
 
-std::string Report::getContent() const
+const std::string &Report::getContent() const
 {
   return content;
 }
@@ -12,9 +12,9 @@ private:
   std::string content;
 
 public:
-  Report(const std::string &id, ReportType type, const std::string &cont);
+  Report(const std::string &id, ReportType type, std::string cont);
 
-  std::string getContent() const;
+  const std::string &getContent() const;
   ReportType getReportType() const;
   std::string getReportID() const;
 };
@@ -0,0 +1,271 @@
+#include "events/OrderChangeFeed.h"
+#include "exceptions/PhotoStudioExceptions.h"
+#include <chrono>
+#include <string>
+
+OrderChangeFeed::OrderChangeFeed(std::size_t requestedCapacity, FeedOverflowPolicy overflowPolicy)
+    : slots(nullptr), capacity(1), mask(0), policy(overflowPolicy),
+      head(0), publishedCount(0), droppedCount(0)
+{
+  if (requestedCapacity == 0)
+  {
+    throw InvalidDataException(
+        "Change feed capacity must be positive",
+        "Precondition violation: requestedCapacity == 0");
+  }
+
+  // Round up to a power of two so positions map to slots with a mask
+  while (capacity < requestedCapacity)
+  {
+    capacity *= 2;
+  }
+  mask = capacity - 1;
+
+  slots = new Slot[capacity];
+  for (std::size_t i = 0; i < capacity; i++)
+  {
+    slots[i].sequence.store(0, std::memory_order_relaxed);
+    slots[i].packedEvent.store(0, std::memory_order_relaxed);
+    slots[i].timestampNs.store(0, std::memory_order_relaxed);
+  }
+
+  for (auto &subscriber : subscribers)
+  {
+    subscriber.state.store(SUBSCRIBER_FREE, std::memory_order_relaxed);
+    subscriber.cursor.store(0, std::memory_order_relaxed);
+    subscriber.missed.store(0, std::memory_order_relaxed);
+  }
+}
+
+OrderChangeFeed::~OrderChangeFeed()
+{
+  delete[] slots;
+  slots = nullptr;
+}
+
+std::uint64_t OrderChangeFeed::pack(const OrderChangeEvent &event)
+{
+  return (static_cast<std::uint64_t>(event.orderHandle) << 32) |
+         (static_cast<std::uint64_t>(event.oldStatus) << 16) |
+         (static_cast<std::uint64_t>(event.newStatus) << 8) |
+         (event.paid ? 1u : 0u);
+}
+
+OrderChangeEvent OrderChangeFeed::unpack(std::uint64_t packed, std::int64_t timestamp)
+{
+  return OrderChangeEvent(static_cast<std::uint32_t>(packed >> 32),
+                          static_cast<OrderStatus>((packed >> 16) & 0xFF),
+                          static_cast<OrderStatus>((packed >> 8) & 0xFF),
+                          (packed & 1u) != 0,
+                          timestamp);
+}
+
+std::uint64_t OrderChangeFeed::slowestCursor(std::uint64_t fallback) const
+{
+  std::uint64_t slowest = fallback;
+  for (const auto &subscriber : subscribers)
+  {
+    if (subscriber.state.load(std::memory_order_acquire) == SUBSCRIBER_ACTIVE)
+    {
+      std::uint64_t cursor = subscriber.cursor.load(std::memory_order_acquire);
+      if (cursor < slowest)
+      {
+        slowest = cursor;
+      }
+    }
+  }
+  return slowest;
+}
+
+/**
+ * Publish - Append one event (single producer)
+ *
+ * The slot is marked odd while it is being written, so a subscriber that
+ * races with the write sees a sequence mismatch and retries.
+ */
+bool OrderChangeFeed::publish(const OrderChangeEvent &event)
+{
+  std::uint64_t position = head.load(std::memory_order_relaxed);
+
+  if (policy == FeedOverflowPolicy::DROP_NEWEST &&
+      position - slowestCursor(position) >= capacity)
+  {
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  Slot &slot = slots[position & mask];
+  slot.sequence.store(2 * position + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.packedEvent.store(pack(event), std::memory_order_relaxed);
+  slot.timestampNs.store(event.timestampNs, std::memory_order_relaxed);
+
+  slot.sequence.store(2 * position + 2, std::memory_order_release);
+  head.store(position + 1, std::memory_order_release);
+  publishedCount.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+int OrderChangeFeed::subscribe()
+{
+  for (int i = 0; i < MAX_SUBSCRIBERS; i++)
+  {
+    int expected = SUBSCRIBER_FREE;
+    if (subscribers[i].state.compare_exchange_strong(expected, SUBSCRIBER_CLAIMED))
+    {
+      // New subscribers start at the current end of the feed; the slot only
+      // counts for back-pressure once its cursor is set
+      subscribers[i].missed.store(0, std::memory_order_relaxed);
+      subscribers[i].cursor.store(head.load(std::memory_order_acquire), std::memory_order_release);
+      subscribers[i].state.store(SUBSCRIBER_ACTIVE, std::memory_order_release);
+      return i;
+    }
+  }
+
+  throw BusinessRuleException(
+      "Too many change feed subscribers",
+      "Subscriber limit reached: " + std::to_string(MAX_SUBSCRIBERS));
+}
+
+void OrderChangeFeed::unsubscribe(int subscriberID)
+{
+  if (subscriberID < 0 || subscriberID >= MAX_SUBSCRIBERS)
+  {
+    throw InvalidDataException(
+        "Invalid change feed subscriber",
+        "Subscriber ID out of range: " + std::to_string(subscriberID));
+  }
+  subscribers[subscriberID].state.store(SUBSCRIBER_FREE, std::memory_order_release);
+}
+
+/**
+ * Poll - Read the next event for one subscriber, if any
+ *
+ * A subscriber that fell more than a full ring behind (OVERWRITE_OLDEST)
+ * jumps to the oldest event still in the ring and adds the skipped events
+ * to its missed counter.
+ */
+bool OrderChangeFeed::poll(int subscriberID, OrderChangeEvent &event)
+{
+  if (subscriberID < 0 || subscriberID >= MAX_SUBSCRIBERS)
+  {
+    throw InvalidDataException(
+        "Invalid change feed subscriber",
+        "Subscriber ID out of range: " + std::to_string(subscriberID));
+  }
+
+  Subscriber &subscriber = subscribers[subscriberID];
+
+  while (true)
+  {
+    std::uint64_t cursor = subscriber.cursor.load(std::memory_order_relaxed);
+    std::uint64_t available = head.load(std::memory_order_acquire);
+
+    if (cursor >= available)
+    {
+      return false;
+    }
+
+    if (available - cursor > capacity)
+    {
+      subscriber.missed.fetch_add(available - capacity - cursor, std::memory_order_relaxed);
+      cursor = available - capacity;
+      subscriber.cursor.store(cursor, std::memory_order_release);
+    }
+
+    const Slot &slot = slots[cursor & mask];
+    std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before != 2 * cursor + 2)
+    {
+      // Overwritten or being overwritten - re-read head and skip ahead
+      continue;
+    }
+
+    std::uint64_t packed = slot.packedEvent.load(std::memory_order_relaxed);
+    std::int64_t timestamp = slot.timestampNs.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (slot.sequence.load(std::memory_order_relaxed) != before)
+    {
+      continue;
+    }
+
+    event = unpack(packed, timestamp);
+    subscriber.cursor.store(cursor + 1, std::memory_order_release);
+    return true;
+  }
+}
+
+void OrderChangeFeed::skipTo(int subscriberID, std::uint64_t position)
+{
+  if (subscriberID < 0 || subscriberID >= MAX_SUBSCRIBERS)
+  {
+    throw InvalidDataException(
+        "Invalid change feed subscriber",
+        "Subscriber ID out of range: " + std::to_string(subscriberID));
+  }
+
+  Subscriber &subscriber = subscribers[subscriberID];
+  if (position > subscriber.cursor.load(std::memory_order_relaxed))
+  {
+    subscriber.cursor.store(position, std::memory_order_release);
+  }
+}
+
+std::size_t OrderChangeFeed::getCapacity() const
+{
+  return capacity;
+}
+
+FeedOverflowPolicy OrderChangeFeed::getPolicy() const
+{
+  return policy;
+}
+
+std::uint64_t OrderChangeFeed::getHead() const
+{
+  return head.load(std::memory_order_acquire);
+}
+
+std::uint64_t OrderChangeFeed::getPublishedCount() const
+{
+  return publishedCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t OrderChangeFeed::getDroppedCount() const
+{
+  return droppedCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t OrderChangeFeed::getMissedCount(int subscriberID) const
+{
+  if (subscriberID < 0 || subscriberID >= MAX_SUBSCRIBERS)
+  {
+    return 0;
+  }
+  return subscribers[subscriberID].missed.load(std::memory_order_relaxed);
+}
+
+std::uint64_t OrderChangeFeed::getPendingCount(int subscriberID) const
+{
+  if (subscriberID < 0 || subscriberID >= MAX_SUBSCRIBERS)
+  {
+    return 0;
+  }
+  std::uint64_t available = head.load(std::memory_order_acquire);
+  std::uint64_t cursor = subscribers[subscriberID].cursor.load(std::memory_order_acquire);
+  if (cursor >= available)
+  {
+    return 0;
+  }
+  std::uint64_t pending = available - cursor;
+  return pending > capacity ? capacity : pending;
+}
+
+std::int64_t OrderChangeFeed::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
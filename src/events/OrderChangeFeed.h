@@ -0,0 +1,135 @@
+#ifndef ORDER_CHANGE_FEED_H
+#define ORDER_CHANGE_FEED_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "types/Types.h"
+
+/**
+ * OrderChangeEvent - Compact record of one order status or payment change
+ *
+ * orderHandle identifies the order inside OrderManager
+ * (see OrderManager::findOrderByHandle). A new order is reported with
+ * oldStatus == newStatus == PENDING and paid == false, and a payment
+ * (or a price change of a paid order) with oldStatus == newStatus and
+ * paid == true.
+ */
+struct OrderChangeEvent
+{
+  std::uint32_t orderHandle;
+  OrderStatus oldStatus;
+  OrderStatus newStatus;
+  bool paid;
+  std::int64_t timestampNs; // System clock, nanoseconds since epoch
+
+  OrderChangeEvent()
+      : orderHandle(0), oldStatus(OrderStatus::PENDING), newStatus(OrderStatus::PENDING),
+        paid(false), timestampNs(0) {}
+
+  OrderChangeEvent(std::uint32_t handle, OrderStatus from, OrderStatus to, bool isPaid,
+                   std::int64_t timestamp)
+      : orderHandle(handle), oldStatus(from), newStatus(to), paid(isPaid),
+        timestampNs(timestamp) {}
+};
+
+/**
+ * FeedOverflowPolicy - What happens when the slowest subscriber is a full
+ * ring behind the producer
+ *
+ * DROP_NEWEST:      back-pressure; publish() refuses the event and counts it
+ * OVERWRITE_OLDEST: the event is written anyway; lagging subscribers skip
+ *                   the overwritten events and count them as missed
+ */
+enum class FeedOverflowPolicy
+{
+  DROP_NEWEST,
+  OVERWRITE_OLDEST
+};
+
+/**
+ * OrderChangeFeed - Bounded single-producer / multi-consumer ring buffer
+ *
+ * Every subscriber sees every event from the moment it subscribed, through
+ * its own cursor, and nobody polls the order list. Publishing and polling
+ * are lock-free:
+ * - each slot carries a sequence number that is odd while the producer
+ *   writes it and 2 * (position + 1) once it is complete (seqlock)
+ * - a subscriber reads a slot, then re-checks the sequence; if the
+ *   producer overwrote the slot meanwhile the read is retried
+ *
+ * Only one thread may call publish() at a time. Each subscriber ID must
+ * be polled by one thread at a time.
+ */
+class OrderChangeFeed
+{
+public:
+  static const int MAX_SUBSCRIBERS = 8;
+  static const std::size_t DEFAULT_CAPACITY = 1024;
+
+private:
+  struct Slot
+  {
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<std::uint64_t> packedEvent; // handle | old | new | paid
+    std::atomic<std::int64_t> timestampNs;
+  };
+
+  // Subscriber slot states: free, being set up, active
+  static const int SUBSCRIBER_FREE = 0;
+  static const int SUBSCRIBER_CLAIMED = 1;
+  static const int SUBSCRIBER_ACTIVE = 2;
+
+  struct Subscriber
+  {
+    std::atomic<int> state;
+    std::atomic<std::uint64_t> cursor; // Next position to read
+    std::atomic<std::uint64_t> missed; // Events overwritten before they were read
+  };
+
+  Slot *slots;
+  std::size_t capacity; // Power of two
+  std::size_t mask;
+  FeedOverflowPolicy policy;
+
+  std::atomic<std::uint64_t> head; // Next position to write
+  std::atomic<std::uint64_t> publishedCount;
+  std::atomic<std::uint64_t> droppedCount;
+  Subscriber subscribers[MAX_SUBSCRIBERS];
+
+  std::uint64_t slowestCursor(std::uint64_t fallback) const;
+  static std::uint64_t pack(const OrderChangeEvent &event);
+  static OrderChangeEvent unpack(std::uint64_t packed, std::int64_t timestamp);
+
+public:
+  OrderChangeFeed(std::size_t requestedCapacity = DEFAULT_CAPACITY,
+                  FeedOverflowPolicy overflowPolicy = FeedOverflowPolicy::OVERWRITE_OLDEST);
+  ~OrderChangeFeed();
+
+  // Disable copy - slots are owned by the feed
+  OrderChangeFeed(const OrderChangeFeed &) = delete;
+  OrderChangeFeed &operator=(const OrderChangeFeed &) = delete;
+
+  // Producer side: returns false if the event was dropped (DROP_NEWEST)
+  bool publish(const OrderChangeEvent &event);
+
+  // Consumer side
+  int subscribe();
+  void unsubscribe(int subscriberID);
+  bool poll(int subscriberID, OrderChangeEvent &event);
+  // Moves the subscriber's cursor forward to position (see getHead), for
+  // a subscriber that rebuilt its state and must not see older events
+  void skipTo(int subscriberID, std::uint64_t position);
+
+  std::size_t getCapacity() const;
+  FeedOverflowPolicy getPolicy() const;
+  std::uint64_t getHead() const; // Position of the next event to be published
+  std::uint64_t getPublishedCount() const;
+  std::uint64_t getDroppedCount() const;
+  std::uint64_t getMissedCount(int subscriberID) const;
+  std::uint64_t getPendingCount(int subscriberID) const;
+
+  static std::int64_t now();
+};
+
+#endif // ORDER_CHANGE_FEED_H
@@ -0,0 +1,152 @@
+#include "implementations/AsyncConsoleDisplay.h"
+
+AsyncConsoleDisplay::AsyncConsoleDisplay(std::size_t queueCapacity, std::ostream &out)
+    : output(out), queue(queueCapacity), acceptedCount(0), droppedCount(0), writtenCount(0),
+      sleeping(false), wakeups(0), stopping(false)
+{
+  drainThread = std::thread(&AsyncConsoleDisplay::drainLoop, this);
+}
+
+AsyncConsoleDisplay::~AsyncConsoleDisplay()
+{
+  stopping.store(true);
+  wakeups.fetch_add(1);
+  wakeups.notify_one();
+  drainThread.join();
+
+  std::uint64_t dropped = droppedCount.load();
+  if (dropped > 0)
+  {
+    output << "[display] " << dropped << " message(s) dropped - output queue was full" << std::endl;
+  }
+}
+
+void AsyncConsoleDisplay::show(const std::string &message) const
+{
+  enqueue(std::string(message));
+}
+
+void AsyncConsoleDisplay::showLine(const std::string &message) const
+{
+  std::string line;
+  line.reserve(message.size() + 1);
+  line.append(message);
+  line.push_back('\n');
+  enqueue(std::move(line));
+}
+
+void AsyncConsoleDisplay::enqueue(std::string &&message) const
+{
+  if (!queue.tryPush(std::move(message)))
+  {
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  acceptedCount.fetch_add(1);
+
+  // Pairs with the fence in drainLoop: either the drain thread sees this
+  // message before parking, or we see that it is parked and wake it
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping.load(std::memory_order_relaxed))
+  {
+    wake();
+  }
+}
+
+void AsyncConsoleDisplay::wake() const
+{
+  if (sleeping.exchange(false))
+  {
+    wakeups.fetch_add(1);
+    wakeups.notify_one();
+  }
+}
+
+void AsyncConsoleDisplay::flush() const
+{
+  std::uint64_t target = acceptedCount.load();
+
+  wakeups.fetch_add(1);
+  wakeups.notify_one();
+
+  std::uint64_t written = writtenCount.load();
+  while (written < target)
+  {
+    writtenCount.wait(written);
+    written = writtenCount.load();
+  }
+}
+
+std::uint64_t AsyncConsoleDisplay::getDroppedCount() const
+{
+  return droppedCount.load(std::memory_order_relaxed);
+}
+
+void AsyncConsoleDisplay::writeOut(std::string &buffer)
+{
+  output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  output.flush();
+  buffer.clear();
+}
+
+/**
+ * DrainLoop - Background thread body
+ *
+ * Drains the queue into the write buffer, writes the buffer whenever it
+ * is full or the queue runs empty, and parks until the next message.
+ * After the destructor sets stopping, the remaining messages are drained
+ * and written before the thread exits.
+ */
+void AsyncConsoleDisplay::drainLoop()
+{
+  std::string buffer;
+  buffer.reserve(WRITE_BUFFER_SIZE);
+  std::string message;
+  std::uint64_t consumed = 0;
+
+  while (true)
+  {
+    while (queue.tryPop(message))
+    {
+      buffer.append(message);
+      consumed++;
+      if (buffer.size() >= WRITE_BUFFER_SIZE)
+      {
+        writeOut(buffer);
+      }
+    }
+
+    if (!buffer.empty())
+    {
+      writeOut(buffer);
+    }
+    writtenCount.store(consumed);
+    writtenCount.notify_all();
+
+    std::uint32_t observed = wakeups.load();
+    if (stopping.load())
+    {
+      // A push may still have been finishing; exit only once nothing is left
+      if (!queue.tryPop(message))
+      {
+        return;
+      }
+      buffer.append(message);
+      consumed++;
+      continue;
+    }
+
+    sleeping.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (queue.tryPop(message))
+    {
+      sleeping.store(false);
+      buffer.append(message);
+      consumed++;
+      continue;
+    }
+
+    wakeups.wait(observed);
+    sleeping.store(false);
+  }
+}
@@ -0,0 +1,67 @@
+#ifndef ASYNC_CONSOLE_DISPLAY_H
+#define ASYNC_CONSOLE_DISPLAY_H
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "interfaces/IDisplay.h"
+#include "concurrency/BoundedQueue.h"
+
+/**
+ * AsyncConsoleDisplay - Console output written by a background thread
+ *
+ * show() and showLine() copy the message into a lock-free queue and return.
+ * A drain thread appends queued messages to one large buffer and writes
+ * it out in a single call when it fills up or the queue runs empty, so the
+ * stream is flushed once per burst instead of once per line.
+ *
+ * - flush() blocks until everything shown so far has been written
+ * - the destructor drains the queue and flushes before returning
+ * - when the queue is full the message is dropped and counted
+ *   (see getDroppedCount); callers never block on output
+ */
+class AsyncConsoleDisplay : public IDisplay
+{
+public:
+  static const std::size_t DEFAULT_QUEUE_CAPACITY = 8192;
+  static const std::size_t WRITE_BUFFER_SIZE = 64 * 1024;
+
+private:
+  std::ostream &output;
+  mutable BoundedQueue<std::string> queue;
+
+  mutable std::atomic<std::uint64_t> acceptedCount;
+  mutable std::atomic<std::uint64_t> droppedCount;
+  std::atomic<std::uint64_t> writtenCount; // Messages handed to the stream
+
+  // Drain thread parking: it sleeps on wakeups while sleeping is set
+  mutable std::atomic<bool> sleeping;
+  mutable std::atomic<std::uint32_t> wakeups;
+  std::atomic<bool> stopping;
+
+  std::thread drainThread; // Started last, after everything above is ready
+
+  void enqueue(std::string &&message) const;
+  void wake() const;
+  void drainLoop();
+  void writeOut(std::string &buffer);
+
+public:
+  explicit AsyncConsoleDisplay(std::size_t queueCapacity = DEFAULT_QUEUE_CAPACITY,
+                               std::ostream &out = std::cout);
+  ~AsyncConsoleDisplay() override;
+
+  // Disable copy - the drain thread holds a pointer to the display
+  AsyncConsoleDisplay(const AsyncConsoleDisplay &) = delete;
+  AsyncConsoleDisplay &operator=(const AsyncConsoleDisplay &) = delete;
+
+  void show(const std::string &message) const override;
+  void showLine(const std::string &message) const override;
+
+  void flush() const;
+  std::uint64_t getDroppedCount() const;
+};
+
+#endif // ASYNC_CONSOLE_DISPLAY_H
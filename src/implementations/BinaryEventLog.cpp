@@ -0,0 +1,334 @@
+#include "implementations/BinaryEventLog.h"
+#include "implementations/EventLogFormat.h"
+#include "exceptions/PhotoStudioExceptions.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace EventLogFormat;
+
+// show()/showLine() are recorded as this event with the text as its argument
+static const char TEXT_FORMAT[] = "{}";
+
+static std::int64_t nowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+BinaryEventLog::BinaryEventLog(const std::string &path, std::size_t segmentBytes, unsigned keepSegments)
+    : basePath(path), segmentSize(segmentBytes), maxSegments(keepSegments),
+      mapped(nullptr), used(0), fileDescriptor(-1), segmentNumber(0),
+      recordCount(0), droppedCount(0)
+{
+  if (path.empty())
+  {
+    throw InvalidDataException(
+        "Event log path cannot be empty",
+        "Precondition violation: path.empty()");
+  }
+  if (segmentBytes < sizeof(SegmentHeader) + 64)
+  {
+    throw InvalidDataException(
+        "Event log segment size is too small",
+        "Precondition violation: segmentBytes = " + std::to_string(segmentBytes));
+  }
+  if (keepSegments == 0)
+  {
+    throw InvalidDataException(
+        "Event log must keep at least one segment",
+        "Precondition violation: keepSegments == 0");
+  }
+
+  // Continue numbering after segments left by an earlier run so that
+  // rotation eventually removes them
+  std::filesystem::path base(basePath);
+  std::filesystem::path directory = base.has_parent_path() ? base.parent_path() : std::filesystem::path(".");
+  std::string prefix = base.filename().string() + ".";
+  std::error_code error;
+  for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+  {
+    std::string name = entry.path().filename().string();
+    if (name.size() > prefix.size() && name.compare(0, prefix.size(), prefix) == 0)
+    {
+      unsigned long number = std::strtoul(name.c_str() + prefix.size(), nullptr, 10);
+      if (number > segmentNumber)
+      {
+        segmentNumber = static_cast<std::uint32_t>(number);
+      }
+    }
+  }
+
+  openSegment();
+}
+
+BinaryEventLog::~BinaryEventLog()
+{
+  std::lock_guard<std::mutex> lock(writeMutex);
+  closeSegment();
+}
+
+std::string BinaryEventLog::segmentPath(const std::string &base, std::uint32_t number)
+{
+  char suffix[16];
+  std::snprintf(suffix, sizeof(suffix), ".%06u", number);
+  return base + suffix;
+}
+
+// The segment number only advances once the new segment is mapped, so a
+// failed attempt is retried under the same number
+void BinaryEventLog::openSegment() const
+{
+  std::uint32_t number = segmentNumber + 1;
+  std::string path = segmentPath(basePath, number);
+
+  fileDescriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fileDescriptor < 0)
+  {
+    throw InvalidDataException(
+        "Could not open event log: " + path,
+        "open() failed: " + std::string(std::strerror(errno)));
+  }
+
+  if (::ftruncate(fileDescriptor, static_cast<off_t>(segmentSize)) != 0)
+  {
+    int error = errno;
+    ::close(fileDescriptor);
+    fileDescriptor = -1;
+    throw InvalidDataException(
+        "Could not size event log: " + path,
+        "ftruncate() failed: " + std::string(std::strerror(error)));
+  }
+
+  void *address = ::mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+  if (address == MAP_FAILED)
+  {
+    int error = errno;
+    ::close(fileDescriptor);
+    fileDescriptor = -1;
+    throw InvalidDataException(
+        "Could not map event log: " + path,
+        "mmap() failed: " + std::string(std::strerror(error)));
+  }
+  mapped = static_cast<unsigned char *>(address);
+  segmentNumber = number;
+
+  SegmentHeader header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.segmentNumber = segmentNumber;
+  header.createdNs = nowNs();
+  header.reserved = 0;
+  std::memcpy(mapped, &header, sizeof(header));
+  used = sizeof(header);
+
+  definedInSegment.assign(formats.size(), false);
+
+  if (segmentNumber > maxSegments)
+  {
+    std::remove(segmentPath(basePath, segmentNumber - maxSegments).c_str());
+  }
+}
+
+void BinaryEventLog::closeSegment() const
+{
+  if (!mapped)
+  {
+    return;
+  }
+
+  ::munmap(mapped, segmentSize);
+  mapped = nullptr;
+
+  // Drop the unused tail; the reader also stops at the first zero byte
+  if (::ftruncate(fileDescriptor, static_cast<off_t>(used)) != 0)
+  {
+    // Keeping the zero-filled tail is harmless
+  }
+  ::close(fileDescriptor);
+  fileDescriptor = -1;
+}
+
+std::uint32_t BinaryEventLog::eventIDFor(const char *format) const
+{
+  auto it = eventIDs.find(format);
+  if (it != eventIDs.end())
+  {
+    return it->second;
+  }
+
+  std::uint32_t id = static_cast<std::uint32_t>(formats.size());
+  eventIDs.emplace(format, id);
+  formats.push_back(format);
+  definedInSegment.push_back(false);
+  return id;
+}
+
+/**
+ * Reserve - Make room for a record of the given size
+ *
+ * Starts a new segment when the current one cannot take the record.
+ * Returns false if the record would not fit even into an empty segment,
+ * or if the new segment could not be opened. In that case the log stays
+ * full, so every later record retries the open until one succeeds.
+ */
+bool BinaryEventLog::reserve(std::size_t bytes) const
+{
+  if (mapped && used + bytes <= segmentSize)
+  {
+    return true;
+  }
+  if (sizeof(SegmentHeader) + bytes > segmentSize)
+  {
+    return false;
+  }
+
+  closeSegment();
+  try
+  {
+    openSegment();
+  }
+  catch (const std::exception &)
+  {
+    used = segmentSize;
+    return false;
+  }
+  return true;
+}
+
+void BinaryEventLog::writeEvent(LogLevel level, std::uint32_t eventID, const LogArg *args, std::size_t count) const
+{
+  std::size_t eventBytes = EVENT_HEADER_SIZE;
+  for (std::size_t i = 0; i < count; i++)
+  {
+    switch (args[i].getKind())
+    {
+    case LogArg::Kind::BOOLEAN:
+      eventBytes += 2;
+      break;
+    case LogArg::Kind::TEXT:
+      eventBytes += 5 + args[i].getText().size();
+      break;
+    default:
+      eventBytes += 9;
+      break;
+    }
+  }
+
+  const char *format = formats[eventID];
+  std::size_t formatLength = std::strlen(format);
+  if (formatLength > 0xFFFF)
+  {
+    formatLength = 0xFFFF;
+  }
+  std::size_t defineBytes = DEFINE_HEADER_SIZE + formatLength;
+
+  // Rotating clears definedInSegment, so the second check covers that case
+  if (!reserve(eventBytes + (definedInSegment[eventID] ? 0 : defineBytes)))
+  {
+    droppedCount++;
+    return;
+  }
+  if (!definedInSegment[eventID] && !reserve(eventBytes + defineBytes))
+  {
+    droppedCount++;
+    return;
+  }
+
+  unsigned char *out = mapped + used;
+
+  if (!definedInSegment[eventID])
+  {
+    store<std::uint8_t>(out, RECORD_DEFINE);
+    store<std::uint8_t>(out, 0);
+    store<std::uint16_t>(out, static_cast<std::uint16_t>(formatLength));
+    store<std::uint32_t>(out, eventID);
+    std::memcpy(out, format, formatLength);
+    out += formatLength;
+    definedInSegment[eventID] = true;
+  }
+
+  store<std::uint8_t>(out, RECORD_EVENT);
+  store<std::uint8_t>(out, static_cast<std::uint8_t>(level));
+  store<std::uint16_t>(out, static_cast<std::uint16_t>(count));
+  store<std::uint32_t>(out, eventID);
+  store<std::int64_t>(out, nowNs());
+
+  for (std::size_t i = 0; i < count; i++)
+  {
+    const LogArg &arg = args[i];
+    store<std::uint8_t>(out, static_cast<std::uint8_t>(arg.getKind()));
+    switch (arg.getKind())
+    {
+    case LogArg::Kind::INTEGER:
+      store<long long>(out, arg.getInteger());
+      break;
+    case LogArg::Kind::UNSIGNED:
+      store<unsigned long long>(out, arg.getUnsigned());
+      break;
+    case LogArg::Kind::REAL:
+      store<double>(out, arg.getReal());
+      break;
+    case LogArg::Kind::BOOLEAN:
+      store<std::uint8_t>(out, arg.getBoolean() ? 1 : 0);
+      break;
+    case LogArg::Kind::TEXT:
+      store<std::uint32_t>(out, static_cast<std::uint32_t>(arg.getText().size()));
+      std::memcpy(out, arg.getText().data(), arg.getText().size());
+      out += arg.getText().size();
+      break;
+    }
+  }
+
+  used = static_cast<std::size_t>(out - mapped);
+  recordCount++;
+}
+
+void BinaryEventLog::logEvent(LogLevel level, const char *format, const LogArg *args, std::size_t count) const
+{
+  std::lock_guard<std::mutex> lock(writeMutex);
+  std::uint32_t eventID = eventIDFor(format);
+  if (eventID >= MAX_FORMATS)
+  {
+    droppedCount++; // Readers would reject the definition
+    return;
+  }
+  writeEvent(level, eventID, args, count);
+}
+
+void BinaryEventLog::show(const std::string &message) const
+{
+  LogArg arg(message);
+  logEvent(LogLevel::INFO, TEXT_FORMAT, &arg, 1);
+}
+
+void BinaryEventLog::showLine(const std::string &message) const
+{
+  LogArg arg(message);
+  logEvent(LogLevel::INFO, TEXT_FORMAT, &arg, 1);
+}
+
+std::uint32_t BinaryEventLog::getSegmentNumber() const
+{
+  std::lock_guard<std::mutex> lock(writeMutex);
+  return segmentNumber;
+}
+
+std::uint64_t BinaryEventLog::getRecordCount() const
+{
+  std::lock_guard<std::mutex> lock(writeMutex);
+  return recordCount;
+}
+
+std::uint64_t BinaryEventLog::getDroppedCount() const
+{
+  std::lock_guard<std::mutex> lock(writeMutex);
+  return droppedCount;
+}
@@ -0,0 +1,79 @@
+#ifndef BINARY_EVENT_LOG_H
+#define BINARY_EVENT_LOG_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "interfaces/IDisplay.h"
+
+/**
+ * BinaryEventLog - IDisplay that records structured events instead of text
+ *
+ * Every log() call becomes one binary record: the event ID of its format
+ * string, the level, a timestamp and the raw arguments. Nothing is
+ * formatted at logging time; a record is a handful of stores into a
+ * memory-mapped segment file. show()/showLine() are recorded as events
+ * with a single text argument.
+ *
+ * Segments have a fixed size. When one is full the next is started and
+ * only the newest maxSegments files are kept. If the next segment cannot
+ * be opened, events are counted as dropped until an open succeeds, so
+ * logging never throws. Use EventLogReader (or the eventlog_decode tool)
+ * to turn segments back into text or JSON. See EventLogFormat.h for the
+ * layout.
+ */
+class BinaryEventLog : public IDisplay
+{
+public:
+  static const std::size_t DEFAULT_SEGMENT_SIZE = 4 * 1024 * 1024;
+  static const unsigned DEFAULT_MAX_SEGMENTS = 4;
+
+private:
+  std::string basePath;
+  std::size_t segmentSize;
+  unsigned maxSegments;
+
+  mutable std::mutex writeMutex;
+  mutable unsigned char *mapped; // Current segment, segmentSize bytes
+  mutable std::size_t used;
+  mutable int fileDescriptor;
+  mutable std::uint32_t segmentNumber;
+
+  // Event IDs by format string address; format strings are literals
+  mutable std::unordered_map<const char *, std::uint32_t> eventIDs;
+  mutable std::vector<const char *> formats; // Indexed by event ID
+  mutable std::vector<bool> definedInSegment;
+  mutable std::uint64_t recordCount;
+  mutable std::uint64_t droppedCount;
+
+  std::uint32_t eventIDFor(const char *format) const;
+  bool reserve(std::size_t bytes) const;
+  void openSegment() const;
+  void closeSegment() const;
+  void writeEvent(LogLevel level, std::uint32_t eventID, const LogArg *args, std::size_t count) const;
+
+public:
+  explicit BinaryEventLog(const std::string &path,
+                          std::size_t segmentBytes = DEFAULT_SEGMENT_SIZE,
+                          unsigned keepSegments = DEFAULT_MAX_SEGMENTS);
+  ~BinaryEventLog() override;
+
+  // Disable copy - owns the mapped segment
+  BinaryEventLog(const BinaryEventLog &) = delete;
+  BinaryEventLog &operator=(const BinaryEventLog &) = delete;
+
+  void show(const std::string &message) const override;
+  void showLine(const std::string &message) const override;
+  void logEvent(LogLevel level, const char *format, const LogArg *args, std::size_t count) const override;
+
+  std::uint32_t getSegmentNumber() const;
+  std::uint64_t getRecordCount() const;
+  // Events larger than a whole segment or logged while no segment could be opened
+  std::uint64_t getDroppedCount() const;
+
+  static std::string segmentPath(const std::string &base, std::uint32_t number);
+};
+
+#endif // BINARY_EVENT_LOG_H
@@ -0,0 +1,101 @@
+#include "implementations/CsvReportWriter.h"
+#include "implementations/ReportFieldFormat.h"
+#include "exceptions/PhotoStudioExceptions.h"
+
+CsvReportWriter::CsvReportWriter(BufferedFileSink &output)
+    : sink(output), columnCount(0), reportCount(0), rowCount(0)
+{
+}
+
+void CsvReportWriter::writeText(std::string_view text)
+{
+  if (text.find_first_of(",\"\r\n") == std::string_view::npos)
+  {
+    sink.write(text);
+    return;
+  }
+
+  sink.put('"');
+  std::size_t start = 0;
+  std::size_t quote;
+  while ((quote = text.find('"', start)) != std::string_view::npos)
+  {
+    sink.write(text.substr(start, quote + 1 - start));
+    sink.put('"');
+    start = quote + 1;
+  }
+  sink.write(text.substr(start));
+  sink.put('"');
+}
+
+void CsvReportWriter::beginReport(const std::string &reportID, const std::vector<std::string> &columns)
+{
+  if (columns.empty())
+  {
+    throw InvalidDataException(
+        "Report " + reportID + " has no columns",
+        "Precondition violation: columns.empty()");
+  }
+
+  if (reportCount > 0)
+  {
+    sink.put('\n');
+  }
+  columnCount = columns.size();
+  for (std::size_t i = 0; i < columns.size(); i++)
+  {
+    if (i > 0)
+    {
+      sink.put(',');
+    }
+    writeText(columns[i]);
+  }
+  sink.put('\n');
+}
+
+void CsvReportWriter::writeFields(const LogArg *fields, std::size_t count)
+{
+  if (count != columnCount)
+  {
+    throw InvalidDataException(
+        "Report row does not match its columns",
+        "Precondition violation: count = " + std::to_string(count) + ", columns = " + std::to_string(columnCount));
+  }
+
+  for (std::size_t i = 0; i < count; i++)
+  {
+    if (i > 0)
+    {
+      sink.put(',');
+    }
+    if (fields[i].getKind() == LogArg::Kind::TEXT)
+    {
+      if (count == 1 && fields[i].getText().empty())
+      {
+        sink.write("\"\""); // Not an empty line, which separates reports
+      }
+      else
+      {
+        writeText(fields[i].getText());
+      }
+    }
+    else
+    {
+      writeReportNumber(sink, fields[i]);
+    }
+  }
+  sink.put('\n');
+  rowCount++;
+}
+
+void CsvReportWriter::endReport()
+{
+  columnCount = 0;
+  reportCount++;
+  sink.flush();
+}
+
+std::uint64_t CsvReportWriter::getRowCount() const
+{
+  return rowCount;
+}
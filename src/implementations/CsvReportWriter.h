@@ -0,0 +1,36 @@
+#ifndef CSV_REPORT_WRITER_H
+#define CSV_REPORT_WRITER_H
+
+#include "interfaces/IReportWriter.h"
+#include "repository/BufferedFileSink.h"
+
+/**
+ * CsvReportWriter - Writes reports as CSV (RFC 4180) into a file sink
+ *
+ * Each report is a header row with the column names followed by its
+ * rows; consecutive reports in one file are separated by an empty line.
+ * Text fields containing a comma, quote or line break are quoted, with
+ * quotes doubled. Rows go straight into the sink, so nothing grows with
+ * the size of the report.
+ */
+class CsvReportWriter : public IReportWriter
+{
+private:
+  BufferedFileSink &sink;
+  std::size_t columnCount;
+  std::size_t reportCount;
+  std::uint64_t rowCount;
+
+  void writeText(std::string_view text);
+
+public:
+  explicit CsvReportWriter(BufferedFileSink &output);
+
+  void beginReport(const std::string &reportID, const std::vector<std::string> &columns) override;
+  void writeFields(const LogArg *fields, std::size_t count) override;
+  void endReport() override;
+
+  std::uint64_t getRowCount() const;
+};
+
+#endif // CSV_REPORT_WRITER_H
@@ -0,0 +1,63 @@
+#ifndef EVENT_LOG_FORMAT_H
+#define EVENT_LOG_FORMAT_H
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * EventLogFormat - On-disk layout shared by BinaryEventLog and EventLogReader
+ *
+ * A log is a series of segment files "<base>.000001", "<base>.000002", ...
+ * Each segment starts with a SegmentHeader followed by records; all values
+ * are in host byte order. A zero type byte marks the end of the data.
+ *
+ * DEFINE record: type(1) level(1) formatLength(2) eventID(4) format bytes
+ *   Maps an event ID to its format string. Repeated in every segment that
+ *   uses the event, so each segment can be decoded on its own.
+ *
+ * EVENT record: type(1) level(1) argCount(2) eventID(4) timestampNs(8) args
+ *   Each arg is kind(1) followed by 8 bytes for numbers, 1 byte for a
+ *   boolean, or length(4) plus bytes for text.
+ */
+namespace EventLogFormat
+{
+  const char MAGIC[8] = {'P', 'S', 'E', 'V', 'L', 'O', 'G', '1'};
+  const std::uint32_t VERSION = 1;
+
+  const std::uint8_t RECORD_END = 0;
+  const std::uint8_t RECORD_DEFINE = 1;
+  const std::uint8_t RECORD_EVENT = 2;
+
+  struct SegmentHeader
+  {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t segmentNumber;
+    std::int64_t createdNs;
+    std::uint64_t reserved;
+  };
+
+  // Event IDs are dense from 0; the reader rejects larger ones as corrupt
+  const std::uint32_t MAX_FORMATS = 65536;
+
+  const std::size_t DEFINE_HEADER_SIZE = 8;
+  const std::size_t EVENT_HEADER_SIZE = 16;
+
+  template <typename T>
+  inline void store(unsigned char *&out, T value)
+  {
+    std::memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+  }
+
+  template <typename T>
+  inline T load(const unsigned char *&in)
+  {
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+    return value;
+  }
+}
+
+#endif // EVENT_LOG_FORMAT_H
@@ -0,0 +1,249 @@
+#include "implementations/EventLogReader.h"
+#include "implementations/EventLogFormat.h"
+#include "exceptions/PhotoStudioExceptions.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace EventLogFormat;
+
+EventLogReader::EventLogReader(const std::string &segmentPath)
+    : position(0), segmentNumber(0)
+{
+  std::ifstream file(segmentPath, std::ios::binary);
+  if (!file.is_open())
+  {
+    throw DataNotFoundException(
+        "Event log segment not found: " + segmentPath,
+        "Could not open file for reading");
+  }
+  data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+  SegmentHeader header;
+  if (data.size() < sizeof(header))
+  {
+    throw InvalidDataException(
+        "Not an event log segment: " + segmentPath,
+        "File shorter than the segment header");
+  }
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION)
+  {
+    throw InvalidDataException(
+        "Not an event log segment: " + segmentPath,
+        "Bad magic or unsupported version");
+  }
+  segmentNumber = header.segmentNumber;
+  position = sizeof(header);
+}
+
+std::uint32_t EventLogReader::getSegmentNumber() const
+{
+  return segmentNumber;
+}
+
+bool EventLogReader::next(DecodedEvent &event)
+{
+  const std::string truncated = "Event log segment " + std::to_string(segmentNumber) + " is truncated";
+
+  while (position < data.size())
+  {
+    const unsigned char *in = data.data() + position;
+    std::size_t remaining = data.size() - position;
+    std::uint8_t type = in[0];
+
+    if (type == RECORD_END)
+    {
+      return false;
+    }
+
+    if (type == RECORD_DEFINE)
+    {
+      if (remaining < DEFINE_HEADER_SIZE)
+      {
+        throw InvalidDataException(truncated, "Incomplete definition header");
+      }
+      in += 2;
+      std::uint16_t length = load<std::uint16_t>(in);
+      std::uint32_t id = load<std::uint32_t>(in);
+      if (remaining < DEFINE_HEADER_SIZE + length)
+      {
+        throw InvalidDataException(truncated, "Incomplete format string");
+      }
+      if (id >= MAX_FORMATS)
+      {
+        throw InvalidDataException(
+            "Event log segment " + std::to_string(segmentNumber) + " is corrupt",
+            "Event ID " + std::to_string(id) + " exceeds " + std::to_string(MAX_FORMATS));
+      }
+      if (formats.size() <= id)
+      {
+        formats.resize(id + 1);
+      }
+      formats[id].assign(reinterpret_cast<const char *>(in), length);
+      position += DEFINE_HEADER_SIZE + length;
+      continue;
+    }
+
+    if (type != RECORD_EVENT || remaining < EVENT_HEADER_SIZE)
+    {
+      throw InvalidDataException(truncated, "Unknown record type " + std::to_string(type));
+    }
+
+    const unsigned char *end = data.data() + data.size();
+    in += 1;
+    event.level = static_cast<LogLevel>(load<std::uint8_t>(in));
+    std::uint16_t count = load<std::uint16_t>(in);
+    event.eventID = load<std::uint32_t>(in);
+    event.timestampNs = load<std::int64_t>(in);
+    event.format = event.eventID < formats.size() ? formats[event.eventID] : "";
+    event.args.clear();
+
+    for (std::uint16_t i = 0; i < count; i++)
+    {
+      if (in >= end)
+      {
+        throw InvalidDataException(truncated, "Incomplete argument list");
+      }
+      LogArg::Kind kind = static_cast<LogArg::Kind>(load<std::uint8_t>(in));
+      std::size_t need = kind == LogArg::Kind::BOOLEAN ? 1 : (kind == LogArg::Kind::TEXT ? 4 : 8);
+      if (static_cast<std::size_t>(end - in) < need)
+      {
+        throw InvalidDataException(truncated, "Incomplete argument");
+      }
+
+      switch (kind)
+      {
+      case LogArg::Kind::INTEGER:
+        event.args.push_back(LogArg(load<long long>(in)));
+        break;
+      case LogArg::Kind::UNSIGNED:
+        event.args.push_back(LogArg(load<unsigned long long>(in)));
+        break;
+      case LogArg::Kind::REAL:
+        event.args.push_back(LogArg(load<double>(in)));
+        break;
+      case LogArg::Kind::BOOLEAN:
+        event.args.push_back(LogArg(load<std::uint8_t>(in) != 0));
+        break;
+      case LogArg::Kind::TEXT:
+      {
+        std::uint32_t length = load<std::uint32_t>(in);
+        if (static_cast<std::size_t>(end - in) < length)
+        {
+          throw InvalidDataException(truncated, "Incomplete text argument");
+        }
+        event.args.push_back(LogArg(std::string_view(reinterpret_cast<const char *>(in), length)));
+        in += length;
+        break;
+      }
+      default:
+        throw InvalidDataException(truncated, "Unknown argument kind");
+      }
+    }
+
+    position = static_cast<std::size_t>(in - data.data());
+    return true;
+  }
+  return false;
+}
+
+const char *EventLogReader::levelName(LogLevel level)
+{
+  switch (level)
+  {
+  case LogLevel::DEBUG:
+    return "DEBUG";
+  case LogLevel::INFO:
+    return "INFO";
+  case LogLevel::WARNING:
+    return "WARNING";
+  case LogLevel::ERROR:
+    return "ERROR";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+std::string DecodedEvent::toText() const
+{
+  return formatLogMessage(format.c_str(), args.data(), args.size());
+}
+
+static void appendJsonString(std::string &out, std::string_view text)
+{
+  out += '"';
+  for (char c : text)
+  {
+    switch (c)
+    {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+      {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        out += escaped;
+      }
+      else
+      {
+        out += c;
+      }
+    }
+  }
+  out += '"';
+}
+
+std::string DecodedEvent::toJson() const
+{
+  std::string out = "{\"ts\":" + std::to_string(timestampNs) +
+                    ",\"level\":\"" + EventLogReader::levelName(level) +
+                    "\",\"event\":" + std::to_string(eventID) + ",\"format\":";
+  appendJsonString(out, format);
+  out += ",\"args\":[";
+  for (std::size_t i = 0; i < args.size(); i++)
+  {
+    if (i > 0)
+    {
+      out += ',';
+    }
+    const LogArg &arg = args[i];
+    switch (arg.getKind())
+    {
+    case LogArg::Kind::INTEGER:
+      out += std::to_string(arg.getInteger());
+      break;
+    case LogArg::Kind::UNSIGNED:
+      out += std::to_string(arg.getUnsigned());
+      break;
+    case LogArg::Kind::REAL:
+    {
+      char number[32];
+      std::snprintf(number, sizeof(number), "%.17g", arg.getReal());
+      out += number;
+      break;
+    }
+    case LogArg::Kind::BOOLEAN:
+      out += arg.getBoolean() ? "true" : "false";
+      break;
+    case LogArg::Kind::TEXT:
+      appendJsonString(out, arg.getText());
+      break;
+    }
+  }
+  out += "],\"message\":";
+  appendJsonString(out, toText());
+  out += '}';
+  return out;
+}
@@ -0,0 +1,53 @@
+#ifndef EVENT_LOG_READER_H
+#define EVENT_LOG_READER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "types/Types.h"
+#include "types/LogArg.h"
+
+/**
+ * DecodedEvent - One event read back from a BinaryEventLog segment
+ *
+ * Text arguments point into the reader's buffer and stay valid while the
+ * EventLogReader that produced the event is alive.
+ */
+struct DecodedEvent
+{
+  std::uint32_t eventID;
+  LogLevel level;
+  std::int64_t timestampNs;
+  std::string format;
+  std::vector<LogArg> args;
+
+  DecodedEvent() : eventID(0), level(LogLevel::INFO), timestampNs(0) {}
+
+  std::string toText() const;
+  std::string toJson() const;
+};
+
+/**
+ * EventLogReader - Sequential decoder for one BinaryEventLog segment
+ *
+ * Loads the segment file, checks its header and hands out events in the
+ * order they were written. Definition records are consumed internally.
+ */
+class EventLogReader
+{
+private:
+  std::vector<unsigned char> data;
+  std::size_t position;
+  std::uint32_t segmentNumber;
+  std::vector<std::string> formats; // Indexed by event ID
+
+public:
+  explicit EventLogReader(const std::string &segmentPath);
+
+  bool next(DecodedEvent &event); // false at the end of the segment
+  std::uint32_t getSegmentNumber() const;
+
+  static const char *levelName(LogLevel level);
+};
+
+#endif // EVENT_LOG_READER_H
@@ -0,0 +1,131 @@
+#include "implementations/JsonLinesReportWriter.h"
+#include "implementations/ReportFieldFormat.h"
+#include "exceptions/PhotoStudioExceptions.h"
+#include <cmath>
+
+JsonLinesReportWriter::JsonLinesReportWriter(BufferedFileSink &output)
+    : sink(output), rowCount(0)
+{
+}
+
+/**
+ * WriteText - Write text as a JSON string
+ *
+ * Runs of characters that need no escaping are written in one piece.
+ */
+void JsonLinesReportWriter::writeText(std::string_view text)
+{
+  static const char HEX[] = "0123456789abcdef";
+
+  sink.put('"');
+  std::size_t start = 0;
+  for (std::size_t i = 0; i < text.size(); i++)
+  {
+    unsigned char character = static_cast<unsigned char>(text[i]);
+    if (character >= 0x20 && character != '"' && character != '\\')
+    {
+      continue;
+    }
+
+    sink.write(text.substr(start, i - start));
+    start = i + 1;
+    switch (character)
+    {
+    case '"':
+      sink.write("\\\"");
+      break;
+    case '\\':
+      sink.write("\\\\");
+      break;
+    case '\n':
+      sink.write("\\n");
+      break;
+    case '\r':
+      sink.write("\\r");
+      break;
+    case '\t':
+      sink.write("\\t");
+      break;
+    default:
+      char escape[] = {'\\', 'u', '0', '0', HEX[character >> 4], HEX[character & 0x0F]};
+      sink.write(escape, sizeof(escape));
+      break;
+    }
+  }
+  sink.write(text.substr(start));
+  sink.put('"');
+}
+
+std::string JsonLinesReportWriter::quoted(const std::string &text)
+{
+  std::string result = "\"";
+  for (char character : text)
+  {
+    if (character == '"' || character == '\\')
+    {
+      result += '\\';
+    }
+    result += character;
+  }
+  return result + "\"";
+}
+
+void JsonLinesReportWriter::beginReport(const std::string &reportID, const std::vector<std::string> &columns)
+{
+  if (columns.empty())
+  {
+    throw InvalidDataException(
+        "Report " + reportID + " has no columns",
+        "Precondition violation: columns.empty()");
+  }
+
+  // Keys are escaped once per report, not once per row
+  rowPrefix = "{\"report\":" + quoted(reportID);
+  keys.clear();
+  for (const std::string &column : columns)
+  {
+    keys.push_back("," + quoted(column) + ":");
+  }
+}
+
+void JsonLinesReportWriter::writeFields(const LogArg *fields, std::size_t count)
+{
+  if (count != keys.size())
+  {
+    throw InvalidDataException(
+        "Report row does not match its columns",
+        "Precondition violation: count = " + std::to_string(count) + ", columns = " + std::to_string(keys.size()));
+  }
+
+  sink.write(rowPrefix);
+  for (std::size_t i = 0; i < count; i++)
+  {
+    sink.write(keys[i]);
+    const LogArg &field = fields[i];
+    if (field.getKind() == LogArg::Kind::TEXT)
+    {
+      writeText(field.getText());
+    }
+    else if (field.getKind() == LogArg::Kind::REAL && !std::isfinite(field.getReal()))
+    {
+      sink.write("null");
+    }
+    else
+    {
+      writeReportNumber(sink, field);
+    }
+  }
+  sink.write("}\n");
+  rowCount++;
+}
+
+void JsonLinesReportWriter::endReport()
+{
+  keys.clear();
+  sink.flush();
+}
+
+std::uint64_t JsonLinesReportWriter::getRowCount() const
+{
+  return rowCount;
+}
@@ -0,0 +1,38 @@
+#ifndef JSON_LINES_REPORT_WRITER_H
+#define JSON_LINES_REPORT_WRITER_H
+
+#include <string>
+#include <vector>
+#include "interfaces/IReportWriter.h"
+#include "repository/BufferedFileSink.h"
+
+/**
+ * JsonLinesReportWriter - Writes reports as JSON Lines into a file sink
+ *
+ * Every row is one JSON object on its own line: {"report":"<id>", then
+ * one member per column}. Numbers and booleans are written bare (reals
+ * that are not finite as null) and text is escaped, so each line parses
+ * on its own. Rows go straight into the sink.
+ */
+class JsonLinesReportWriter : public IReportWriter
+{
+private:
+  BufferedFileSink &sink;
+  std::string rowPrefix;           // {"report":"<id>",
+  std::vector<std::string> keys;   // "<column>": per column
+  std::uint64_t rowCount;
+
+  void writeText(std::string_view text);
+  static std::string quoted(const std::string &text);
+
+public:
+  explicit JsonLinesReportWriter(BufferedFileSink &output);
+
+  void beginReport(const std::string &reportID, const std::vector<std::string> &columns) override;
+  void writeFields(const LogArg *fields, std::size_t count) override;
+  void endReport() override;
+
+  std::uint64_t getRowCount() const;
+};
+
+#endif // JSON_LINES_REPORT_WRITER_H
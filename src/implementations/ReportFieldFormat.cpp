@@ -0,0 +1,27 @@
+#include "implementations/ReportFieldFormat.h"
+#include <charconv>
+
+void writeReportNumber(BufferedFileSink &sink, const LogArg &field)
+{
+  char text[32];
+  std::to_chars_result result{text, std::errc()};
+  switch (field.getKind())
+  {
+  case LogArg::Kind::INTEGER:
+    result = std::to_chars(text, text + sizeof(text), field.getInteger());
+    break;
+  case LogArg::Kind::UNSIGNED:
+    result = std::to_chars(text, text + sizeof(text), field.getUnsigned());
+    break;
+  case LogArg::Kind::REAL:
+    result = std::to_chars(text, text + sizeof(text), field.getReal());
+    break;
+  case LogArg::Kind::BOOLEAN:
+    sink.write(field.getBoolean() ? "true" : "false");
+    return;
+  case LogArg::Kind::TEXT:
+    sink.write(field.getText());
+    return;
+  }
+  sink.write(text, static_cast<std::size_t>(result.ptr - text));
+}
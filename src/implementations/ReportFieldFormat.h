@@ -0,0 +1,15 @@
+#ifndef REPORT_FIELD_FORMAT_H
+#define REPORT_FIELD_FORMAT_H
+
+#include "repository/BufferedFileSink.h"
+#include "types/LogArg.h"
+
+/**
+ * WriteReportNumber - Write a non-text field in its plain form
+ *
+ * Integers print in decimal, reals in the shortest form that reads back
+ * to the same value, booleans as true/false; nothing is allocated.
+ */
+void writeReportNumber(BufferedFileSink &sink, const LogArg &field);
+
+#endif // REPORT_FIELD_FORMAT_H
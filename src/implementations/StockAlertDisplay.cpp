@@ -0,0 +1,27 @@
+#include "implementations/StockAlertDisplay.h"
+#include "entities/Consumable.h"
+
+StockAlertDisplay::StockAlertDisplay(const IDisplay *disp)
+    : display(disp)
+{
+}
+
+void StockAlertDisplay::onStockAlert(const StockAlert &alert)
+{
+  if (!display)
+  {
+    return;
+  }
+
+  const Consumable *consumable = alert.consumable;
+  if (alert.type == StockAlertType::LOW_STOCK)
+  {
+    display->log(LogLevel::WARNING, "LOW STOCK: {} at {} {} (reorder level {})",
+                 consumable->getName(), alert.stock, consumable->getUnitOfMeasure(), alert.reorderLevel);
+  }
+  else
+  {
+    display->log(LogLevel::INFO, "Stock recovered: {} at {} {}",
+                 consumable->getName(), alert.stock, consumable->getUnitOfMeasure());
+  }
+}
@@ -0,0 +1,23 @@
+#ifndef STOCK_ALERT_DISPLAY_H
+#define STOCK_ALERT_DISPLAY_H
+
+#include "interfaces/IStockAlertListener.h"
+#include "interfaces/IDisplay.h"
+
+/**
+ * StockAlertDisplay - Reports reorder-level crossings on a display
+ *
+ * LOW_STOCK is logged as a warning, RECOVERED as information.
+ */
+class StockAlertDisplay : public IStockAlertListener
+{
+private:
+  const IDisplay *display;
+
+public:
+  explicit StockAlertDisplay(const IDisplay *disp);
+
+  void onStockAlert(const StockAlert &alert) override;
+};
+
+#endif // STOCK_ALERT_DISPLAY_H
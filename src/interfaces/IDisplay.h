@@ -1,14 +1,52 @@
 #ifndef IDISPLAY_H
 #define IDISPLAY_H
 
+#include <atomic>
+#include <cstddef>
 #include <string>
+#include "types/Types.h"
+#include "types/LogArg.h"
 
+/**
+ * IDisplay - Output sink used by managers, orders and employees
+ *
+ * show()/showLine() print ready-made text. log() takes a severity, a
+ * format string and arguments and only builds the text when the level is
+ * enabled: a disabled level costs one comparison, with no allocation.
+ * Enabled messages reach logEvent(), which by default formats them and
+ * calls showLine(); sinks that store events instead of text override it.
+ */
 class IDisplay
 {
+private:
+  std::atomic<LogLevel> minLevel;
+
 public:
+  IDisplay() : minLevel(LogLevel::INFO) {}
   virtual ~IDisplay() = default;
   virtual void show(const std::string &message) const = 0;
   virtual void showLine(const std::string &message) const = 0;
+
+  void setLevel(LogLevel level) { minLevel.store(level, std::memory_order_relaxed); }
+  LogLevel getLevel() const { return minLevel.load(std::memory_order_relaxed); }
+  bool isEnabled(LogLevel level) const { return level >= minLevel.load(std::memory_order_relaxed); }
+
+  template <typename... Args>
+  void log(LogLevel level, const char *format, const Args &...args) const
+  {
+    if (!isEnabled(level))
+    {
+      return;
+    }
+    // One spare slot so that a message without arguments still has an array
+    const LogArg packed[sizeof...(Args) + 1] = {LogArg(args)..., LogArg(0)};
+    logEvent(level, format, packed, sizeof...(Args));
+  }
+
+  virtual void logEvent(LogLevel level, const char *format, const LogArg *args, std::size_t count) const
+  {
+    showLine(formatLogMessage(format, args, count));
+  }
 };
 
 #endif // IDISPLAY_H
@@ -0,0 +1,32 @@
+#ifndef IREPORT_WRITER_H
+#define IREPORT_WRITER_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include "types/LogArg.h"
+
+/**
+ * IReportWriter - Receives report rows as they are produced
+ *
+ * A report is beginReport with its column names, any number of rows with
+ * one field per column, then endReport. Fields are LogArgs, so numbers
+ * and text are passed without building strings; text fields only need to
+ * stay valid for the duration of the writeFields call.
+ */
+class IReportWriter
+{
+public:
+  virtual ~IReportWriter() = default;
+  virtual void beginReport(const std::string &reportID, const std::vector<std::string> &columns) = 0;
+  virtual void writeFields(const LogArg *fields, std::size_t count) = 0;
+  virtual void endReport() = 0;
+
+  void writeRow(std::initializer_list<LogArg> fields)
+  {
+    writeFields(fields.begin(), fields.size());
+  }
+};
+
+#endif // IREPORT_WRITER_H
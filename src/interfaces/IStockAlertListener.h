@@ -0,0 +1,36 @@
+#ifndef ISTOCK_ALERT_LISTENER_H
+#define ISTOCK_ALERT_LISTENER_H
+
+class Consumable;
+
+enum class StockAlertType
+{
+  LOW_STOCK, // Stock fell to or below the reorder level
+  RECOVERED  // Stock rose back to the reorder level plus the hysteresis
+};
+
+/**
+ * StockAlert - One reorder-level crossing of a consumable
+ */
+struct StockAlert
+{
+  const Consumable *consumable;
+  StockAlertType type;
+  int stock;        // Stock on hand right after the change
+  int reorderLevel;
+};
+
+/**
+ * IStockAlertListener - Receives reorder-level crossings
+ *
+ * Called on the thread that changed the stock, after the change; keep
+ * handlers short and do not change the same consumable's stock from one.
+ */
+class IStockAlertListener
+{
+public:
+  virtual ~IStockAlertListener() = default;
+  virtual void onStockAlert(const StockAlert &alert) = 0;
+};
+
+#endif // ISTOCK_ALERT_LISTENER_H
@@ -0,0 +1,25 @@
+#ifndef IUSAGE_LISTENER_H
+#define IUSAGE_LISTENER_H
+
+#include <vector>
+#include "entities/ConsumableUsage.h"
+#include "repository/UsageStore.h"
+
+/**
+ * IUsageListener - Receives consumable usage as ConsumableManager stores it
+ *
+ * onUsageSnapshot is called once when the listener is added, with the
+ * totals recorded so far; every later usage arrives through
+ * onUsageRecorded. Both are called under the manager's usage lock, so a
+ * listener sees each usage exactly once, but must not call back into the
+ * manager.
+ */
+class IUsageListener
+{
+public:
+  virtual ~IUsageListener() = default;
+  virtual void onUsageSnapshot(const std::vector<UsageTotal> &totals) = 0;
+  virtual void onUsageRecorded(const ConsumableUsage &usage) = 0;
+};
+
+#endif // IUSAGE_LISTENER_H
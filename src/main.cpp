@@ -1,11 +1,15 @@
 
 
+#include <cstdint>
+#include <ctime>
 #include <iostream>
 #include <vector>
 
 // Infrastructure
 #include "interfaces/IDisplay.h"
 #include "implementations/ConsoleDisplay.h"
+#include "implementations/AsyncConsoleDisplay.h"
+#include "implementations/StockAlertDisplay.h"
 
 // Configuration
 #include "config/Config.h"
@@ -32,6 +36,7 @@
 #include "managers/OrderManager.h"
 #include "managers/ConsumableManager.h"
 #include "managers/ReportManager.h"
+#include "managers/DailyRevenueIndex.h"
 
 // Exceptions - Release 3
 #include "exceptions/PhotoStudioExceptions.h"
@@ -40,10 +45,12 @@
 #include "repository/OrderRepository.h"
 #include "repository/OrderRecord.h"
 #include "repository/FileManager.h"
+#include "repository/ConsumableRepository.h"
 
 using namespace std;
 
 const string DATA_FILE = "orders.dat";
+const string INVENTORY_FILE = "inventory"; // inventory.snap + inventory.log
 
 string getStatusString(OrderStatus status)
 {
@@ -62,6 +69,23 @@ string getStatusString(OrderStatus status)
     }
 }
 
+// Latest completion date among the orders, or today when none has a date
+string getReportDate(const OrderManager &orderManager)
+{
+    std::int32_t latest = static_cast<std::int32_t>(time(nullptr) / 86400);
+    bool found = false;
+    for (const Order *order : orderManager.getAllOrders())
+    {
+        std::int32_t day;
+        if (DailyRevenueIndex::parseDay(order->getCompletionTime(), day) && (!found || day > latest))
+        {
+            latest = day;
+            found = true;
+        }
+    }
+    return DailyRevenueIndex::formatDay(latest);
+}
+
 /**
  * Main function - Orchestrates the photo studio workflow
  *
@@ -71,12 +95,15 @@ string getStatusString(OrderStatus status)
  */
 int main()
 {
-    // Setup infrastructure
-    ConsoleDisplay display;
+    // Setup infrastructure (output is written by a background thread and
+    // flushed when display goes out of scope)
+    AsyncConsoleDisplay display;
     Config config;
 
     OrderRepository repository;
     FileManager fileManager(DATA_FILE, &display);
+    ConsumableRepository consumableRepository(INVENTORY_FILE, &display);
+    StockAlertDisplay stockAlerts(&display); // Outlives the consumables it is attached to
 
     OrderManager orderManager(&display, &config);
     ConsumableManager consumableManager(&display);
@@ -84,12 +111,19 @@ int main()
 
     orderManager.setRepository(&repository);
     orderManager.setFileManager(&fileManager);
+    consumableManager.setRepository(&consumableRepository);
+    consumableManager.addStockAlertListener(&stockAlerts);
 
     display.showLine("=== Photo Studio Operations System - Release 4 ===");
     display.showLine("");
 
     display.showLine("--- Loading Persistent Data ---");
     orderManager.loadData();
+    consumableManager.loadData();
+
+    // Report figures follow the managers from here on
+    reportManager.attachOrderFeed(&orderManager);
+    reportManager.attachConsumableFeed(&consumableManager);
 
     int loadedCount = orderManager.getLoadedOrderCount();
     display.showLine("");
@@ -117,16 +151,21 @@ int main()
         display.showLine("2. " + filmDeveloping.getName() + " - $" + to_string(filmDeveloping.getBasePrice()));
         display.showLine("");
 
-        // Setup consumables inventory
-        Consumable paper("CON001", "Photo Paper", 1000, "sheets");
-        Consumable developer("CON002", "Developer", 50, "liters");
-
-        consumableManager.addConsumable(&paper);
-        consumableManager.addConsumable(&developer);
+        // Setup consumables inventory (stock carries over from the last run)
+        if (consumableManager.getAllConsumables().empty())
+        {
+            consumableManager.createConsumable("CON001", "Photo Paper", 1000, "sheets", 0.12);
+            consumableManager.createConsumable("CON002", "Developer", 50, "liters", 4.50);
+        }
+        consumableManager.setReorderLevel("Photo Paper", 200, 100);
+        consumableManager.setReorderLevel("Developer", 10, 5);
 
         display.showLine("--- Consumables Inventory ---");
-        display.showLine("Photo Paper: " + to_string(paper.getCurrentStock()) + " " + paper.getUnitOfMeasure());
-        display.showLine("Developer: " + to_string(developer.getCurrentStock()) + " " + developer.getUnitOfMeasure());
+        for (Consumable *consumable : consumableManager.getAllConsumables())
+        {
+            display.showLine(consumable->getName() + ": " + to_string(consumable->getCurrentStock()) + " " +
+                             consumable->getUnitOfMeasure());
+        }
         display.showLine("");
 
         if (loadedCount > 0)
@@ -143,23 +182,13 @@ int main()
                                  " | Status: " + getStatusString(order->getStatus()) +
                                  " | Price: $" + to_string(order->getTotalPrice()) +
                                  " | Paid: " + (order->getIsPaid() ? "Yes" : "No"));
-
-                if (order->getStatus() == OrderStatus::PENDING)
-                {
-                    display.showLine("  -> Processing pending order...");
-                    orderManager.processOrder(order);
-                }
-                else if (order->getStatus() == OrderStatus::IN_PROGRESS)
-                {
-                    display.showLine("  -> Completing in-progress order...");
-                    orderManager.completeOrder(order);
-                    if (!order->getIsPaid() && order->getTotalPrice() > 0)
-                    {
-                        orderManager.recordPayment(order);
-                    }
-                }
             }
             display.showLine("");
+
+            // Pending orders are processed, in-progress orders completed and paid
+            display.showLine("--- Catching Up on Queued Orders ---");
+            orderManager.processBacklog();
+            display.showLine("");
         }
         else
         {
@@ -184,6 +213,8 @@ int main()
 
             ConsumableUsage usage1("U001", "Photo Paper", 50);
             ConsumableUsage usage2("U002", "Developer", 2);
+            usage1.assignOrder(regularOrder->getOrderID());
+            usage2.assignOrder(regularOrder->getOrderID());
             consumableManager.recordUsage(usage1);
             consumableManager.recordUsage(usage2);
 
@@ -219,12 +250,18 @@ int main()
         display.showLine("=== End-of-Day Reports ===");
         display.showLine("");
 
-        reportManager.generateDailyRevenueReport(&orderManager);
+        reportManager.generateRevenueSummaryReport(&orderManager);
+        display.showLine("");
+
+        reportManager.generatePeriodRevenueReport(&orderManager, RevenuePeriod::WEEK, getReportDate(orderManager));
         display.showLine("");
 
         reportManager.generateConsumablesUsageReport(&consumableManager);
         display.showLine("");
 
+        reportManager.generateMarginReport(&orderManager, &consumableManager);
+        display.showLine("");
+
         display.showLine("=== Repository Status ===");
         display.showLine("");
         display.showLine("Total orders in system: " + to_string(orderManager.getLoadedOrderCount()));
@@ -252,6 +289,7 @@ int main()
 
         display.showLine("--- Saving Data Before Exit ---");
         orderManager.saveData();
+        consumableManager.saveData();
         return 1;
     }
     catch (const std::exception &e)
@@ -262,11 +300,13 @@ int main()
 
         display.showLine("--- Saving Data Before Exit ---");
         orderManager.saveData();
+        consumableManager.saveData();
         return 1;
     }
 
     display.showLine("--- Saving Data Before Exit ---");
     orderManager.saveData();
+    consumableManager.saveData();
     display.showLine("");
 
     display.showLine("=== Photo Studio System Terminated Successfully ===");
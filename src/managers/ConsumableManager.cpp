@@ -1,85 +1,460 @@
 #include "managers/ConsumableManager.h"
 #include "exceptions/PhotoStudioExceptions.h"
+#include "types/SmallVector.h"
+#include <limits>
+#include <utility>
 
 ConsumableManager::ConsumableManager(const IDisplay *disp)
-    : display(disp)
+    : repository(nullptr), display(disp), dataVersion(0)
 {
 }
 
 ConsumableManager::~ConsumableManager()
 {
-  // Clean up consumables (if ownership is  manager)
+  // Only consumables the manager created itself are deleted
+  for (Consumable *consumable : ownedConsumables)
+  {
+    delete consumable;
+  }
+}
+
+void ConsumableManager::setRepository(ConsumableRepository *repo)
+{
+  std::lock_guard<std::mutex> lock(usageMutex);
+  repository = repo;
+}
+
+void ConsumableManager::loadData()
+{
+  if (!repository)
+    return;
+
+  std::lock_guard<std::mutex> lock(usageMutex);
+  if (!repository->load(usageStore))
+  {
+    return;
+  }
+  dataVersion++;
+  for (IUsageListener *listener : usageListeners)
+  {
+    listener->onUsageSnapshot(usageStore.getTotals());
+  }
+
+  bool changed = false;
+  for (int i = 0; i < repository->getCount(); i++)
+  {
+    const ConsumableRecord &record = repository->getAt(i);
+    Consumable *existing = findConsumableById(record.consumableID);
+    if (existing)
+    {
+      // Registered before loading: the live object wins
+      changed = repository->bind(existing) || changed;
+      continue;
+    }
+
+    int stock = record.stock > std::numeric_limits<int>::max() ? std::numeric_limits<int>::max()
+                                                                : static_cast<int>(record.stock);
+    double unitCost = record.unitCostCents / 100.0;
+    ValidationResult check = Consumable::tryValidate(record.consumableID, record.name, stock,
+                                                     record.unitOfMeasure, unitCost);
+    if (!check)
+    {
+      if (display)
+      {
+        display->log(LogLevel::WARNING, "Warning: Skipped invalid stored consumable {}: {}",
+                     record.consumableID, check.getUserMessage());
+      }
+      continue;
+    }
+
+    Consumable *consumable = new Consumable(record.consumableID, record.name, stock, record.unitOfMeasure,
+                                            unitCost);
+    ownedConsumables.push_back(consumable);
+    registerConsumable(consumable);
+    repository->bind(consumable);
+  }
+
+  // Consumables exist now, so the stored order links can be resolved
+  materialByOrder.clear();
+  for (const OrderUsageRecord &entry : repository->getOrderUsage())
+  {
+    Consumable *consumable = findConsumableById(repository->getAt(static_cast<int>(entry.slot)).consumableID);
+    if (consumable)
+    {
+      addOrderMaterial(entry.orderID, consumable, entry.quantity, entry.costCents);
+    }
+  }
+
+  usageStore.reserve(consumables.size());
+  if (changed)
+  {
+    repository->saveSnapshot(usageStore);
+  }
+}
+
+void ConsumableManager::saveData()
+{
+  if (!repository)
+    return;
+
+  std::lock_guard<std::mutex> lock(usageMutex);
+  repository->commit();
+  if (repository->saveSnapshot(usageStore) && display)
+  {
+    display->log(LogLevel::INFO, "Saved {} consumable(s) to inventory snapshot.", repository->getCount());
+  }
 }
 
 void ConsumableManager::addConsumable(Consumable *consumable)
 {
   validateConsumable(consumable);
+  registerConsumable(consumable);
+
+  std::lock_guard<std::mutex> lock(usageMutex);
+  // Size the usage index for every known consumable up front
+  usageStore.reserve(consumables.size());
+  if (repository)
+  {
+    // Log records refer to stored consumables, so a new one needs a snapshot first
+    if (repository->bind(consumable))
+    {
+      repository->saveSnapshot(usageStore);
+    }
+  }
+}
 
+Consumable *ConsumableManager::createConsumable(const std::string &id, const std::string &name, int stock,
+                                                const std::string &unit, double unitCost)
+{
+  Consumable *consumable = new Consumable(id, name, stock, unit, unitCost);
+  try
+  {
+    addConsumable(consumable);
+  }
+  catch (...)
+  {
+    delete consumable;
+    throw;
+  }
+  ownedConsumables.push_back(consumable);
+  return consumable;
+}
+
+void ConsumableManager::registerConsumable(Consumable *consumable)
+{
   consumables.push_back(consumable);
+  idIndex.emplace(consumable->getConsumableID(), consumable);
+  // The first consumable registered under a name keeps it, as with the old linear search
+  nameIndex.emplace(consumable->getName(), consumable);
+  for (IStockAlertListener *listener : alertListeners)
+  {
+    consumable->addAlertListener(listener);
+  }
+}
+
+std::uint64_t ConsumableManager::getDataVersion() const
+{
+  return dataVersion.load();
+}
+
+void ConsumableManager::addUsageListener(IUsageListener *listener)
+{
+  if (listener == nullptr)
+  {
+    throw InvalidDataException(
+        "Usage listener cannot be null",
+        "Precondition violation: listener == nullptr");
+  }
+
+  // Snapshot and registration under one lock, so no usage is missed or seen twice
+  std::lock_guard<std::mutex> lock(usageMutex);
+  listener->onUsageSnapshot(usageStore.getTotals());
+  usageListeners.push_back(listener);
+}
+
+void ConsumableManager::removeUsageListener(IUsageListener *listener)
+{
+  std::lock_guard<std::mutex> lock(usageMutex);
+  for (auto it = usageListeners.begin(); it != usageListeners.end(); ++it)
+  {
+    if (*it == listener)
+    {
+      usageListeners.erase(it);
+      return;
+    }
+  }
+}
+
+void ConsumableManager::addStockAlertListener(IStockAlertListener *listener)
+{
+  if (listener == nullptr)
+  {
+    throw InvalidDataException(
+        "Stock alert listener cannot be null",
+        "Precondition violation: listener == nullptr");
+  }
+  alertListeners.push_back(listener);
+  for (Consumable *consumable : consumables)
+  {
+    consumable->addAlertListener(listener);
+  }
+}
+
+void ConsumableManager::setReorderLevel(const std::string &consumableName, int level, int hysteresis)
+{
+  Consumable *consumable = lookupByName(consumableName);
+  if (consumable == nullptr)
+  {
+    throw DataNotFoundException(
+        "Consumable not found: " + consumableName,
+        "Repository check failed: consumable does not exist");
+  }
+  consumable->setReorderLevel(level, hysteresis);
+}
+
+/**
+ * StoreUsage - Add taken stock to the rollups, listeners, the order index
+ * and the log
+ */
+void ConsumableManager::storeUsage(const Consumable *consumable, const ConsumableUsage &usage)
+{
+  usageStore.record(usage);
+  dataVersion++;
+  for (IUsageListener *listener : usageListeners)
+  {
+    listener->onUsageRecorded(usage);
+  }
+
+  long long cost = 0;
+  if (usage.hasOrder())
+  {
+    cost = consumable->getUnitCostCents() * usage.getQuantityUsed();
+    addOrderMaterial(usage.getOrderID(), consumable, usage.getQuantityUsed(), cost);
+  }
+
+  if (repository)
+  {
+    repository->logUsage(consumable, usage.getQuantityUsed(), usage.getUsedAt(), usage.getOrderID(), cost);
+  }
+}
+
+void ConsumableManager::addOrderMaterial(const std::string &orderID, const Consumable *consumable, int quantity,
+                                         long long costCents)
+{
+  OrderMaterial &material = materialByOrder.try_emplace(orderID, OrderMaterial{{}, 0}).first->second;
+  material.entries.push_back(OrderUsageEntry{consumable, quantity, costCents});
+  material.costCents += costCents;
+}
+
+void ConsumableManager::persistChanges()
+{
+  if (repository->commit())
+  {
+    repository->saveSnapshot(usageStore);
+  }
 }
 
 void ConsumableManager::recordUsage(const ConsumableUsage &usage)
 {
-  validateConsumableUsage(usage);
+  Consumable *consumable = validateConsumableUsage(usage);
 
-  usageRecords.push_back(usage);
+  // Check and decrement are one atomic step, so concurrent usage cannot oversell
+  if (!consumable->tryConsume(usage.getQuantityUsed(), display))
+  {
+    throw InsufficientStockException(
+        "Insufficient stock for " + usage.getConsumableName(),
+        "Stock available: " + std::to_string(consumable->getAvailableStock()) +
+            ", requested: " + std::to_string(usage.getQuantityUsed()));
+  }
 
-  // Update stock for the consumable
-  Consumable *consumable = findConsumableByName(usage.getConsumableName());
-  if (consumable)
+  // Recorded only once the stock has actually been taken
+  std::lock_guard<std::mutex> lock(usageMutex);
+  storeUsage(consumable, usage);
+  if (repository)
   {
-    int previousStock = consumable->getCurrentStock();
+    persistChanges();
+  }
+}
+
+void ConsumableManager::recordUsageBatch(const std::vector<ConsumableUsage> &usages)
+{
+  tryRecordUsageBatch(usages).throwIfError();
+}
 
-    if (previousStock < usage.getQuantityUsed())
+/**
+ * TryRecordUsageBatch - Record all usages of a job as one unit
+ *
+ * Every line is validated first and quantities are summed per consumable.
+ * The sums are then reserved one consumable at a time; if any reservation
+ * fails, the ones already made are released and nothing changes. Only
+ * when all are held are they committed and the usages stored, so other
+ * threads never see part of a batch applied.
+ */
+ValidationResult ConsumableManager::tryRecordUsageBatch(const std::vector<ConsumableUsage> &usages)
+{
+  if (usages.empty())
+  {
+    return ValidationResult::ok();
+  }
+
+  // A job touches a handful of consumables, so a linear search beats hashing
+  SmallVector<std::pair<Consumable *, int>, 8> needed;
+  SmallVector<Consumable *, 8> resolved; // Per line, reused when storing
+  resolved.reserve(usages.size());
+  for (const ConsumableUsage &usage : usages)
+  {
+    Consumable *consumable = nullptr;
+    ValidationResult check = checkConsumableUsage(usage, consumable);
+    if (!check)
+    {
+      return check;
+    }
+    resolved.push_back(consumable);
+
+    std::size_t i = 0;
+    while (i < needed.size() && needed[i].first != consumable)
+    {
+      i++;
+    }
+    if (i == needed.size())
+    {
+      needed.emplace_back(consumable, 0);
+    }
+    if (needed[i].second > std::numeric_limits<int>::max() - usage.getQuantityUsed())
+    {
+      return ValidationResult::failure(
+          ErrorCode::INVALID_DATA,
+          "Usage batch quantity is too large for ",
+          "Precondition violation: summed quantity overflows int",
+          consumable->getName());
+    }
+    needed[i].second += usage.getQuantityUsed();
+  }
+
+  for (std::size_t i = 0; i < needed.size(); i++)
+  {
+    if (!needed[i].first->tryReserve(needed[i].second))
     {
-      throw InsufficientStockException(
-          "Insufficient stock for " + usage.getConsumableName(),
-          "Stock available: " + std::to_string(previousStock) +
-              ", requested: " + std::to_string(usage.getQuantityUsed()));
+      for (std::size_t j = 0; j < i; j++)
+      {
+        needed[j].first->releaseReserved(needed[j].second);
+      }
+      return ValidationResult::failure(
+          ErrorCode::INSUFFICIENT_STOCK,
+          "Insufficient stock for ",
+          "Usage batch rejected: reservation failed",
+          needed[i].first->getName());
     }
+  }
 
-    consumable->updateStock(-usage.getQuantityUsed(), display);
+  for (std::size_t i = 0; i < needed.size(); i++)
+  {
+    needed[i].first->commitReserved(needed[i].second);
+  }
 
-    if (consumable->getCurrentStock() != previousStock - usage.getQuantityUsed())
+  {
+    std::lock_guard<std::mutex> lock(usageMutex);
+    for (std::size_t i = 0; i < usages.size(); i++)
     {
-      throw ValidationException(
-          "Stock update failed",
-          "Postcondition violation: stock not properly decreased");
+      storeUsage(resolved[i], usages[i]);
+    }
+    if (repository)
+    {
+      persistChanges(); // One append for the whole batch
     }
   }
+
+  if (display)
+  {
+    display->log(LogLevel::INFO, "Usage batch recorded: {} line(s) across {} consumable(s)",
+                 usages.size(), needed.size());
+  }
+  return ValidationResult::ok();
 }
 
-void ConsumableManager::updateStock(const std::string &consumableName, int quantity)
+StockReservation ConsumableManager::reserveStock(const std::string &consumableName, int quantity)
 {
-  validateStockUpdate(consumableName, quantity);
+  if (quantity <= 0)
+  {
+    throw InvalidDataException(
+        "Usage quantity must be greater than zero",
+        "Precondition violation: quantity <= 0");
+  }
 
-  Consumable *consumable = findConsumableByName(consumableName);
-  if (consumable)
+  Consumable *consumable = lookupByName(consumableName);
+  if (consumable == nullptr)
   {
-    int previousStock = consumable->getCurrentStock();
-    consumable->updateStock(quantity, display);
+    throw DataNotFoundException(
+        "Consumable not found: " + consumableName,
+        "Repository check failed: consumable does not exist");
+  }
 
-    int expectedStock = previousStock + quantity;
-    if (consumable->getCurrentStock() != expectedStock)
-    {
-      throw ValidationException(
-          "Stock update failed",
-          "Postcondition violation: stock = " + std::to_string(consumable->getCurrentStock()) +
-              ", expected = " + std::to_string(expectedStock));
-    }
+  StockReservation reservation = consumable->reserve(quantity);
+  if (!reservation.isActive())
+  {
+    throw InsufficientStockException(
+        "Insufficient stock for " + consumableName,
+        "Stock available: " + std::to_string(consumable->getAvailableStock()) +
+            ", requested: " + std::to_string(quantity));
   }
+  return reservation;
 }
 
-Consumable *ConsumableManager::findConsumableByName(const std::string &name)
+void ConsumableManager::commitUsage(StockReservation &reservation, const std::string &usageID,
+                                    const std::string &orderID)
 {
-  for (auto *consumable : consumables)
+  if (!reservation.isActive())
   {
-    if (consumable->getName() == name)
-    {
-      return consumable;
-    }
+    throw BusinessRuleException(
+        "Stock reservation is no longer active",
+        "Precondition violation: commit on an inactive reservation");
+  }
+
+  // Built first so that an invalid usage ID leaves the reservation untouched
+  ConsumableUsage usage(usageID, reservation.getConsumable()->getName(), reservation.getQuantity());
+  usage.assignOrder(orderID);
+  Consumable *consumable = reservation.getConsumable();
+  reservation.commit(display);
+
+  std::lock_guard<std::mutex> lock(usageMutex);
+  storeUsage(consumable, usage);
+  if (repository)
+  {
+    persistChanges();
+  }
+}
+
+void ConsumableManager::updateStock(const std::string &consumableName, int quantity)
+{
+  Consumable *consumable = validateStockUpdate(consumableName, quantity);
+
+  // Applied as one compare-and-swap; rejects changes that would go below
+  // zero or below the reserved amount even if another thread got in first
+  consumable->updateStock(quantity, display);
+
+  if (repository)
+  {
+    std::lock_guard<std::mutex> lock(usageMutex);
+    repository->logStockChange(consumable, quantity);
+    persistChanges();
   }
-  return nullptr;
+}
+
+Consumable *ConsumableManager::findConsumableByName(const std::string &name)
+{
+  return lookupByName(name);
+}
+
+Consumable *ConsumableManager::findConsumableById(const std::string &consumableID)
+{
+  auto it = idIndex.find(consumableID);
+  return it != idIndex.end() ? it->second : nullptr;
+}
+
+Consumable *ConsumableManager::lookupByName(const std::string &name) const
+{
+  auto it = nameIndex.find(name);
+  return it != nameIndex.end() ? it->second : nullptr;
 }
 
 const std::vector<Consumable *> &ConsumableManager::getAllConsumables() const
@@ -87,9 +462,67 @@ const std::vector<Consumable *> &ConsumableManager::getAllConsumables() const
   return consumables;
 }
 
-const std::vector<ConsumableUsage> &ConsumableManager::getUsageRecords() const
+std::vector<UsageTotal> ConsumableManager::getUsageTotals() const
+{
+  std::lock_guard<std::mutex> lock(usageMutex);
+  return usageStore.getTotals();
+}
+
+long long ConsumableManager::getTotalUsage(const std::string &consumableName) const
+{
+  std::lock_guard<std::mutex> lock(usageMutex);
+  return usageStore.getTotalQuantity(consumableName);
+}
+
+std::vector<UsageBucket> ConsumableManager::getUsageHistory(const std::string &consumableName,
+                                                            UsageGranularity granularity,
+                                                            std::int64_t from, std::int64_t to) const
+{
+  std::lock_guard<std::mutex> lock(usageMutex);
+  return usageStore.getHistory(consumableName, granularity, from, to);
+}
+
+std::vector<ConsumableUsage> ConsumableManager::getRecentUsage() const
+{
+  std::lock_guard<std::mutex> lock(usageMutex);
+  const std::deque<ConsumableUsage> &recent = usageStore.getRecentUsage();
+  return std::vector<ConsumableUsage>(recent.begin(), recent.end());
+}
+
+std::uint64_t ConsumableManager::getRecordedUsageCount() const
 {
-  return usageRecords;
+  std::lock_guard<std::mutex> lock(usageMutex);
+  return usageStore.getRecordedCount();
+}
+
+std::vector<OrderUsageEntry> ConsumableManager::getOrderUsage(const std::string &orderID) const
+{
+  std::lock_guard<std::mutex> lock(usageMutex);
+  auto it = materialByOrder.find(orderID);
+  if (it == materialByOrder.end())
+  {
+    return std::vector<OrderUsageEntry>();
+  }
+  return it->second.entries;
+}
+
+long long ConsumableManager::getOrderMaterialCostCents(const std::string &orderID) const
+{
+  std::lock_guard<std::mutex> lock(usageMutex);
+  auto it = materialByOrder.find(orderID);
+  return it == materialByOrder.end() ? 0 : it->second.costCents;
+}
+
+std::unordered_map<std::string, long long> ConsumableManager::getMaterialCostByOrder() const
+{
+  std::unordered_map<std::string, long long> costs;
+  std::lock_guard<std::mutex> lock(usageMutex);
+  costs.reserve(materialByOrder.size());
+  for (const auto &entry : materialByOrder)
+  {
+    costs.emplace(entry.first, entry.second.costCents);
+  }
+  return costs;
 }
 
 void ConsumableManager::validateConsumable(Consumable *consumable) const
@@ -108,43 +541,62 @@ void ConsumableManager::validateConsumable(Consumable *consumable) const
         "Precondition violation: consumable name is empty");
   }
 
-  for (const auto &existing : consumables)
+  if (idIndex.find(consumable->getConsumableID()) != idIndex.end())
   {
-    if (existing->getConsumableID() == consumable->getConsumableID())
-    {
-      throw DuplicateDataException(
-          "Consumable ID already exists: " + consumable->getConsumableID(),
-          "Duplicate consumable ID in repository");
-    }
+    throw DuplicateDataException(
+        "Consumable ID already exists: " + consumable->getConsumableID(),
+        "Duplicate consumable ID in repository");
   }
 }
 
-void ConsumableManager::validateConsumableUsage(const ConsumableUsage &usage) const
+ValidationResult ConsumableManager::tryValidateConsumableUsage(const ConsumableUsage &usage) const
 {
-  if (usage.getConsumableName().empty())
+  Consumable *found = nullptr;
+  return checkConsumableUsage(usage, found);
+}
+
+ValidationResult ConsumableManager::checkConsumableUsage(const ConsumableUsage &usage, Consumable *&found) const
+{
+  // The not-found result refers to the name stored in usage
+  const std::string &name = usage.getConsumableName();
+
+  if (name.empty())
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Consumable name cannot be empty",
         "Precondition violation: consumable name is empty");
   }
 
   if (usage.getQuantityUsed() <= 0)
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Usage quantity must be greater than zero",
         "Precondition violation: quantity <= 0");
   }
 
-  Consumable *consumable = const_cast<ConsumableManager *>(this)->findConsumableByName(usage.getConsumableName());
-  if (consumable == nullptr)
+  found = lookupByName(name);
+  if (found == nullptr)
   {
-    throw DataNotFoundException(
-        "Consumable not found: " + usage.getConsumableName(),
-        "Repository check failed: consumable does not exist");
+    return ValidationResult::failure(
+        ErrorCode::NOT_FOUND,
+        "Consumable not found: ",
+        "Repository check failed: consumable does not exist",
+        name);
   }
+
+  return ValidationResult::ok();
 }
 
-void ConsumableManager::validateStockUpdate(const std::string &consumableName, int quantity) const
+Consumable *ConsumableManager::validateConsumableUsage(const ConsumableUsage &usage) const
+{
+  Consumable *found = nullptr;
+  checkConsumableUsage(usage, found).throwIfError();
+  return found;
+}
+
+Consumable *ConsumableManager::validateStockUpdate(const std::string &consumableName, int quantity) const
 {
   if (consumableName.empty())
   {
@@ -153,7 +605,7 @@ void ConsumableManager::validateStockUpdate(const std::string &consumableName, i
         "Precondition violation: consumable name is empty");
   }
 
-  Consumable *consumable = const_cast<ConsumableManager *>(this)->findConsumableByName(consumableName);
+  Consumable *consumable = lookupByName(consumableName);
   if (consumable == nullptr)
   {
     throw DataNotFoundException(
@@ -161,7 +613,14 @@ void ConsumableManager::validateStockUpdate(const std::string &consumableName, i
         "Repository check failed: consumable does not exist");
   }
 
-  int newStock = consumable->getCurrentStock() + quantity;
+  long long newStock = static_cast<long long>(consumable->getCurrentStock()) + quantity;
+  if (newStock > Consumable::MAX_STOCK)
+  {
+    throw InvalidDataException(
+        "Stock cannot exceed " + std::to_string(Consumable::MAX_STOCK) + " " + consumable->getUnitOfMeasure(),
+        "Precondition violation: stock update would overflow (current: " +
+            std::to_string(consumable->getCurrentStock()) + ", change: " + std::to_string(quantity) + ")");
+  }
   if (newStock < 0)
   {
     throw BusinessRuleException(
@@ -169,4 +628,6 @@ void ConsumableManager::validateStockUpdate(const std::string &consumableName, i
         "Business rule violation: stock cannot be negative (current: " +
             std::to_string(consumable->getCurrentStock()) + ", change: " + std::to_string(quantity) + ")");
   }
+
+  return consumable;
 }
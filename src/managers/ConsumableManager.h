@@ -1,36 +1,152 @@
 #ifndef CONSUMABLE_MANAGER_H
 #define CONSUMABLE_MANAGER_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
 #include "entities/Consumable.h"
 #include "entities/ConsumableUsage.h"
 #include "interfaces/IDisplay.h"
+#include "interfaces/IUsageListener.h"
+#include "repository/UsageStore.h"
+#include "repository/ConsumableRepository.h"
 #include "exceptions/PhotoStudioExceptions.h"
+#include "types/ValidationResult.h"
 
+/**
+ * OrderUsageEntry - One use of a consumable charged to an order
+ *
+ * costCents is the quantity at the unit cost in force when it was used.
+ */
+struct OrderUsageEntry
+{
+  const Consumable *consumable;
+  int quantity;
+  long long costCents;
+};
+
+/**
+ * ConsumableManager - Registered consumables, stock changes and usage records
+ *
+ * Consumables are indexed by name and by ID, so every lookup is O(1).
+ * Validation returns the consumable it found and the mutation reuses that
+ * pointer, so a usage record or stock update costs a single lookup.
+ *
+ * Once all consumables are registered, usage can be recorded from several
+ * threads: stock changes are lock-free on the consumable itself and only
+ * the append to the usage store is serialized.
+ *
+ * Usage is not kept record by record: the UsageStore rolls it up into
+ * per-consumable totals and minute/hour/day buckets and keeps only a
+ * bounded tail of raw records, so memory does not grow with usage.
+ *
+ * With a ConsumableRepository attached, every stock change made through
+ * the manager is appended to its log, so inventory and usage survive a
+ * restart (see loadData / saveData).
+ *
+ * Usage linked to an order (ConsumableUsage::assignOrder) is also indexed
+ * by order ID together with its material cost, so the cost of every order
+ * is available in one pass without searching the usage. The repository
+ * stores each link with the order ID, and loadData rebuilds the index
+ * from them, so order costs survive a restart.
+ */
 class ConsumableManager
 {
 private:
   std::vector<Consumable *> consumables;
-  std::vector<ConsumableUsage> usageRecords;
+  std::unordered_map<std::string, Consumable *> nameIndex;
+  std::unordered_map<std::string, Consumable *> idIndex;
+  UsageStore usageStore;
+  mutable std::mutex usageMutex; // Guards usageStore and repository
+  ConsumableRepository *repository;
+  std::vector<Consumable *> ownedConsumables; // Created by loadData / createConsumable
+  std::vector<IStockAlertListener *> alertListeners; // Attached to every registered consumable
+  std::vector<IUsageListener *> usageListeners;      // Guarded by usageMutex
+
+  struct OrderMaterial
+  {
+    std::vector<OrderUsageEntry> entries;
+    long long costCents;
+  };
+
+  // Order ID -> usage charged to that order (guarded by usageMutex)
+  std::unordered_map<std::string, OrderMaterial> materialByOrder;
   const IDisplay *display;
+  std::atomic<std::uint64_t> dataVersion; // Bumped whenever recorded usage changes
 
 public:
   ConsumableManager(const IDisplay *disp);
   ~ConsumableManager();
 
+  // Persistence: attach before loading or registering consumables
+  void setRepository(ConsumableRepository *repo);
+  void loadData(); // Creates the stored consumables
+  void saveData(); // Writes a snapshot
+
   void addConsumable(Consumable *consumable);
+  Consumable *createConsumable(const std::string &id, const std::string &name, int stock,
+                               const std::string &unit, double unitCost = 0.0); // Owned by the manager
   void recordUsage(const ConsumableUsage &usage);
+
+  // Records every usage of one job or none of them, with one summary line;
+  // the try form reports the first failure instead of throwing it
+  void recordUsageBatch(const std::vector<ConsumableUsage> &usages);
+  ValidationResult tryRecordUsageBatch(const std::vector<ConsumableUsage> &usages);
   void updateStock(const std::string &consumableName, int quantity);
+
+  // Hold stock for a job, then record the usage when the job is done
+  // (an uncommitted reservation gives its stock back when destroyed)
+  StockReservation reserveStock(const std::string &consumableName, int quantity);
+  void commitUsage(StockReservation &reservation, const std::string &usageID,
+                   const std::string &orderID = "");
+  // Increases whenever recorded usage (totals, order costs) changes
+  std::uint64_t getDataVersion() const;
+
+  // Usage feed for derived views (see IUsageListener)
+  void addUsageListener(IUsageListener *listener);
+  void removeUsageListener(IUsageListener *listener);
+
+  // Reorder alerts: listeners are attached to current and future consumables
+  void addStockAlertListener(IStockAlertListener *listener);
+  void setReorderLevel(const std::string &consumableName, int level, int hysteresis = 0);
+
   Consumable *findConsumableByName(const std::string &name);
+  Consumable *findConsumableById(const std::string &consumableID);
+
+  // Non-throwing check for bulk paths; recordUsage throws the same failures
+  ValidationResult tryValidateConsumableUsage(const ConsumableUsage &usage) const;
 
   const std::vector<Consumable *> &getAllConsumables() const;
-  const std::vector<ConsumableUsage> &getUsageRecords() const;
+
+  // Usage queries return copies taken under the usage lock
+  std::vector<UsageTotal> getUsageTotals() const;
+  long long getTotalUsage(const std::string &consumableName) const;
+  std::vector<UsageBucket> getUsageHistory(const std::string &consumableName, UsageGranularity granularity,
+                                           std::int64_t from, std::int64_t to) const;
+  std::vector<ConsumableUsage> getRecentUsage() const;
+  std::uint64_t getRecordedUsageCount() const;
+
+  // Material charged to orders, by order ID
+  std::vector<OrderUsageEntry> getOrderUsage(const std::string &orderID) const;
+  long long getOrderMaterialCostCents(const std::string &orderID) const;
+  // Order ID -> material cost, for every order that used material
+  std::unordered_map<std::string, long long> getMaterialCostByOrder() const;
 
 private:
   void validateConsumable(Consumable *consumable) const;
-  void validateConsumableUsage(const ConsumableUsage &usage) const;
-  void validateStockUpdate(const std::string &consumableName, int quantity) const;
+  // Each check returns the consumable it looked up so the caller need not search again
+  ValidationResult checkConsumableUsage(const ConsumableUsage &usage, Consumable *&found) const;
+  Consumable *validateConsumableUsage(const ConsumableUsage &usage) const;
+  Consumable *validateStockUpdate(const std::string &consumableName, int quantity) const;
+  Consumable *lookupByName(const std::string &name) const;
+  void registerConsumable(Consumable *consumable);
+  void persistChanges(); // Caller holds usageMutex
+  void addOrderMaterial(const std::string &orderID, const Consumable *consumable, int quantity,
+                        long long costCents); // Caller holds usageMutex
+  void storeUsage(const Consumable *consumable, const ConsumableUsage &usage); // Caller holds usageMutex
 };
 
 #endif // CONSUMABLE_MANAGER_H
@@ -0,0 +1,201 @@
+#include "managers/DailyRevenueIndex.h"
+#include <algorithm>
+#include <cstdio>
+
+// Civil date <-> day number conversions for the proleptic Gregorian calendar
+static std::int32_t daysFromCivil(int year, int month, int day)
+{
+  year -= month <= 2 ? 1 : 0;
+  int era = (year >= 0 ? year : year - 399) / 400;
+  int yearOfEra = year - era * 400;
+  int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  return era * 146097 + dayOfEra - 719468;
+}
+
+static void civilFromDays(std::int32_t days, int &year, int &month, int &day)
+{
+  days += 719468;
+  int era = (days >= 0 ? days : days - 146096) / 146097;
+  int dayOfEra = days - era * 146097;
+  int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+  int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  int monthIndex = (5 * dayOfYear + 2) / 153;
+  day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+  month = monthIndex + (monthIndex < 10 ? 3 : -9);
+  year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+static int daysInMonth(int year, int month)
+{
+  static const int LENGTHS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+  return month == 2 && leap ? 29 : LENGTHS[month - 1];
+}
+
+DailyRevenueIndex::DailyRevenueIndex()
+    : totalCents(0)
+{
+}
+
+bool DailyRevenueIndex::parseDay(const std::string &text, std::int32_t &day)
+{
+  // "YYYY-MM-DD", optionally followed by a time
+  if (text.size() < 10 || text[4] != '-' || text[7] != '-' || (text.size() > 10 && text[10] != ' '))
+  {
+    return false;
+  }
+  int fields[3] = {0, 0, 0};
+  const int starts[3] = {0, 5, 8};
+  const int lengths[3] = {4, 2, 2};
+  for (int f = 0; f < 3; f++)
+  {
+    for (int i = starts[f]; i < starts[f] + lengths[f]; i++)
+    {
+      if (text[i] < '0' || text[i] > '9')
+      {
+        return false;
+      }
+      fields[f] = fields[f] * 10 + (text[i] - '0');
+    }
+  }
+
+  if (fields[1] < 1 || fields[1] > 12 || fields[2] < 1 || fields[2] > daysInMonth(fields[0], fields[1]))
+  {
+    return false;
+  }
+  day = daysFromCivil(fields[0], fields[1], fields[2]);
+  return true;
+}
+
+std::string DailyRevenueIndex::formatDay(std::int32_t day)
+{
+  int year, month, dayOfMonth;
+  civilFromDays(day, year, month, dayOfMonth);
+  char text[16];
+  std::snprintf(text, sizeof(text), "%04d-%02d-%02d", year, month, dayOfMonth);
+  return text;
+}
+
+std::int32_t DailyRevenueIndex::weekStart(std::int32_t day)
+{
+  // 1970-01-01 was a Thursday, three days after a Monday
+  std::int32_t sinceMonday = (day + 3) % 7;
+  if (sinceMonday < 0)
+  {
+    sinceMonday += 7;
+  }
+  return day - sinceMonday;
+}
+
+std::int32_t DailyRevenueIndex::monthStart(std::int32_t day)
+{
+  int year, month, dayOfMonth;
+  civilFromDays(day, year, month, dayOfMonth);
+  return day - (dayOfMonth - 1);
+}
+
+std::int32_t DailyRevenueIndex::nextMonthStart(std::int32_t day)
+{
+  int year, month, dayOfMonth;
+  civilFromDays(day, year, month, dayOfMonth);
+  return day - (dayOfMonth - 1) + daysInMonth(year, month);
+}
+
+std::vector<DailyRevenue>::const_iterator DailyRevenueIndex::lowerBound(std::int32_t day) const
+{
+  return std::lower_bound(days.begin(), days.end(), day,
+                          [](const DailyRevenue &bucket, std::int32_t value)
+                          { return bucket.day < value; });
+}
+
+void DailyRevenueIndex::add(const std::string &completionTime, bool express, long long cents)
+{
+  std::int32_t day;
+  if (parseDay(completionTime, day))
+  {
+    add(day, express, cents);
+  }
+  else
+  {
+    addUndated(express, cents);
+  }
+}
+
+void DailyRevenueIndex::add(std::int32_t day, bool express, long long cents)
+{
+  DailyRevenue *bucket;
+  if (!days.empty() && days.back().day == day)
+  {
+    bucket = &days.back();
+  }
+  else if (days.empty() || days.back().day < day)
+  {
+    days.emplace_back(day);
+    bucket = &days.back();
+  }
+  else
+  {
+    auto it = days.begin() + (lowerBound(day) - days.cbegin());
+    if (it == days.end() || it->day != day)
+    {
+      it = days.insert(it, DailyRevenue(day));
+    }
+    bucket = &*it;
+  }
+
+  bucket->paidCents += cents;
+  (express ? bucket->expressCents : bucket->regularCents) += cents;
+  totalCents += cents;
+}
+
+void DailyRevenueIndex::addUndated(bool express, long long cents)
+{
+  undated.paidCents += cents;
+  (express ? undated.expressCents : undated.regularCents) += cents;
+  totalCents += cents;
+}
+
+void DailyRevenueIndex::clear()
+{
+  days.clear();
+  undated = DailyRevenue();
+  totalCents = 0;
+}
+
+std::vector<DailyRevenue> DailyRevenueIndex::getDays(std::int32_t firstDay, std::int32_t endDay) const
+{
+  std::vector<DailyRevenue> result;
+  for (auto it = lowerBound(firstDay); it != days.end() && it->day < endDay; ++it)
+  {
+    result.push_back(*it);
+  }
+  return result;
+}
+
+DailyRevenue DailyRevenueIndex::getRange(std::int32_t firstDay, std::int32_t endDay) const
+{
+  DailyRevenue sum(firstDay);
+  for (auto it = lowerBound(firstDay); it != days.end() && it->day < endDay; ++it)
+  {
+    sum.paidCents += it->paidCents;
+    sum.expressCents += it->expressCents;
+    sum.regularCents += it->regularCents;
+  }
+  return sum;
+}
+
+const DailyRevenue &DailyRevenueIndex::getUndated() const
+{
+  return undated;
+}
+
+long long DailyRevenueIndex::getTotalCents() const
+{
+  return totalCents;
+}
+
+std::size_t DailyRevenueIndex::getDayCount() const
+{
+  return days.size();
+}
@@ -0,0 +1,65 @@
+#ifndef DAILY_REVENUE_INDEX_H
+#define DAILY_REVENUE_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * DailyRevenue - Paid revenue of the orders due on one day
+ */
+struct DailyRevenue
+{
+  std::int32_t day; // Days since 1970-01-01
+  long long paidCents;
+  long long expressCents;
+  long long regularCents;
+
+  DailyRevenue() : day(0), paidCents(0), expressCents(0), regularCents(0) {}
+  explicit DailyRevenue(std::int32_t d) : day(d), paidCents(0), expressCents(0), regularCents(0) {}
+};
+
+/**
+ * DailyRevenueIndex - Paid revenue bucketed by completion date
+ *
+ * One bucket per day that has paid orders, kept sorted by day. Orders
+ * are usually paid in date order, so a new bucket is almost always
+ * appended; reading a day, week or month is a binary search plus one
+ * step per bucket in the range. Completion times that do not start with
+ * a valid "YYYY-MM-DD" date are counted as undated.
+ */
+class DailyRevenueIndex
+{
+private:
+  std::vector<DailyRevenue> days; // Sorted by day
+  DailyRevenue undated;
+  long long totalCents;
+
+  std::vector<DailyRevenue>::const_iterator lowerBound(std::int32_t day) const;
+
+public:
+  DailyRevenueIndex();
+
+  // Days since 1970-01-01 for the date at the start of text
+  static bool parseDay(const std::string &text, std::int32_t &day);
+  static std::string formatDay(std::int32_t day);
+  static std::int32_t weekStart(std::int32_t day); // Monday on or before day
+  static std::int32_t monthStart(std::int32_t day);
+  static std::int32_t nextMonthStart(std::int32_t day);
+
+  // cents may be negative (a paid order was repriced down)
+  void add(const std::string &completionTime, bool express, long long cents);
+  void add(std::int32_t day, bool express, long long cents);
+  void addUndated(bool express, long long cents);
+  void clear();
+
+  // Buckets with firstDay <= day < endDay, oldest first
+  std::vector<DailyRevenue> getDays(std::int32_t firstDay, std::int32_t endDay) const;
+  // Sum over firstDay <= day < endDay; the result's day is firstDay
+  DailyRevenue getRange(std::int32_t firstDay, std::int32_t endDay) const;
+  const DailyRevenue &getUndated() const;
+  long long getTotalCents() const;
+  std::size_t getDayCount() const;
+};
+
+#endif // DAILY_REVENUE_INDEX_H
@@ -1,11 +1,20 @@
 #include "managers/OrderManager.h"
 #include "orders/ExpressOrder.h"
 #include "exceptions/PhotoStudioExceptions.h"
+#include "concurrency/WorkStealingPool.h"
 #include <algorithm>
+#include <cmath>
+#include <unordered_set>
 
 OrderManager::OrderManager(const IDisplay *disp, const Config *cfg)
-    : display(disp), config(cfg), repository(nullptr), fileManager(nullptr)
+    : display(disp), config(cfg), repository(nullptr), fileManager(nullptr),
+      concurrentMode(false), paidRevenueCents(0), expressRevenueCents(0),
+      regularRevenueCents(0), dataVersion(0), aggregateVerification(false)
 {
+  for (auto &count : statusCounts)
+  {
+    count.store(0);
+  }
 }
 
 OrderManager::~OrderManager()
@@ -16,12 +25,14 @@ OrderManager::~OrderManager()
     delete order;
   }
   orders.clear();
+  orderIndex.clear();
 
   for (auto *client : clients)
   {
     delete client;
   }
   clients.clear();
+  clientIndex.clear();
 }
 
 void OrderManager::setRepository(OrderRepository *repo)
@@ -39,6 +50,52 @@ OrderRepository *OrderManager::getRepository()
   return repository;
 }
 
+void OrderManager::enableConcurrentMode()
+{
+  concurrentMode = true;
+}
+
+bool OrderManager::isConcurrentMode() const
+{
+  return concurrentMode;
+}
+
+std::shared_lock<std::shared_mutex> OrderManager::lockIndexShared() const
+{
+  if (!concurrentMode)
+  {
+    return std::shared_lock<std::shared_mutex>(indexMutex, std::defer_lock);
+  }
+  return std::shared_lock<std::shared_mutex>(indexMutex);
+}
+
+std::unique_lock<std::shared_mutex> OrderManager::lockIndexExclusive() const
+{
+  if (!concurrentMode)
+  {
+    return std::unique_lock<std::shared_mutex>(indexMutex, std::defer_lock);
+  }
+  return std::unique_lock<std::shared_mutex>(indexMutex);
+}
+
+std::unique_lock<std::mutex> OrderManager::lockOrder(const Order *order) const
+{
+  if (!concurrentMode)
+  {
+    return std::unique_lock<std::mutex>(order->getMutex(), std::defer_lock);
+  }
+  return std::unique_lock<std::mutex>(order->getMutex());
+}
+
+std::unique_lock<std::mutex> OrderManager::lockRepository()
+{
+  if (!concurrentMode)
+  {
+    return std::unique_lock<std::mutex>(repositoryMutex, std::defer_lock);
+  }
+  return std::unique_lock<std::mutex>(repositoryMutex);
+}
+
 int OrderManager::statusToInt(OrderStatus status) const
 {
   switch (status)
@@ -75,33 +132,62 @@ OrderStatus OrderManager::intToStatus(int status) const
 
 Client *OrderManager::findOrCreateClient(const std::string &clientID, const std::string &surname)
 {
-  for (auto *client : clients)
   {
-    if (client->getID() == clientID)
+    auto readLock = lockIndexShared();
+    auto it = clientIndex.find(clientID);
+    if (it != clientIndex.end())
     {
-      return client;
+      return it->second;
     }
   }
 
+  auto writeLock = lockIndexExclusive();
+  return lookupOrCreateClient(clientID, surname);
+}
+
+Client *OrderManager::lookupOrCreateClient(const std::string &clientID, const std::string &surname)
+{
+  auto it = clientIndex.find(clientID);
+  if (it != clientIndex.end())
+  {
+    return it->second;
+  }
+
   Client *newClient = new Client(clientID, surname);
   clients.push_back(newClient);
+  clientIndex.emplace(clientID, newClient);
   return newClient;
 }
 
 Order *OrderManager::findOrderById(const std::string &orderID)
 {
-  for (auto *order : orders)
+  auto readLock = lockIndexShared();
+  return lookupOrder(orderID);
+}
+
+Order *OrderManager::lookupOrder(const std::string &orderID) const
+{
+  auto it = orderIndex.find(orderID);
+  if (it == orderIndex.end())
   {
-    if (order->getOrderID() == orderID)
-    {
-      return order;
-    }
+    return nullptr;
   }
-  return nullptr;
+  return it->second;
+}
+
+Order *OrderManager::findOrderByHandle(std::uint32_t handle) const
+{
+  auto readLock = lockIndexShared();
+  if (handle >= orders.size())
+  {
+    return nullptr;
+  }
+  return orders[handle];
 }
 
 int OrderManager::getLoadedOrderCount() const
 {
+  auto readLock = lockIndexShared();
   return static_cast<int>(orders.size());
 }
 
@@ -110,19 +196,128 @@ const std::vector<Client *> &OrderManager::getAllClients() const
   return clients;
 }
 
-Order *OrderManager::createOrderFromRecord(const OrderRecord &record, Client *client)
+Order *OrderManager::instantiateOrder(const std::string &orderID, Client *client,
+                                      const std::string &completionTime, bool isExpress)
 {
-  Order *order = nullptr;
+  if (isExpress)
+  {
+    return new ExpressOrder(orderID, completionTime, client, config);
+  }
+  return new Order(orderID, completionTime, client);
+}
+
+void OrderManager::registerOrder(Order *order)
+{
+  order->assignHandle(static_cast<std::uint32_t>(orders.size()));
+  orders.push_back(order);
+  orderIndex.emplace(order->getOrderID(), order);
+  dataVersion++;
 
-  if (record.isExpress)
+  // Restored orders may arrive already paid
+  statusCounts[statusToInt(order->getStatus())]++;
+  if (order->getIsPaid())
   {
-    order = new ExpressOrder(record.orderID, record.completionTime, client, config);
+    addPaidRevenue(order, toCents(order->getTotalPrice()));
+  }
+}
+
+/**
+ * Running aggregates - maintained on every workflow step
+ *
+ * Counts by status move on each successful transition, and paid revenue
+ * (total, express, regular) changes on payment and on any price change of
+ * an already paid order. Amounts are kept in integer cents so the totals do
+ * not drift. Callers hold the order lock for payment and price changes.
+ */
+bool OrderManager::advanceOrder(Order *order, OrderStatus from, OrderStatus to, const IDisplay *notify)
+{
+  if (!order->tryTransition(from, to, notify))
+  {
+    return false;
+  }
+
+  statusCounts[statusToInt(from)]--;
+  statusCounts[statusToInt(to)]++;
+  dataVersion++;
+  publishChange(order, from, to);
+  return true;
+}
+
+bool OrderManager::payOrder(Order *order, const IDisplay *notify)
+{
+  if (!order->tryRecordPayment(notify))
+  {
+    return false;
+  }
+
+  addPaidRevenue(order, toCents(order->getTotalPrice()));
+  dataVersion++;
+  publishChange(order, OrderStatus::COMPLETED, OrderStatus::COMPLETED);
+  return true;
+}
+
+void OrderManager::repriceOrder(Order *order, double previousPrice)
+{
+  // Unpaid prices show up in the margin report
+  dataVersion++;
+  if (order->getIsPaid())
+  {
+    addPaidRevenue(order, toCents(order->getTotalPrice()) - toCents(previousPrice));
+    publishChange(order, order->getStatus(), order->getStatus());
+  }
+}
+
+void OrderManager::addPaidRevenue(Order *order, long long cents)
+{
+  bool express = dynamic_cast<ExpressOrder *>(order) != nullptr;
+  paidRevenueCents += cents;
+  if (express)
+  {
+    expressRevenueCents += cents;
   }
   else
   {
-    order = new Order(record.orderID, record.completionTime, client);
+    regularRevenueCents += cents;
+  }
+
+  std::lock_guard<std::mutex> lock(dailyRevenueMutex);
+  dailyRevenue.add(order->getCompletionTime(), express, cents);
+}
+
+/**
+ * PublishChange - Push one event to the change feed
+ *
+ * The feed has a single producer, so in concurrent mode workers take turns
+ * here. Events for one order can therefore reach the feed in a different
+ * order than the transitions happened; each event carries both the old
+ * and the new status.
+ */
+void OrderManager::publishChange(Order *order, OrderStatus from, OrderStatus to)
+{
+  std::unique_lock<std::mutex> feedLock(feedMutex, std::defer_lock);
+  if (concurrentMode)
+  {
+    feedLock.lock();
   }
 
+  changeFeed.publish(OrderChangeEvent(order->getHandle(), from, to, order->getIsPaid(),
+                                      OrderChangeFeed::now()));
+}
+
+OrderChangeFeed &OrderManager::getChangeFeed()
+{
+  return changeFeed;
+}
+
+long long OrderManager::toCents(double amount)
+{
+  return std::llround(amount * 100.0);
+}
+
+Order *OrderManager::createOrderFromRecord(const OrderRecord &record, Client *client)
+{
+  Order *order = instantiateOrder(record.orderID, client, record.completionTime, record.isExpress);
+
   order->restoreStatus(intToStatus(record.status));
   order->restorePrice(record.totalPrice);
   order->restorePaidStatus(record.isPaid);
@@ -153,6 +348,10 @@ void OrderManager::syncOrderToRepository(Order *order)
   if (!repository || !order)
     return;
 
+  // The record is built under the repository lock so that the last sync of
+  // an order always carries its latest workflow state
+  auto repositoryLock = lockRepository();
+
   Client *client = order->getClient();
   OrderRecord record = createRecordFromOrder(order, client);
 
@@ -181,6 +380,8 @@ void OrderManager::loadData()
   if (!repository || !fileManager)
     return;
 
+  auto writeLock = lockIndexExclusive();
+
   // Step 1: Load from file into repository
   fileManager->loadFromFile(*repository);
 
@@ -190,31 +391,59 @@ void OrderManager::loadData()
     const OrderRecord &record = repository->getAt(i);
 
     // Find or create the client for this order
-    Client *client = findOrCreateClient(record.clientID, record.clientSurname);
+    Client *client = lookupOrCreateClient(record.clientID, record.clientSurname);
 
     // Create the Order object with restored state
     Order *order = createOrderFromRecord(record, client);
 
     // Add to our working collection
-    orders.push_back(order);
+    registerOrder(order);
   }
 
   if (display && !orders.empty())
   {
-    display->showLine("Loaded " + std::to_string(orders.size()) + " order(s) as working entities.");
+    display->log(LogLevel::INFO, "Loaded {} order(s) as working entities.", orders.size());
   }
 }
 
+/**
+ * SaveData - Rebuild the repository from the working orders and write it
+ *
+ * The rebuild and the write hold the repository lock, so no sync can land
+ * between the clear and the new records. Syncs take an order lock before
+ * the repository lock, so waiting for an order lock here could deadlock;
+ * an order whose lock is busy keeps its last synced record instead, and
+ * its owner syncs the newer state once the repository lock is free.
+ */
 void OrderManager::saveData()
 {
   if (!repository || !fileManager)
     return;
 
-  repository->clear();
+  auto readLock = lockIndexShared();
+  auto repositoryLock = lockRepository();
 
+  std::vector<OrderRecord> records;
+  records.reserve(orders.size());
   for (auto *order : orders)
   {
-    syncOrderToRepository(order);
+    std::unique_lock<std::mutex> orderLock(order->getMutex(), std::defer_lock);
+    if (concurrentMode && !orderLock.try_lock())
+    {
+      int index = repository->findIndexById(order->getOrderID());
+      if (index >= 0)
+      {
+        records.push_back(repository->getAt(index));
+      }
+      continue;
+    }
+    records.push_back(createRecordFromOrder(order, order->getClient()));
+  }
+
+  repository->clear();
+  for (const OrderRecord &record : records)
+  {
+    repository->add(record);
   }
 
   if (repository->getCount() > 0)
@@ -230,31 +459,25 @@ void OrderManager::saveData()
 Order *OrderManager::createOrder(const std::string &orderID, Client *client,
                                  const std::string &completionTime, bool isExpress)
 {
-  validateOrderCreation(orderID, client, completionTime);
-
   Order *order = nullptr;
-  if (isExpress)
+  std::unique_lock<std::mutex> orderLock;
   {
-    order = new ExpressOrder(orderID, completionTime, client, config);
-  }
-  else
-  {
-    order = new Order(orderID, completionTime, client);
-  }
+    auto writeLock = lockIndexExclusive();
+    validateOrderCreation(orderID, client, completionTime);
 
-  orders.push_back(order);
+    order = instantiateOrder(orderID, client, completionTime, isExpress);
+    registerOrder(order);
+    orderLock = lockOrder(order);
+    publishChange(order, OrderStatus::PENDING, OrderStatus::PENDING);
+  }
 
   // Sync to repository
   syncOrderToRepository(order);
 
   if (display)
   {
-    std::string msg = "Order " + orderID + " created for client " + client->getSurname();
-    if (isExpress)
-    {
-      msg += " (EXPRESS)";
-    }
-    display->showLine(msg);
+    display->log(LogLevel::INFO, "Order {} created for client {}{}",
+                 orderID, client->getSurname(), isExpress ? " (EXPRESS)" : "");
   }
 
   if (order->getStatus() != OrderStatus::PENDING)
@@ -272,8 +495,10 @@ void OrderManager::addItemToOrder(Order *order, const std::string &itemID, int q
   validateOrderExists(order);
   validateOrderItem(itemID, quantity, unitPrice);
 
-  OrderItem *item = new OrderItem(itemID, quantity, unitPrice);
-  order->addItem(item);
+  auto orderLock = lockOrder(order);
+  double previousPrice = order->getTotalPrice();
+  order->addItem(OrderItem(itemID, quantity, unitPrice));
+  repriceOrder(order, previousPrice);
 
   syncOrderToRepository(order);
 }
@@ -281,13 +506,17 @@ void OrderManager::addItemToOrder(Order *order, const std::string &itemID, int q
 void OrderManager::processOrder(Order *order)
 {
   validateOrderExists(order);
-  validateOrderStatus(order, OrderStatus::PENDING);
 
-  order->updateStatus(OrderStatus::IN_PROGRESS, display);
+  if (!advanceOrder(order, OrderStatus::PENDING, OrderStatus::IN_PROGRESS, display))
+  {
+    rejectTransition(order, OrderStatus::PENDING);
+  }
 
+  auto orderLock = lockOrder(order);
   syncOrderToRepository(order);
 
-  if (order->getStatus() != OrderStatus::IN_PROGRESS)
+  // Another worker may already have moved the order further on
+  if (order->getStatus() == OrderStatus::PENDING)
   {
     throw ValidationException(
         "Order processing failed",
@@ -298,15 +527,22 @@ void OrderManager::processOrder(Order *order)
 void OrderManager::completeOrder(Order *order)
 {
   validateOrderExists(order);
-  validateOrderStatus(order, OrderStatus::IN_PROGRESS);
 
-  order->updateStatus(OrderStatus::COMPLETED, display);
+  // Held across the transition so that a payment cannot be recorded before
+  // the final price has been calculated
+  auto orderLock = lockOrder(order);
+  if (!advanceOrder(order, OrderStatus::IN_PROGRESS, OrderStatus::COMPLETED, display))
+  {
+    rejectTransition(order, OrderStatus::IN_PROGRESS);
+  }
 
+  double previousPrice = order->getTotalPrice();
   double price = order->calculatePrice();
+  repriceOrder(order, previousPrice);
 
   if (display)
   {
-    display->showLine("Order " + order->getOrderID() + " total price: $" + std::to_string(price));
+    display->log(LogLevel::INFO, "Order {} total price: ${}", order->getOrderID(), price);
   }
 
   syncOrderToRepository(order);
@@ -332,6 +568,8 @@ void OrderManager::recordPayment(Order *order)
   validateOrderExists(order);
   validateOrderStatus(order, OrderStatus::COMPLETED);
 
+  auto orderLock = lockOrder(order);
+
   // Precondition: order must have a valid price (items may not be stored for loaded orders)
   if (order->getTotalPrice() <= 0)
   {
@@ -340,7 +578,14 @@ void OrderManager::recordPayment(Order *order)
         "Business rule violation: Payment amount must be positive");
   }
 
-  order->recordPayment(display);
+  // Precondition: order must not be paid yet (the CAS makes this race-free)
+  if (!payOrder(order, display))
+  {
+    validateOrderStatus(order, OrderStatus::COMPLETED);
+    throw BusinessRuleException(
+        "Payment already recorded for order " + order->getOrderID(),
+        "Business rule violation: duplicate payment");
+  }
 
   syncOrderToRepository(order);
 
@@ -352,78 +597,634 @@ void OrderManager::recordPayment(Order *order)
   }
 }
 
+/**
+ * ApplyBatch - Apply many order operations with a single sync
+ *
+ * 1. Validation pass: every operation is checked against the order index
+ *    and the projected state left by earlier operations of the same batch
+ * 2. Apply pass: accepted operations are executed without per-call
+ *    repository syncs or display output
+ * 3. Every touched order is synced to the repository once
+ * 4. One summary line is shown
+ *
+ * Rejected operations do not stop the batch; their result carries the
+ * same user message the single-operation API would have thrown.
+ */
+std::vector<OrderOperationResult> OrderManager::applyBatch(const std::vector<OrderOperation> &operations)
+{
+  struct ProjectedOrder
+  {
+    OrderStatus status;
+    bool hasPrice;
+    bool isPaid;
+  };
+
+  auto writeLock = lockIndexExclusive();
+
+  std::vector<OrderOperationResult> results(operations.size());
+  std::unordered_map<std::string, ProjectedOrder> projected;
+  projected.reserve(operations.size());
+
+  // Pass 1: validate against the index and the projected batch state
+  for (size_t i = 0; i < operations.size(); i++)
+  {
+    const OrderOperation &op = operations[i];
+    OrderOperationResult &result = results[i];
+
+    try
+    {
+      if (op.type == OrderOperationType::CREATE)
+      {
+        if (!op.orderID.empty() && projected.find(op.orderID) != projected.end())
+        {
+          throw DuplicateDataException(
+              "Order ID already exists: " + op.orderID,
+              "Precondition violation: duplicate orderID in batch");
+        }
+
+        Client placeholder(op.clientID, op.clientSurname);
+        ValidationResult check = checkOrderCreation(op.orderID, &placeholder, op.completionTime);
+        if (!check)
+        {
+          result.message = check.getUserMessage();
+          continue;
+        }
+
+        if (op.clientID.empty())
+        {
+          result.message = "Client information is required";
+          continue;
+        }
+
+        projected[op.orderID] = {OrderStatus::PENDING, false, false};
+        result.success = true;
+        continue;
+      }
+
+      auto it = projected.find(op.orderID);
+      if (it == projected.end())
+      {
+        Order *existing = lookupOrder(op.orderID);
+        validateOrderExists(existing);
+        auto orderLock = lockOrder(existing);
+        it = projected.emplace(op.orderID,
+                               ProjectedOrder{existing->getStatus(), existing->getTotalPrice() > 0,
+                                              existing->getIsPaid()})
+                 .first;
+      }
+      ProjectedOrder &state = it->second;
+
+      switch (op.type)
+      {
+      case OrderOperationType::ADD_ITEM:
+      {
+        ValidationResult check = tryValidateOrderItem(op.itemID, op.quantity, op.unitPrice);
+        if (!check)
+        {
+          result.message = check.getUserMessage();
+          continue;
+        }
+        if (op.quantity * op.unitPrice > 0)
+        {
+          state.hasPrice = true;
+        }
+        break;
+      }
+      case OrderOperationType::PROCESS:
+        validateProjectedStatus(state.status, OrderStatus::PENDING);
+        state.status = OrderStatus::IN_PROGRESS;
+        break;
+      case OrderOperationType::COMPLETE:
+        validateProjectedStatus(state.status, OrderStatus::IN_PROGRESS);
+        state.status = OrderStatus::COMPLETED;
+        break;
+      case OrderOperationType::RECORD_PAYMENT:
+        validateProjectedStatus(state.status, OrderStatus::COMPLETED);
+        if (!state.hasPrice)
+        {
+          throw BusinessRuleException(
+              "Cannot record payment - invalid order amount",
+              "Business rule violation: Payment amount must be positive");
+        }
+        if (state.isPaid)
+        {
+          throw BusinessRuleException(
+              "Payment already recorded for order " + op.orderID,
+              "Business rule violation: duplicate payment");
+        }
+        state.isPaid = true;
+        break;
+      case OrderOperationType::CREATE:
+        break;
+      }
+      result.success = true;
+    }
+    catch (const PhotoStudioException &e)
+    {
+      result.success = false;
+      result.message = e.getUserMessage();
+    }
+  }
+
+  // Pass 2: apply accepted operations without per-call sync or display
+  std::vector<Order *> touched;
+  std::unordered_set<Order *> touchedSet;
+  int succeeded = 0;
+
+  for (size_t i = 0; i < operations.size(); i++)
+  {
+    const OrderOperation &op = operations[i];
+    OrderOperationResult &result = results[i];
+    if (!result.success)
+    {
+      continue;
+    }
+
+    try
+    {
+      Order *order = nullptr;
+      if (op.type == OrderOperationType::CREATE)
+      {
+        Client *client = lookupOrCreateClient(op.clientID, op.clientSurname);
+        order = instantiateOrder(op.orderID, client, op.completionTime, op.isExpress);
+        registerOrder(order);
+        publishChange(order, OrderStatus::PENDING, OrderStatus::PENDING);
+      }
+      else
+      {
+        order = lookupOrder(op.orderID);
+      }
+
+      auto orderLock = lockOrder(order);
+      switch (op.type)
+      {
+      case OrderOperationType::CREATE:
+        break;
+      case OrderOperationType::ADD_ITEM:
+      {
+        double previousPrice = order->getTotalPrice();
+        order->addItem(OrderItem(op.itemID, op.quantity, op.unitPrice));
+        repriceOrder(order, previousPrice);
+        break;
+      }
+      case OrderOperationType::PROCESS:
+        if (!advanceOrder(order, OrderStatus::PENDING, OrderStatus::IN_PROGRESS, nullptr))
+        {
+          rejectTransition(order, OrderStatus::PENDING);
+        }
+        break;
+      case OrderOperationType::COMPLETE:
+      {
+        if (!advanceOrder(order, OrderStatus::IN_PROGRESS, OrderStatus::COMPLETED, nullptr))
+        {
+          rejectTransition(order, OrderStatus::IN_PROGRESS);
+        }
+        double previousPrice = order->getTotalPrice();
+        order->calculatePrice();
+        repriceOrder(order, previousPrice);
+        break;
+      }
+      case OrderOperationType::RECORD_PAYMENT:
+        if (!payOrder(order, nullptr))
+        {
+          validateOrderStatus(order, OrderStatus::COMPLETED);
+          throw BusinessRuleException(
+              "Payment already recorded for order " + order->getOrderID(),
+              "Business rule violation: duplicate payment");
+        }
+        break;
+      }
+
+      result.order = order;
+      succeeded++;
+      if (touchedSet.insert(order).second)
+      {
+        touched.push_back(order);
+      }
+    }
+    catch (const PhotoStudioException &e)
+    {
+      result.success = false;
+      result.message = e.getUserMessage();
+    }
+  }
+
+  if (writeLock.owns_lock())
+  {
+    writeLock.unlock();
+  }
+
+  // Pass 3: one repository sync per touched order
+  for (auto *order : touched)
+  {
+    auto orderLock = lockOrder(order);
+    syncOrderToRepository(order);
+  }
+
+  if (display)
+  {
+    int failed = static_cast<int>(operations.size()) - succeeded;
+    display->log(LogLevel::INFO, "Batch applied: {} of {} operation(s) succeeded, {} rejected, {} order(s) synced.",
+                 succeeded, operations.size(), failed, touched.size());
+  }
+
+  return results;
+}
+
+/**
+ * ProcessBacklog - Catch up on queued orders in parallel
+ *
+ * Does what main does for each loaded order, for all of them at once:
+ * - PENDING orders are processed
+ * - IN_PROGRESS orders are completed and, if unpaid with a positive
+ *   price, paid
+ *
+ * The queued orders are split into chunks that are spread over the
+ * per-worker deques of a WorkStealingPool; idle workers steal chunks from
+ * busy ones. Workers skip per-order syncs and display output. When all
+ * chunks are done, every touched order is synced once and a single
+ * summary line is shown. Concurrent mode is switched on for the duration.
+ */
+BacklogResult OrderManager::processBacklog(unsigned threadCount)
+{
+  std::vector<Order *> queued;
+  {
+    auto readLock = lockIndexShared();
+    for (auto *order : orders)
+    {
+      OrderStatus status = order->getStatus();
+      if (status == OrderStatus::PENDING || status == OrderStatus::IN_PROGRESS)
+      {
+        queued.push_back(order);
+      }
+    }
+  }
+
+  BacklogResult result;
+  if (queued.empty())
+  {
+    return result;
+  }
+
+  // Switched back when this returns or throws
+  struct ConcurrentModeScope
+  {
+    std::atomic<bool> &mode;
+    bool previous;
+    ~ConcurrentModeScope() { mode.store(previous); }
+  } modeScope{concurrentMode, concurrentMode.exchange(true)};
+
+  std::atomic<int> processed(0);
+  std::atomic<int> completed(0);
+  std::atomic<int> paid(0);
+  std::atomic<int> failed(0);
+
+  {
+    WorkStealingPool pool(threadCount);
+    result.threadCount = pool.getThreadCount();
+
+    // Several chunks per worker so that stealing can balance uneven work
+    std::size_t chunkSize = queued.size() / (pool.getThreadCount() * 8);
+    if (chunkSize == 0)
+    {
+      chunkSize = 1;
+    }
+
+    for (std::size_t begin = 0; begin < queued.size(); begin += chunkSize)
+    {
+      std::size_t end = std::min(begin + chunkSize, queued.size());
+      pool.submit([this, &queued, begin, end, &processed, &completed, &paid, &failed]()
+                  {
+        BacklogResult tally;
+        auto addTally = [&]()
+        {
+          processed += tally.processed;
+          completed += tally.completed;
+          paid += tally.paid;
+          failed += tally.failed;
+        };
+        try
+        {
+          for (std::size_t i = begin; i < end; i++)
+          {
+            advanceQueuedOrder(queued[i], tally);
+          }
+        }
+        catch (...)
+        {
+          // Keep what the chunk got done; the pool counts the failed task
+          addTally();
+          throw;
+        }
+        addTally(); });
+    }
+
+    pool.waitIdle();
+    result.steals = pool.getStealCount();
+    result.failedTasks = pool.getFailedTaskCount();
+  }
+
+  // One batched sync pass for everything the workers touched
+  for (auto *order : queued)
+  {
+    auto orderLock = lockOrder(order);
+    syncOrderToRepository(order);
+  }
+
+  result.processed = processed.load();
+  result.completed = completed.load();
+  result.paid = paid.load();
+  result.failed = failed.load();
+
+  if (display)
+  {
+    display->log(LogLevel::INFO, "Backlog: {} order(s) on {} thread(s) - {} processed, {} completed, {} paid, {} failed.",
+                 queued.size(), result.threadCount, result.processed, result.completed,
+                 result.paid, result.failed);
+    if (result.failedTasks > 0)
+    {
+      display->log(LogLevel::ERROR, "Backlog: {} chunk(s) aborted; their remaining orders stay queued.",
+                   result.failedTasks);
+    }
+  }
+
+  return result;
+}
+
+void OrderManager::advanceQueuedOrder(Order *order, BacklogResult &tally)
+{
+  OrderStatus status = order->getStatus();
+
+  if (status == OrderStatus::PENDING)
+  {
+    if (advanceOrder(order, OrderStatus::PENDING, OrderStatus::IN_PROGRESS, nullptr))
+    {
+      tally.processed++;
+    }
+    else
+    {
+      tally.failed++;
+    }
+    return;
+  }
+
+  if (status == OrderStatus::IN_PROGRESS)
+  {
+    auto orderLock = lockOrder(order);
+    if (!advanceOrder(order, OrderStatus::IN_PROGRESS, OrderStatus::COMPLETED, nullptr))
+    {
+      tally.failed++;
+      return;
+    }
+    tally.completed++;
+
+    double previousPrice = order->getTotalPrice();
+    order->calculatePrice();
+    repriceOrder(order, previousPrice);
+
+    if (!order->getIsPaid() && order->getTotalPrice() > 0)
+    {
+      if (payOrder(order, nullptr))
+      {
+        tally.paid++;
+      }
+      else
+      {
+        tally.failed++;
+      }
+    }
+  }
+}
+
 const std::vector<Order *> &OrderManager::getAllOrders() const
 {
   return orders;
 }
 
+std::shared_lock<std::shared_mutex> OrderManager::lockOrdersShared() const
+{
+  return lockIndexShared();
+}
+
 double OrderManager::calculateTotalRevenue() const
 {
-  double total = 0.0;
+  if (aggregateVerification)
+  {
+    verifyAggregates();
+  }
+  return paidRevenueCents.load() / 100.0;
+}
+
+double OrderManager::getExpressRevenue() const
+{
+  if (aggregateVerification)
+  {
+    verifyAggregates();
+  }
+  return expressRevenueCents.load() / 100.0;
+}
+
+double OrderManager::getRegularRevenue() const
+{
+  if (aggregateVerification)
+  {
+    verifyAggregates();
+  }
+  return regularRevenueCents.load() / 100.0;
+}
+
+int OrderManager::getOrderCountByStatus(OrderStatus status) const
+{
+  if (aggregateVerification)
+  {
+    verifyAggregates();
+  }
+  return statusCounts[statusToInt(status)].load();
+}
+
+std::uint64_t OrderManager::getDataVersion() const
+{
+  return dataVersion.load();
+}
+
+DailyRevenue OrderManager::getRevenueBetween(std::int32_t firstDay, std::int32_t endDay) const
+{
+  std::lock_guard<std::mutex> lock(dailyRevenueMutex);
+  return dailyRevenue.getRange(firstDay, endDay);
+}
+
+std::vector<DailyRevenue> OrderManager::getDailyRevenue(std::int32_t firstDay, std::int32_t endDay) const
+{
+  std::lock_guard<std::mutex> lock(dailyRevenueMutex);
+  return dailyRevenue.getDays(firstDay, endDay);
+}
+
+DailyRevenue OrderManager::getUndatedRevenue() const
+{
+  std::lock_guard<std::mutex> lock(dailyRevenueMutex);
+  return dailyRevenue.getUndated();
+}
+
+void OrderManager::enableAggregateVerification()
+{
+  aggregateVerification = true;
+}
+
+/**
+ * VerifyAggregates - Debug cross-check of the running aggregates
+ *
+ * Recomputes every aggregate with a full scan of the orders and throws
+ * ValidationException if any running value differs. This is O(n) and is
+ * only meant for debugging (see enableAggregateVerification).
+ */
+void OrderManager::verifyAggregates() const
+{
+  auto readLock = lockIndexShared();
+
+  long long scannedTotal = 0;
+  long long scannedExpress = 0;
+  long long scannedRegular = 0;
+  int scannedCounts[STATUS_COUNT] = {0, 0, 0, 0};
+
   for (const auto &order : orders)
   {
+    auto orderLock = lockOrder(order);
+    scannedCounts[statusToInt(order->getStatus())]++;
     if (order->getIsPaid())
     {
-      total += order->getTotalPrice();
+      long long cents = toCents(order->getTotalPrice());
+      scannedTotal += cents;
+      if (dynamic_cast<ExpressOrder *>(order) != nullptr)
+      {
+        scannedExpress += cents;
+      }
+      else
+      {
+        scannedRegular += cents;
+      }
     }
   }
-  return total;
-}
 
-void OrderManager::validateOrderCreation(const std::string &orderID, Client *client,
-                                         const std::string &completionTime) const
-{
-  if (orderID.empty())
+  if (scannedTotal != paidRevenueCents.load() ||
+      scannedExpress != expressRevenueCents.load() ||
+      scannedRegular != regularRevenueCents.load())
   {
-    throw InvalidDataException(
-        "Order ID cannot be empty",
-        "Precondition violation: orderID.empty()");
+    throw ValidationException(
+        "Revenue aggregates are inconsistent",
+        "Aggregate check failed: running total = " + std::to_string(paidRevenueCents.load()) +
+            " cents, scanned total = " + std::to_string(scannedTotal) + " cents");
   }
 
-  if (isOrderIDDuplicate(orderID))
+  long long indexedTotal;
   {
-    throw DuplicateDataException(
-        "Order ID already exists: " + orderID,
-        "Precondition violation: duplicate orderID");
+    std::lock_guard<std::mutex> lock(dailyRevenueMutex);
+    indexedTotal = dailyRevenue.getTotalCents();
   }
-
-  if (client == nullptr)
+  if (indexedTotal != scannedTotal)
   {
-    throw InvalidDataException(
-        "Client information is required",
-        "Precondition violation: client == nullptr");
+    throw ValidationException(
+        "Daily revenue index is inconsistent",
+        "Aggregate check failed: indexed total = " + std::to_string(indexedTotal) +
+            " cents, scanned total = " + std::to_string(scannedTotal) + " cents");
   }
 
-  if (completionTime.empty())
+  for (int i = 0; i < STATUS_COUNT; i++)
   {
-    throw InvalidDataException(
-        "Completion time is required",
-        "Precondition violation: completionTime.empty()");
+    if (scannedCounts[i] != statusCounts[i].load())
+    {
+      throw ValidationException(
+          "Order status counts are inconsistent",
+          "Aggregate check failed for status " + std::to_string(i) + ": running = " +
+              std::to_string(statusCounts[i].load()) + ", scanned = " + std::to_string(scannedCounts[i]));
+    }
   }
 }
 
-void OrderManager::validateOrderItem(const std::string &itemID, int quantity, double unitPrice) const
+ValidationResult OrderManager::tryValidateOrderCreation(const std::string &orderID, const Client *client,
+                                                        const std::string &completionTime) const
+{
+  auto readLock = lockIndexShared();
+  return checkOrderCreation(orderID, client, completionTime);
+}
+
+ValidationResult OrderManager::tryValidateOrderItem(const std::string &itemID, int quantity,
+                                                    double unitPrice) const
 {
   if (itemID.empty())
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Item ID cannot be empty",
         "Precondition violation: itemID.empty()");
   }
 
   if (quantity <= 0)
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Quantity must be greater than zero",
         "Precondition violation: quantity <= 0");
   }
 
   if (unitPrice < 0)
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Unit price cannot be negative",
         "Precondition violation: unitPrice < 0");
   }
+
+  return ValidationResult::ok();
+}
+
+ValidationResult OrderManager::checkOrderCreation(const std::string &orderID, const Client *client,
+                                                  const std::string &completionTime) const
+{
+  if (orderID.empty())
+  {
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
+        "Order ID cannot be empty",
+        "Precondition violation: orderID.empty()");
+  }
+
+  if (isOrderIDDuplicate(orderID))
+  {
+    return ValidationResult::failure(
+        ErrorCode::DUPLICATE,
+        "Order ID already exists: ",
+        "Precondition violation: duplicate orderID",
+        orderID);
+  }
+
+  if (client == nullptr)
+  {
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
+        "Client information is required",
+        "Precondition violation: client == nullptr");
+  }
+
+  if (completionTime.empty())
+  {
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
+        "Completion time is required",
+        "Precondition violation: completionTime.empty()");
+  }
+
+  return ValidationResult::ok();
+}
+
+void OrderManager::validateOrderCreation(const std::string &orderID, Client *client,
+                                         const std::string &completionTime) const
+{
+  checkOrderCreation(orderID, client, completionTime).throwIfError();
+}
+
+void OrderManager::validateOrderItem(const std::string &itemID, int quantity, double unitPrice) const
+{
+  tryValidateOrderItem(itemID, quantity, unitPrice).throwIfError();
 }
 
 void OrderManager::validateOrderExists(Order *order) const
@@ -438,7 +1239,27 @@ void OrderManager::validateOrderExists(Order *order) const
 
 void OrderManager::validateOrderStatus(Order *order, OrderStatus expectedStatus) const
 {
-  if (order->getStatus() != expectedStatus)
+  validateProjectedStatus(order->getStatus(), expectedStatus);
+}
+
+/**
+ * RejectTransition - Report a failed compare-and-swap transition
+ *
+ * Throws the same exception validateOrderStatus would for the state the
+ * order is in now. Status only moves forward, so the order can no longer be
+ * in 'expectedStatus'; the fallback covers it anyway.
+ */
+void OrderManager::rejectTransition(Order *order, OrderStatus expectedStatus) const
+{
+  validateOrderStatus(order, expectedStatus);
+  throw BusinessRuleException(
+      "Order status changed concurrently",
+      "Compare-and-swap transition lost to another worker");
+}
+
+void OrderManager::validateProjectedStatus(OrderStatus actualStatus, OrderStatus expectedStatus) const
+{
+  if (actualStatus != expectedStatus)
   {
     std::string expectedStr;
     switch (expectedStatus)
@@ -465,12 +1286,5 @@ void OrderManager::validateOrderStatus(Order *order, OrderStatus expectedStatus)
 
 bool OrderManager::isOrderIDDuplicate(const std::string &orderID) const
 {
-  for (const auto &order : orders)
-  {
-    if (order->getOrderID() == orderID)
-    {
-      return true;
-    }
-  }
-  return false;
+  return orderIndex.find(orderID) != orderIndex.end();
 }
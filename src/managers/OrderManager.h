@@ -3,22 +3,45 @@
 
 #include <vector>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
 #include "orders/Order.h"
 #include "entities/Client.h"
 #include "entities/Service.h"
 #include "interfaces/IDisplay.h"
 #include "config/Config.h"
 #include "exceptions/PhotoStudioExceptions.h"
+#include "types/ValidationResult.h"
 #include "repository/OrderRepository.h"
 #include "repository/OrderRecord.h"
 #include "repository/FileManager.h"
+#include "managers/OrderOperation.h"
+#include "managers/DailyRevenueIndex.h"
+#include "events/OrderChangeFeed.h"
 
-
+/**
+ * OrderManager - Owns working orders and clients and drives the order workflow
+ *
+ * By default the manager is single-threaded. After enableConcurrentMode():
+ * - the order/client collections and indexes are guarded by a reader-writer lock
+ * - workflow transitions are lock-free compare-and-swap operations on the
+ *   order's state word; pricing and syncing lock only the affected order
+ * - repository syncs are serialized by a separate lock
+ * Locks are always taken in the order: index -> order -> repository
+ * (saveData only try-locks orders while it holds the repository lock).
+ * getAllOrders()/getAllClients() return the live collections and must not be
+ * iterated while other threads create orders, unless lockOrdersShared() is held.
+ */
 class OrderManager
 {
 private:
   std::vector<Order *> orders;   // In-memory working orders
   std::vector<Client *> clients; // In-memory clients (created from loaded records)
+  std::unordered_map<std::string, Order *> orderIndex;   // orderID -> order
+  std::unordered_map<std::string, Client *> clientIndex; // clientID -> client
   const IDisplay *display;
   const Config *config;
 
@@ -26,6 +49,28 @@ private:
   OrderRepository *repository;
   FileManager *fileManager;
 
+  // Concurrent mode
+  std::atomic<bool> concurrentMode;
+  mutable std::shared_mutex indexMutex; // Guards orders, clients and their indexes
+  std::mutex repositoryMutex;           // Guards repository syncs
+
+  // Running aggregates, kept up to date by every workflow step
+  static const int STATUS_COUNT = 4;
+  std::atomic<long long> paidRevenueCents;
+  std::atomic<long long> expressRevenueCents;
+  std::atomic<long long> regularRevenueCents;
+  std::atomic<int> statusCounts[STATUS_COUNT];
+  std::atomic<std::uint64_t> dataVersion; // Bumped on every change a report can see
+  bool aggregateVerification; // Cross-check aggregates against a full scan on every query
+
+  // Paid revenue by completion date, moved together with the totals above
+  DailyRevenueIndex dailyRevenue;
+  mutable std::mutex dailyRevenueMutex;
+
+  // Status change feed; producers are serialized by feedMutex in concurrent mode
+  OrderChangeFeed changeFeed;
+  std::mutex feedMutex;
+
 public:
   OrderManager(const IDisplay *disp, const Config *cfg);
   ~OrderManager();
@@ -35,6 +80,10 @@ public:
   void setFileManager(FileManager *fm);
   OrderRepository *getRepository();
 
+  // Must be called before worker threads start using the manager
+  void enableConcurrentMode();
+  bool isConcurrentMode() const;
+
   // Release 4: Data persistence methods
   void loadData();                                                 // Load from file and create entities
   void saveData();                                                 // Save all entities to file
@@ -47,26 +96,92 @@ public:
   void completeOrder(Order *order);
   void recordPayment(Order *order);
 
+  // Applies all operations with one repository sync and one summary line
+  std::vector<OrderOperationResult> applyBatch(const std::vector<OrderOperation> &operations);
+
+  // Advances every queued order one step on a work-stealing thread pool
+  // (0 threads = one per core) with one batched repository sync
+  BacklogResult processBacklog(unsigned threadCount = 0);
+
+  // Moves one queued order a step on (see processBacklog) without syncing it
+  // or showing output; needs concurrent mode when called from several threads
+  void advanceQueuedOrder(Order *order, BacklogResult &tally);
+
+  // Non-throwing checks for bulk paths; createOrder / addItemToOrder throw
+  // the same failures as exceptions
+  ValidationResult tryValidateOrderCreation(const std::string &orderID, const Client *client,
+                                            const std::string &completionTime) const;
+  ValidationResult tryValidateOrderItem(const std::string &itemID, int quantity, double unitPrice) const;
+
   // Release 4: Methods to work with loaded entities
   Order *findOrderById(const std::string &orderID);
+  Order *findOrderByHandle(std::uint32_t handle) const;
   Client *findOrCreateClient(const std::string &clientID, const std::string &surname);
   int getLoadedOrderCount() const;
 
   const std::vector<Order *> &getAllOrders() const;
   const std::vector<Client *> &getAllClients() const;
+  // Holds off order creation and loading while the caller scans getAllOrders()
+  std::shared_lock<std::shared_mutex> lockOrdersShared() const;
+
+  // O(1) queries served from the running aggregates
   double calculateTotalRevenue() const;
+  double getExpressRevenue() const;
+  double getRegularRevenue() const;
+  int getOrderCountByStatus(OrderStatus status) const;
+
+  // Paid revenue of orders due on firstDay <= day < endDay (see
+  // DailyRevenueIndex for day numbers); read from per-day buckets
+  DailyRevenue getRevenueBetween(std::int32_t firstDay, std::int32_t endDay) const;
+  std::vector<DailyRevenue> getDailyRevenue(std::int32_t firstDay, std::int32_t endDay) const;
+  DailyRevenue getUndatedRevenue() const;
+
+  // Increases whenever an order is added, moves, is paid or is repriced
+  std::uint64_t getDataVersion() const;
+
+  // Debug mode: every aggregate query is cross-checked against a full scan
+  void enableAggregateVerification();
+  void verifyAggregates() const;
+
+  // Status and payment changes for downstream consumers (see OrderChangeFeed)
+  OrderChangeFeed &getChangeFeed();
 
 private:
+  ValidationResult checkOrderCreation(const std::string &orderID, const Client *client,
+                                      const std::string &completionTime) const; // Caller holds the index lock
   void validateOrderCreation(const std::string &orderID, Client *client, const std::string &completionTime) const;
   void validateOrderItem(const std::string &itemID, int quantity, double unitPrice) const;
   void validateOrderExists(Order *order) const;
   void validateOrderStatus(Order *order, OrderStatus expectedStatus) const;
+  void validateProjectedStatus(OrderStatus actualStatus, OrderStatus expectedStatus) const;
+  [[noreturn]] void rejectTransition(Order *order, OrderStatus expectedStatus) const;
   bool isOrderIDDuplicate(const std::string &orderID) const;
 
   int statusToInt(OrderStatus status) const;
   OrderStatus intToStatus(int status) const;
 
+  // Concurrent mode: locks own their mutex only when concurrentMode is set
+  std::shared_lock<std::shared_mutex> lockIndexShared() const;
+  std::unique_lock<std::shared_mutex> lockIndexExclusive() const;
+  std::unique_lock<std::mutex> lockOrder(const Order *order) const;
+  std::unique_lock<std::mutex> lockRepository();
+
+  // Index lookups; callers hold the index lock
+  Order *lookupOrder(const std::string &orderID) const;
+  Client *lookupOrCreateClient(const std::string &clientID, const std::string &surname);
+
   Order *createOrderFromRecord(const OrderRecord &record, Client *client);
+  Order *instantiateOrder(const std::string &orderID, Client *client,
+                          const std::string &completionTime, bool isExpress);
+  void registerOrder(Order *order);
+
+  // Workflow steps that keep the running aggregates in sync
+  bool advanceOrder(Order *order, OrderStatus from, OrderStatus to, const IDisplay *notify);
+  bool payOrder(Order *order, const IDisplay *notify);
+  void repriceOrder(Order *order, double previousPrice);
+  void addPaidRevenue(Order *order, long long cents);
+  void publishChange(Order *order, OrderStatus from, OrderStatus to);
+  static long long toCents(double amount);
 };
 
 #endif // ORDER_MANAGER_H
@@ -0,0 +1,132 @@
+#ifndef ORDER_OPERATION_H
+#define ORDER_OPERATION_H
+
+#include <string>
+
+class Order;
+
+enum class OrderOperationType
+{
+  CREATE,
+  ADD_ITEM,
+  PROCESS,
+  COMPLETE,
+  RECORD_PAYMENT
+};
+
+/**
+ * OrderOperation - One step of a batch submitted to OrderManager::applyBatch
+ *
+ * Orders are referenced by ID so that a batch can create an order and
+ * continue working with it in later operations of the same batch.
+ * Only the fields relevant to the operation type are used:
+ * - CREATE:   orderID, clientID, clientSurname, completionTime, isExpress
+ * - ADD_ITEM: orderID, itemID, quantity, unitPrice
+ * - PROCESS / COMPLETE / RECORD_PAYMENT: orderID
+ */
+struct OrderOperation
+{
+  OrderOperationType type;
+  std::string orderID;
+  std::string clientID;
+  std::string clientSurname;
+  std::string completionTime;
+  bool isExpress;
+  std::string itemID;
+  int quantity;
+  double unitPrice;
+
+  OrderOperation()
+      : type(OrderOperationType::CREATE), isExpress(false), quantity(0), unitPrice(0.0) {}
+
+  static OrderOperation create(const std::string &oID, const std::string &cID,
+                               const std::string &surname, const std::string &cTime,
+                               bool express)
+  {
+    OrderOperation op;
+    op.type = OrderOperationType::CREATE;
+    op.orderID = oID;
+    op.clientID = cID;
+    op.clientSurname = surname;
+    op.completionTime = cTime;
+    op.isExpress = express;
+    return op;
+  }
+
+  static OrderOperation addItem(const std::string &oID, const std::string &iID,
+                                int qty, double price)
+  {
+    OrderOperation op;
+    op.type = OrderOperationType::ADD_ITEM;
+    op.orderID = oID;
+    op.itemID = iID;
+    op.quantity = qty;
+    op.unitPrice = price;
+    return op;
+  }
+
+  static OrderOperation process(const std::string &oID)
+  {
+    OrderOperation op;
+    op.type = OrderOperationType::PROCESS;
+    op.orderID = oID;
+    return op;
+  }
+
+  static OrderOperation complete(const std::string &oID)
+  {
+    OrderOperation op;
+    op.type = OrderOperationType::COMPLETE;
+    op.orderID = oID;
+    return op;
+  }
+
+  static OrderOperation recordPayment(const std::string &oID)
+  {
+    OrderOperation op;
+    op.type = OrderOperationType::RECORD_PAYMENT;
+    op.orderID = oID;
+    return op;
+  }
+};
+
+/**
+ * OrderOperationResult - Outcome of one OrderOperation in a batch
+ *
+ * order points to the affected order when the operation succeeded.
+ * message holds the user-facing reason when it was rejected.
+ */
+struct OrderOperationResult
+{
+  bool success;
+  Order *order;
+  std::string message;
+
+  OrderOperationResult() : success(false), order(nullptr), message("") {}
+};
+
+/**
+ * BacklogResult - Summary of OrderManager::processBacklog
+ *
+ * processed: PENDING -> IN_PROGRESS transitions
+ * completed: IN_PROGRESS -> COMPLETED transitions
+ * paid:      payments recorded for freshly completed orders
+ * failed:    transitions lost to another worker or rejected
+ * failedTasks: worker chunks that threw; the rest of such a chunk stays
+ *              queued for the next run
+ */
+struct BacklogResult
+{
+  int processed;
+  int completed;
+  int paid;
+  int failed;
+  unsigned threadCount;
+  unsigned long long steals;
+  unsigned long long failedTasks;
+
+  BacklogResult()
+      : processed(0), completed(0), paid(0), failed(0), threadCount(0), steals(0), failedTasks(0) {}
+};
+
+#endif // ORDER_OPERATION_H
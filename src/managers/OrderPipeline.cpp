@@ -0,0 +1,300 @@
+#include "managers/OrderPipeline.h"
+#include "managers/OrderManager.h"
+#include "exceptions/PhotoStudioExceptions.h"
+#include <iomanip>
+#include <sstream>
+
+OrderPipeline::OrderPipeline(OrderManager *manager, const IDisplay *disp, unsigned computeThreads)
+    : orderManager(manager), display(disp), completedCount(0), failedCount(0),
+      inFlight(0), computeExecutor(computeThreads), ioExecutor(1)
+{
+  if (!orderManager)
+  {
+    throw InvalidDataException(
+        "Order pipeline needs an order manager",
+        "Precondition violation: manager == nullptr");
+  }
+
+  for (auto &stage : stages)
+  {
+    stage.count.store(0);
+    stage.totalNanos.store(0);
+    stage.maxNanos.store(0);
+  }
+
+  orderManager->enableConcurrentMode();
+}
+
+OrderPipeline::~OrderPipeline()
+{
+  drain();
+}
+
+void OrderPipeline::setPersistStep(PersistStep step)
+{
+  persistStep = std::move(step);
+}
+
+void OrderPipeline::submit(Order *order)
+{
+  {
+    std::lock_guard<std::mutex> lock(inFlightMutex);
+    inFlight++;
+  }
+  run(order);
+}
+
+void OrderPipeline::drain()
+{
+  std::unique_lock<std::mutex> lock(inFlightMutex);
+  inFlightDone.wait(lock, [this]()
+                    { return inFlight == 0; });
+}
+
+/**
+ * Run - One order's trip through the pipeline
+ *
+ * The coroutine starts on the submitting thread and immediately moves to
+ * the compute executor. A rejected order skips pricing and persistence but
+ * still reaches the notify stage so its failure is reported in order.
+ */
+OrderPipeline::Task OrderPipeline::run(Order *order)
+{
+  bool succeeded = true;
+  std::string failure;
+  std::string orderID = order ? order->getOrderID() : "(none)";
+
+  Clock::time_point requested = Clock::now();
+  co_await ScheduleOn{computeExecutor};
+  try
+  {
+    if (!order)
+    {
+      throw DataNotFoundException("Order not found", "Pipeline received a null order");
+    }
+    OrderStatus status = order->getStatus();
+    if (status != OrderStatus::PENDING && status != OrderStatus::IN_PROGRESS)
+    {
+      throw BusinessRuleException(
+          "Order " + orderID + " is not waiting to be processed",
+          "Pipeline rejected order in status " + std::string(statusName(status)));
+    }
+  }
+  catch (const PhotoStudioException &e)
+  {
+    succeeded = false;
+    failure = e.getUserMessage();
+  }
+  recordStage(PipelineStage::VALIDATE, requested);
+
+  if (succeeded)
+  {
+    requested = Clock::now();
+    co_await ScheduleOn{computeExecutor};
+    BacklogResult tally;
+    try
+    {
+      orderManager->advanceQueuedOrder(order, tally);
+    }
+    catch (const PhotoStudioException &e)
+    {
+      tally.failed++;
+      failure = e.getUserMessage();
+    }
+    if (tally.failed > 0)
+    {
+      succeeded = false;
+      if (failure.empty())
+      {
+        failure = "Order " + orderID + " was changed by another operation";
+      }
+    }
+    recordStage(PipelineStage::PRICE, requested);
+  }
+
+  requested = Clock::now();
+  co_await ScheduleOn{ioExecutor};
+  if (succeeded)
+  {
+    try
+    {
+      std::lock_guard<std::mutex> orderLock(order->getMutex());
+      if (persistStep)
+      {
+        persistStep(order);
+      }
+      else
+      {
+        orderManager->syncOrderToRepository(order);
+      }
+    }
+    catch (const PhotoStudioException &e)
+    {
+      succeeded = false;
+      failure = e.getUserMessage();
+    }
+    catch (const std::exception &e)
+    {
+      succeeded = false;
+      failure = "Order " + orderID + " could not be saved: " + e.what();
+    }
+    recordStage(PipelineStage::PERSIST, requested);
+    requested = Clock::now();
+  }
+
+  // Already on the I/O thread, so the notify stage needs no further hop
+  if (display)
+  {
+    if (succeeded)
+    {
+      std::ostringstream line;
+      line << "Order " << orderID << " -> " << statusName(order->getStatus())
+           << " ($" << std::fixed << std::setprecision(2) << order->getTotalPrice()
+           << (order->getIsPaid() ? ", paid)" : ")");
+      display->showLine(line.str());
+    }
+    else
+    {
+      display->showLine("Pipeline skipped order: " + failure);
+    }
+  }
+  recordStage(PipelineStage::NOTIFY, requested);
+
+  finish(succeeded);
+}
+
+void OrderPipeline::recordStage(PipelineStage stage, Clock::time_point requested)
+{
+  std::uint64_t elapsed = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - requested).count());
+
+  StageCounters &counters = stages[static_cast<int>(stage)];
+  counters.count.fetch_add(1, std::memory_order_relaxed);
+  counters.totalNanos.fetch_add(elapsed, std::memory_order_relaxed);
+
+  std::uint64_t currentMax = counters.maxNanos.load(std::memory_order_relaxed);
+  while (elapsed > currentMax &&
+         !counters.maxNanos.compare_exchange_weak(currentMax, elapsed, std::memory_order_relaxed))
+  {
+  }
+}
+
+void OrderPipeline::finish(bool succeeded)
+{
+  if (succeeded)
+  {
+    completedCount++;
+  }
+  else
+  {
+    failedCount++;
+  }
+
+  // Last access to the pipeline: drain() may return as soon as the lock is released
+  std::lock_guard<std::mutex> lock(inFlightMutex);
+  if (--inFlight == 0)
+  {
+    inFlightDone.notify_all();
+  }
+}
+
+/**
+ * Abandon - Count an order whose coroutine ended with an exception
+ *
+ * Called from the coroutine's unhandled_exception(), so the order still
+ * leaves the pipeline and drain() cannot wait for it forever.
+ */
+void OrderPipeline::abandon(std::exception_ptr error)
+{
+  {
+    std::lock_guard<std::mutex> lock(inFlightMutex);
+    if (!unexpectedError)
+    {
+      unexpectedError = error;
+    }
+  }
+  finish(false);
+}
+
+std::exception_ptr OrderPipeline::getUnexpectedError()
+{
+  std::lock_guard<std::mutex> lock(inFlightMutex);
+  return unexpectedError;
+}
+
+StageLatency OrderPipeline::getStageLatency(PipelineStage stage) const
+{
+  const StageCounters &counters = stages[static_cast<int>(stage)];
+  StageLatency latency;
+  latency.count = counters.count.load();
+  if (latency.count > 0)
+  {
+    latency.averageMicros = counters.totalNanos.load() / 1000.0 / latency.count;
+    latency.maxMicros = counters.maxNanos.load() / 1000.0;
+  }
+  return latency;
+}
+
+int OrderPipeline::getCompletedCount() const
+{
+  return completedCount.load();
+}
+
+int OrderPipeline::getFailedCount() const
+{
+  return failedCount.load();
+}
+
+void OrderPipeline::showLatencyReport() const
+{
+  if (!display)
+    return;
+
+  display->showLine("Pipeline: " + std::to_string(getCompletedCount()) + " completed, " +
+                    std::to_string(getFailedCount()) + " failed.");
+  for (int i = 0; i < STAGE_COUNT; i++)
+  {
+    PipelineStage stage = static_cast<PipelineStage>(i);
+    StageLatency latency = getStageLatency(stage);
+
+    std::ostringstream line;
+    line << "  " << std::left << std::setw(9) << stageName(stage) << std::right
+         << latency.count << " run(s), avg " << std::fixed << std::setprecision(1)
+         << latency.averageMicros << " us, max " << latency.maxMicros << " us";
+    display->showLine(line.str());
+  }
+}
+
+const char *OrderPipeline::stageName(PipelineStage stage)
+{
+  switch (stage)
+  {
+  case PipelineStage::VALIDATE:
+    return "validate";
+  case PipelineStage::PRICE:
+    return "price";
+  case PipelineStage::PERSIST:
+    return "persist";
+  case PipelineStage::NOTIFY:
+    return "notify";
+  default:
+    return "unknown";
+  }
+}
+
+const char *OrderPipeline::statusName(OrderStatus status)
+{
+  switch (status)
+  {
+  case OrderStatus::PENDING:
+    return "PENDING";
+  case OrderStatus::IN_PROGRESS:
+    return "IN_PROGRESS";
+  case OrderStatus::COMPLETED:
+    return "COMPLETED";
+  case OrderStatus::CANCELLED:
+    return "CANCELLED";
+  default:
+    return "UNKNOWN";
+  }
+}
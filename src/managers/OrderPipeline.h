@@ -0,0 +1,163 @@
+#ifndef ORDER_PIPELINE_H
+#define ORDER_PIPELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include "concurrency/WorkStealingPool.h"
+#include "interfaces/IDisplay.h"
+#include "orders/Order.h"
+
+class OrderManager;
+
+/**
+ * PipelineStage - Stages every order passes through in OrderPipeline
+ */
+enum class PipelineStage
+{
+  VALIDATE,
+  PRICE,
+  PERSIST,
+  NOTIFY
+};
+
+/**
+ * StageLatency - Latency figures for one pipeline stage
+ *
+ * Latency runs from the moment an order asks for the stage (including the
+ * wait for an executor thread) until the stage is done.
+ */
+struct StageLatency
+{
+  std::uint64_t count;
+  double averageMicros;
+  double maxMicros;
+
+  StageLatency() : count(0), averageMicros(0.0), maxMicros(0.0) {}
+};
+
+/**
+ * OrderPipeline - Coroutine-based asynchronous order lifecycle
+ *
+ * Each submitted order runs as a C++20 coroutine through four stages:
+ * - validate: the order exists and is still queued (compute executor)
+ * - price:    the order is advanced one step and priced (compute executor)
+ * - persist:  the order is synced to the repository (I/O executor)
+ * - notify:   one line is shown on the display (I/O executor)
+ *
+ * Every stage starts with co_await on the executor it runs on. The compute
+ * executor is a WorkStealingPool; the I/O executor is a single thread, so
+ * repository writes and output stay serialized. Persisting and notifying
+ * one order therefore overlaps with pricing the next ones. The workflow
+ * rules are those of OrderManager::processBacklog.
+ *
+ * A stage that fails marks the order failed and it goes on to the notify
+ * stage. Any other exception that escapes a coroutine still counts the
+ * order as failed, so drain() always returns. The first such exception is
+ * kept for getUnexpectedError().
+ *
+ * The pipeline switches the manager to concurrent mode.
+ */
+class OrderPipeline
+{
+public:
+  static const int STAGE_COUNT = 4;
+
+  // Persists one order; called on the I/O executor with the order locked
+  typedef std::function<void(Order *)> PersistStep;
+
+  // Fire-and-forget coroutine; the pipeline tracks completion itself
+  struct Task
+  {
+    struct promise_type
+    {
+      OrderPipeline &pipeline;
+
+      // Coroutine arguments (the pipeline and the order) are passed here
+      promise_type(OrderPipeline &owner, Order *) : pipeline(owner) {}
+
+      Task get_return_object() { return Task(); }
+      std::suspend_never initial_suspend() noexcept { return {}; }
+      std::suspend_never final_suspend() noexcept { return {}; }
+      void return_void() {}
+      void unhandled_exception() { pipeline.abandon(std::current_exception()); }
+    };
+  };
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  // Awaitable that resumes the coroutine on a pool thread
+  struct ScheduleOn
+  {
+    WorkStealingPool &executor;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+      executor.submit([handle]()
+                      { handle.resume(); });
+    }
+    void await_resume() const noexcept {}
+  };
+
+  struct StageCounters
+  {
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> totalNanos;
+    std::atomic<std::uint64_t> maxNanos;
+  };
+
+  OrderManager *orderManager;
+  const IDisplay *display;
+
+  StageCounters stages[STAGE_COUNT];
+  std::atomic<int> completedCount;
+  std::atomic<int> failedCount;
+
+  PersistStep persistStep;
+
+  std::mutex inFlightMutex;
+  std::condition_variable inFlightDone;
+  int inFlight;
+  std::exception_ptr unexpectedError; // Guarded by inFlightMutex
+
+  // Declared last so that their threads stop before anything above is destroyed
+  WorkStealingPool computeExecutor;
+  WorkStealingPool ioExecutor;
+
+  Task run(Order *order);
+  void recordStage(PipelineStage stage, Clock::time_point requested);
+  void finish(bool succeeded);
+  void abandon(std::exception_ptr error);
+  static const char *stageName(PipelineStage stage);
+  static const char *statusName(OrderStatus status);
+
+public:
+  OrderPipeline(OrderManager *manager, const IDisplay *disp, unsigned computeThreads = 0);
+  ~OrderPipeline();
+
+  // Disable copy - coroutines hold a pointer to the pipeline
+  OrderPipeline(const OrderPipeline &) = delete;
+  OrderPipeline &operator=(const OrderPipeline &) = delete;
+
+  // Replaces the persist stage (default: OrderManager::syncOrderToRepository);
+  // call before the first submit
+  void setPersistStep(PersistStep step);
+
+  void submit(Order *order);
+  void drain(); // Blocks until every submitted order has left the pipeline
+
+  StageLatency getStageLatency(PipelineStage stage) const;
+  int getCompletedCount() const;
+  int getFailedCount() const;
+  std::exception_ptr getUnexpectedError(); // nullptr if there was none
+  void showLatencyReport() const;
+};
+
+#endif // ORDER_PIPELINE_H
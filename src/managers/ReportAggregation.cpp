@@ -0,0 +1,185 @@
+#include "managers/ReportAggregation.h"
+#include "concurrency/WorkStealingPool.h"
+#include "exceptions/PhotoStudioExceptions.h"
+#include "orders/ExpressOrder.h"
+#include <algorithm>
+#include <cmath>
+
+int RevenueTotals::statusIndex(OrderStatus status)
+{
+  switch (status)
+  {
+  case OrderStatus::PENDING:
+    return 0;
+  case OrderStatus::IN_PROGRESS:
+    return 1;
+  case OrderStatus::COMPLETED:
+    return 2;
+  case OrderStatus::CANCELLED:
+    return 3;
+  default:
+    return 0;
+  }
+}
+
+RevenueTotals::RevenueTotals()
+    : paidCents(0), expressCents(0), regularCents(0), orderCount(0)
+{
+  for (long long &count : statusCounts)
+  {
+    count = 0;
+  }
+}
+
+void RevenueTotals::add(OrderStatus status, bool paid, bool express, long long cents)
+{
+  orderCount++;
+  statusCounts[statusIndex(status)]++;
+  if (paid)
+  {
+    paidCents += cents;
+    (express ? expressCents : regularCents) += cents;
+  }
+}
+
+void RevenueTotals::merge(const RevenueTotals &other)
+{
+  paidCents += other.paidCents;
+  expressCents += other.expressCents;
+  regularCents += other.regularCents;
+  orderCount += other.orderCount;
+  for (int i = 0; i < STATUS_COUNT; i++)
+  {
+    statusCounts[i] += other.statusCounts[i];
+  }
+}
+
+bool RevenueTotals::operator==(const RevenueTotals &other) const
+{
+  if (paidCents != other.paidCents || expressCents != other.expressCents ||
+      regularCents != other.regularCents || orderCount != other.orderCount)
+  {
+    return false;
+  }
+  for (int i = 0; i < STATUS_COUNT; i++)
+  {
+    if (statusCounts[i] != other.statusCounts[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+OrderFigure::OrderFigure()
+    : cents(0), status(0), paid(0), express(0), reserved{0, 0, 0, 0, 0}
+{
+}
+
+OrderFigure::OrderFigure(long long totalCents, OrderStatus orderStatus, bool isPaid, bool isExpress)
+    : cents(totalCents), status(static_cast<std::uint8_t>(orderStatus)), paid(isPaid ? 1 : 0),
+      express(isExpress ? 1 : 0), reserved{0, 0, 0, 0, 0}
+{
+}
+
+OrderFigure OrderFigure::fromOrder(const Order *order)
+{
+  return OrderFigure(std::llround(order->getTotalPrice() * 100.0), order->getStatus(), order->getIsPaid(),
+                     dynamic_cast<const ExpressOrder *>(order) != nullptr);
+}
+
+ReportAggregator::ReportAggregator(unsigned threads, std::size_t chunk)
+    : threadCount(threads), chunkSize(chunk)
+{
+  if (chunk == 0)
+  {
+    throw InvalidDataException(
+        "Aggregation chunk size must be positive",
+        "Precondition violation: chunk == 0");
+  }
+}
+
+/**
+ * Reduce - Sum [0, count) chunk by chunk and merge in chunk order
+ *
+ * sumChunk(begin, end, totals) adds one chunk to an empty RevenueTotals.
+ */
+template <typename SumChunk>
+RevenueTotals ReportAggregator::reduce(std::size_t count, SumChunk sumChunk) const
+{
+  std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+  std::vector<RevenueTotals> partials(chunkCount);
+
+  if (chunkCount <= 1 || threadCount == 1)
+  {
+    for (std::size_t c = 0; c < chunkCount; c++)
+    {
+      sumChunk(c * chunkSize, std::min(count, (c + 1) * chunkSize), partials[c]);
+    }
+  }
+  else
+  {
+    WorkStealingPool pool(threadCount);
+    for (std::size_t c = 0; c < chunkCount; c++)
+    {
+      std::size_t begin = c * chunkSize;
+      std::size_t end = std::min(count, begin + chunkSize);
+      RevenueTotals *partial = &partials[c];
+      pool.submit([&sumChunk, begin, end, partial]()
+                  { sumChunk(begin, end, *partial); });
+    }
+    pool.waitIdle();
+  }
+
+  RevenueTotals totals;
+  for (const RevenueTotals &partial : partials)
+  {
+    totals.merge(partial);
+  }
+  return totals;
+}
+
+RevenueTotals ReportAggregator::aggregate(const std::vector<Order *> &orders,
+                                          std::vector<long long> *paidCentsByHandle) const
+{
+  if (paidCentsByHandle)
+  {
+    paidCentsByHandle->assign(orders.size(), 0);
+  }
+  long long *paidOut = paidCentsByHandle ? paidCentsByHandle->data() : nullptr;
+
+  return reduce(orders.size(), [&orders, paidOut](std::size_t begin, std::size_t end, RevenueTotals &totals)
+                {
+    for (std::size_t i = begin; i < end; i++)
+    {
+      const Order *order = orders[i];
+      bool paid = order->getIsPaid();
+      long long cents = paid ? std::llround(order->getTotalPrice() * 100.0) : 0;
+      totals.add(order->getStatus(), paid, dynamic_cast<const ExpressOrder *>(order) != nullptr, cents);
+      if (paidOut)
+      {
+        paidOut[i] = cents;
+      }
+    } });
+}
+
+RevenueTotals ReportAggregator::aggregate(const OrderFigure *figures, std::size_t count) const
+{
+  return reduce(count, [figures](std::size_t begin, std::size_t end, RevenueTotals &totals)
+                {
+    for (std::size_t i = begin; i < end; i++)
+    {
+      const OrderFigure &figure = figures[i];
+      totals.add(static_cast<OrderStatus>(figure.status), figure.paid != 0, figure.express != 0, figure.cents);
+    } });
+}
+
+unsigned ReportAggregator::getThreadCount() const
+{
+  return threadCount;
+}
+
+std::size_t ReportAggregator::getChunkSize() const
+{
+  return chunkSize;
+}
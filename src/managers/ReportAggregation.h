@@ -0,0 +1,88 @@
+#ifndef REPORT_AGGREGATION_H
+#define REPORT_AGGREGATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "orders/Order.h"
+#include "types/Types.h"
+
+/**
+ * RevenueTotals - Revenue report figures for a set of orders
+ *
+ * Amounts are integer cents, so merging partial totals gives the same
+ * result in any grouping.
+ */
+struct RevenueTotals
+{
+  static const int STATUS_COUNT = 4;
+
+  long long paidCents;
+  long long expressCents;
+  long long regularCents;
+  long long orderCount;
+  long long statusCounts[STATUS_COUNT];
+
+  RevenueTotals();
+  static int statusIndex(OrderStatus status);
+  void add(OrderStatus status, bool paid, bool express, long long cents);
+  void merge(const RevenueTotals &other);
+  bool operator==(const RevenueTotals &other) const;
+};
+
+/**
+ * OrderFigure - The fields of one order that revenue reports read
+ *
+ * Sixteen bytes per order, for aggregating histories too large to keep
+ * as Order objects (exports, archives, benchmarks).
+ */
+struct OrderFigure
+{
+  long long cents; // Total price in cents
+  std::uint8_t status;
+  std::uint8_t paid;
+  std::uint8_t express;
+  std::uint8_t reserved[5];
+
+  OrderFigure();
+  OrderFigure(long long totalCents, OrderStatus orderStatus, bool isPaid, bool isExpress);
+  static OrderFigure fromOrder(const Order *order);
+};
+
+/**
+ * ReportAggregator - Parallel scan of order histories for reports
+ *
+ * The input is cut into chunks of a fixed size, independent of the
+ * thread count. Chunks are summed on a WorkStealingPool and the partial
+ * totals are merged in chunk order, so the result is bit-identical for
+ * any number of threads. Inputs of one chunk (or a thread count of 1)
+ * are summed on the calling thread.
+ */
+class ReportAggregator
+{
+public:
+  static const std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+private:
+  unsigned threadCount; // 0 = one per hardware thread
+  std::size_t chunkSize;
+
+  template <typename SumChunk>
+  RevenueTotals reduce(std::size_t count, SumChunk sumChunk) const;
+
+public:
+  explicit ReportAggregator(unsigned threads = 0, std::size_t chunk = DEFAULT_CHUNK_SIZE);
+
+  // Orders may be read while no workflow is running. If paidCentsByHandle
+  // is given it receives each order's paid amount (0 if unpaid), indexed
+  // by handle; orders must then be OrderManager's list, where handle ==
+  // position.
+  RevenueTotals aggregate(const std::vector<Order *> &orders,
+                          std::vector<long long> *paidCentsByHandle = nullptr) const;
+  RevenueTotals aggregate(const OrderFigure *figures, std::size_t count) const;
+
+  unsigned getThreadCount() const;
+  std::size_t getChunkSize() const;
+};
+
+#endif // REPORT_AGGREGATION_H
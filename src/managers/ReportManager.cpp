@@ -1,14 +1,27 @@
 #include "managers/ReportManager.h"
 #include "managers/OrderManager.h"
 #include "managers/ConsumableManager.h"
+#include "orders/ExpressOrder.h"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
 
-ReportManager::ReportManager(const IDisplay *disp)
-    : display(disp)
+ReportManager::ReportManager(const IDisplay *disp, std::size_t maxCachedReports)
+    : display(disp), cacheCapacity(maxCachedReports), useClock(0), cacheHits(0), cacheMisses(0),
+      cacheEvictions(0)
 {
+  if (maxCachedReports == 0)
+  {
+    throw InvalidDataException(
+        "Report cache must hold at least one report",
+        "Precondition violation: maxCachedReports == 0");
+  }
 }
 
 ReportManager::~ReportManager()
 {
+  detachFeeds();
+
   // Clean up reports
   for (auto *report : reports)
   {
@@ -16,50 +29,497 @@ ReportManager::~ReportManager()
   }
 }
 
-void ReportManager::generateDailyRevenueReport(const OrderManager *orderManager)
+void ReportManager::attachOrderFeed(OrderManager *orderManager)
 {
-  double totalRevenue = orderManager->calculateTotalRevenue();
-  std::string content = "=== Daily Revenue Report ===\n";
-  content += "Total Revenue: $" + std::to_string(totalRevenue) + "\n";
-  content += "Total Orders: " + std::to_string(orderManager->getAllOrders().size()) + "\n";
+  revenueView.attach(orderManager);
+}
 
-  std::string reportID = "REP_REV_001";
-  Report *report = new Report(reportID, ReportType::DAILY_REVENUE, content);
-  reports.push_back(report);
+void ReportManager::attachConsumableFeed(ConsumableManager *consumableManager)
+{
+  usageView.attach(consumableManager);
+}
 
-  if (display)
+void ReportManager::setAggregationThreadCount(unsigned threadCount)
+{
+  revenueView.setAggregationThreadCount(threadCount);
+}
+
+void ReportManager::detachFeeds()
+{
+  revenueView.detach();
+  usageView.detach();
+}
+
+std::string ReportManager::cacheKey(ReportType type, const std::string &parameters)
+{
+  return std::to_string(static_cast<int>(type)) + "|" + parameters;
+}
+
+bool ReportManager::isCurrent(const CachedReport &entry) const
+{
+  return (!entry.orderSource || entry.orderSource->getDataVersion() == entry.orderVersion) &&
+         (!entry.consumableSource || entry.consumableSource->getDataVersion() == entry.consumableVersion);
+}
+
+/**
+ * FindCached - Serve a cached report if its sources have not changed
+ *
+ * Returns nullptr when the report has to be rebuilt; probe then holds
+ * the source versions read before the rebuild, so a change that races
+ * with it leaves the new entry stale rather than wrongly current.
+ */
+const Report *ReportManager::findCached(const std::string &key, const OrderManager *orderManager,
+                                        const ConsumableManager *consumableManager, CachedReport &probe)
+{
+  probe.report = nullptr;
+  probe.orderSource = orderManager;
+  probe.consumableSource = consumableManager;
+  probe.orderVersion = orderManager ? orderManager->getDataVersion() : 0;
+  probe.consumableVersion = consumableManager ? consumableManager->getDataVersion() : 0;
+  probe.lastUsed = 0;
+
+  auto it = cache.find(key);
+  if (it == cache.end())
   {
-    display->showLine("=== Daily Revenue Report ===");
-    display->showLine("Total Revenue: $" + std::to_string(totalRevenue));
-    display->showLine("Total Orders: " + std::to_string(orderManager->getAllOrders().size()));
+    return nullptr;
   }
+
+  CachedReport &entry = it->second;
+  if (entry.orderSource != orderManager || entry.consumableSource != consumableManager ||
+      entry.orderVersion != probe.orderVersion || entry.consumableVersion != probe.consumableVersion)
+  {
+    return nullptr;
+  }
+
+  cacheHits++;
+  entry.lastUsed = ++useClock;
+  showContent(entry.report->getContent());
+  return entry.report;
 }
 
-void ReportManager::generateConsumablesUsageReport(const ConsumableManager *consumableManager)
+/**
+ * StoreReport - Cache a freshly built report and show it
+ */
+const Report *ReportManager::storeReport(const std::string &key, const std::string &reportID, ReportType type,
+                                         const std::vector<std::string> &lines, const CachedReport &probe)
 {
-  std::string content = "=== Consumables Usage Report ===\n";
+  cacheMisses++;
+  evictStale();
+
+  std::size_t length = 0;
+  for (const std::string &line : lines)
+  {
+    length += line.size() + 1;
+  }
+  std::string content;
+  content.reserve(length);
+  for (const std::string &line : lines)
+  {
+    content.append(line).push_back('\n');
+  }
+  Report *report = new Report(reportID, type, std::move(content));
 
-  const auto &usageRecords = consumableManager->getUsageRecords();
-  for (const auto &usage : usageRecords)
+  auto it = cache.find(key);
+  if (it != cache.end())
+  {
+    // Same request from other sources: replace in place
+    std::replace(reports.begin(), reports.end(), it->second.report, report);
+    delete it->second.report;
+  }
+  else
   {
-    content += usage.getConsumableName() + ": " + std::to_string(usage.getQuantityUsed()) + " units\n";
+    if (cache.size() >= cacheCapacity)
+    {
+      auto oldest = cache.begin();
+      for (auto candidate = cache.begin(); candidate != cache.end(); ++candidate)
+      {
+        if (candidate->second.lastUsed < oldest->second.lastUsed)
+        {
+          oldest = candidate;
+        }
+      }
+      evict(oldest);
+    }
+    reports.push_back(report);
+    it = cache.emplace(key, probe).first;
   }
 
-  std::string reportID = "REP_CON_001";
-  Report *report = new Report(reportID, ReportType::CONSUMABLES_USAGE, content);
-  reports.push_back(report);
+  CachedReport &entry = it->second;
+  entry = probe;
+  entry.report = report;
+  entry.lastUsed = ++useClock;
+
+  showLines(lines);
+  return report;
+}
+
+void ReportManager::evict(std::unordered_map<std::string, CachedReport>::iterator entry)
+{
+  reports.erase(std::remove(reports.begin(), reports.end(), entry->second.report), reports.end());
+  delete entry->second.report;
+  cache.erase(entry);
+  cacheEvictions++;
+}
+
+void ReportManager::evictStale()
+{
+  for (auto it = cache.begin(); it != cache.end();)
+  {
+    auto next = std::next(it);
+    if (!isCurrent(it->second))
+    {
+      evict(it);
+    }
+    it = next;
+  }
+}
 
+void ReportManager::showLines(const std::vector<std::string> &lines) const
+{
   if (display)
   {
-    display->showLine("=== Consumables Usage Report ===");
-    for (const auto &usage : usageRecords)
+    for (const std::string &line : lines)
+    {
+      display->showLine(line);
+    }
+  }
+}
+
+void ReportManager::showContent(const std::string &content) const
+{
+  if (!display)
+  {
+    return;
+  }
+
+  std::size_t start = 0;
+  std::size_t end;
+  while ((end = content.find('\n', start)) != std::string::npos)
+  {
+    display->showLine(content.substr(start, end - start));
+    start = end + 1;
+  }
+}
+
+static std::string formatTime(std::int64_t timestamp)
+{
+  std::time_t seconds = static_cast<std::time_t>(timestamp);
+  std::tm local;
+  char text[32];
+  if (localtime_r(&seconds, &local) == nullptr || std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M", &local) == 0)
+  {
+    return std::to_string(timestamp);
+  }
+  return text;
+}
+
+static std::string usageLine(const UsageTotal &total)
+{
+  std::string extremes = total.hasExtremes()
+                             ? "min " + std::to_string(total.minQuantity) + ", max " + std::to_string(total.maxQuantity)
+                             : "min n/a, max n/a";
+  return total.consumableName + ": " + std::to_string(total.quantity) + " units in " +
+         std::to_string(total.count) + " use(s) (" + extremes + ", last used " + formatTime(total.lastUsedAt) + ")";
+}
+
+const Report *ReportManager::generateRevenueSummaryReport(const OrderManager *orderManager)
+{
+  std::string key = cacheKey(ReportType::REVENUE_SUMMARY, "");
+  CachedReport probe;
+  if (const Report *cached = findCached(key, orderManager, nullptr, probe))
+  {
+    return cached;
+  }
+
+  double totalRevenue;
+  double expressRevenue;
+  double regularRevenue;
+  int totalOrders;
+  int completedOrders;
+
+  if (revenueView.isAttachedTo(orderManager))
+  {
+    // Catch up on the changes since the last report, then render
+    revenueView.refresh();
+    totalRevenue = revenueView.getPaidCents() / 100.0;
+    expressRevenue = revenueView.getExpressCents() / 100.0;
+    regularRevenue = revenueView.getRegularCents() / 100.0;
+    totalOrders = revenueView.getTotalOrders();
+    completedOrders = revenueView.getOrderCountByStatus(OrderStatus::COMPLETED);
+  }
+  else
+  {
+    totalRevenue = orderManager->calculateTotalRevenue();
+    expressRevenue = orderManager->getExpressRevenue();
+    regularRevenue = orderManager->getRegularRevenue();
+    totalOrders = orderManager->getLoadedOrderCount();
+    completedOrders = orderManager->getOrderCountByStatus(OrderStatus::COMPLETED);
+  }
+
+  std::vector<std::string> lines;
+  lines.push_back("=== Revenue Summary (all time) ===");
+  lines.push_back("Total Revenue: $" + std::to_string(totalRevenue));
+  lines.push_back("  Express: $" + std::to_string(expressRevenue));
+  lines.push_back("  Regular: $" + std::to_string(regularRevenue));
+  lines.push_back("Total Orders: " + std::to_string(totalOrders));
+  lines.push_back("Completed Orders: " + std::to_string(completedOrders));
+
+  return storeReport(key, "REP_REV_001", ReportType::REVENUE_SUMMARY, lines, probe);
+}
+
+const Report *ReportManager::generateConsumablesUsageReport(const ConsumableManager *consumableManager)
+{
+  std::string key = cacheKey(ReportType::CONSUMABLES_USAGE, "");
+  CachedReport probe;
+  if (const Report *cached = findCached(key, nullptr, consumableManager, probe))
+  {
+    return cached;
+  }
+
+  std::vector<std::string> lines;
+  lines.push_back("=== Consumables Usage Report ===");
+
+  // One line per consumable from the rolled-up totals, not per usage record
+  std::vector<UsageTotal> totals = usageView.isAttachedTo(consumableManager)
+                                       ? usageView.getTotals()
+                                       : consumableManager->getUsageTotals();
+  for (const auto &total : totals)
+  {
+    lines.push_back(usageLine(total));
+  }
+
+  return storeReport(key, "REP_CON_001", ReportType::CONSUMABLES_USAGE, lines, probe);
+}
+
+static std::string formatCents(long long cents)
+{
+  return "$" + std::to_string(cents / 100.0);
+}
+
+static std::string marginLine(const std::string &label, long long revenueCents, long long costCents)
+{
+  return label + ": revenue " + formatCents(revenueCents) + ", materials " + formatCents(costCents) +
+         ", margin " + formatCents(revenueCents - costCents);
+}
+
+/**
+ * PeriodRange - Days [firstDay, endDay) of the period containing date
+ */
+static void periodRange(RevenuePeriod period, const std::string &date, std::int32_t &firstDay,
+                        std::int32_t &endDay)
+{
+  std::int32_t day;
+  if (!DailyRevenueIndex::parseDay(date, day))
+  {
+    throw InvalidDataException(
+        "Invalid report date: " + date,
+        "Precondition violation: date is not YYYY-MM-DD");
+  }
+
+  firstDay = day;
+  endDay = day + 1;
+  if (period == RevenuePeriod::WEEK)
+  {
+    firstDay = DailyRevenueIndex::weekStart(day);
+    endDay = firstDay + 7;
+  }
+  else if (period == RevenuePeriod::MONTH)
+  {
+    firstDay = DailyRevenueIndex::monthStart(day);
+    endDay = DailyRevenueIndex::nextMonthStart(day);
+  }
+}
+
+/**
+ * GeneratePeriodRevenueReport - Revenue of one day, week or month
+ *
+ * Reads OrderManager's per-day buckets for the period, so the cost
+ * depends on the days in the period, not on the number of orders.
+ */
+const Report *ReportManager::generatePeriodRevenueReport(const OrderManager *orderManager, RevenuePeriod period,
+                                                         const std::string &date)
+{
+  std::int32_t firstDay;
+  std::int32_t endDay;
+  periodRange(period, date, firstDay, endDay);
+  std::string title = period == RevenuePeriod::WEEK    ? "Weekly"
+                      : period == RevenuePeriod::MONTH ? "Monthly"
+                                                       : "Daily";
+
+  // Any date in the same period asks for the same report
+  std::string key = cacheKey(ReportType::PERIOD_REVENUE,
+                             std::to_string(static_cast<int>(period)) + "|" + std::to_string(firstDay));
+  CachedReport probe;
+  if (const Report *cached = findCached(key, orderManager, nullptr, probe))
+  {
+    return cached;
+  }
+
+  std::vector<std::string> lines;
+  std::string range = DailyRevenueIndex::formatDay(firstDay);
+  if (endDay - firstDay > 1)
+  {
+    range += " to " + DailyRevenueIndex::formatDay(endDay - 1);
+  }
+  lines.push_back("=== " + title + " Revenue Report (" + range + ") ===");
+
+  if (period != RevenuePeriod::DAY)
+  {
+    for (const DailyRevenue &bucket : orderManager->getDailyRevenue(firstDay, endDay))
+    {
+      lines.push_back(DailyRevenueIndex::formatDay(bucket.day) + ": " + formatCents(bucket.paidCents));
+    }
+  }
+
+  DailyRevenue total = orderManager->getRevenueBetween(firstDay, endDay);
+  lines.push_back("Total Revenue: " + formatCents(total.paidCents));
+  lines.push_back("  Express: " + formatCents(total.expressCents));
+  lines.push_back("  Regular: " + formatCents(total.regularCents));
+
+  return storeReport(key, "REP_PER_001", ReportType::PERIOD_REVENUE, lines, probe);
+}
+
+/**
+ * GenerateMarginReport - Join order revenue with material cost
+ *
+ * Material cost per order comes from ConsumableManager's order index,
+ * which is keyed by order ID and copied once, so the join is one pass
+ * over the orders. Cancelled orders are left out.
+ */
+const Report *ReportManager::generateMarginReport(const OrderManager *orderManager,
+                                                  const ConsumableManager *consumableManager)
+{
+  std::string key = cacheKey(ReportType::ORDER_MARGIN, "");
+  CachedReport probe;
+  if (const Report *cached = findCached(key, orderManager, consumableManager, probe))
+  {
+    return cached;
+  }
+
+  const std::vector<Order *> &orders = orderManager->getAllOrders();
+  std::unordered_map<std::string, long long> costByOrder = consumableManager->getMaterialCostByOrder();
+
+  std::vector<std::string> lines;
+  lines.push_back("=== Order Margin Report ===");
+
+  long long revenue[2] = {0, 0}; // Regular, express
+  long long cost[2] = {0, 0};
+  for (const Order *order : orders)
+  {
+    if (order->getStatus() == OrderStatus::CANCELLED)
     {
-      display->showLine(usage.getConsumableName() + ": " + std::to_string(usage.getQuantityUsed()) + " units");
+      continue;
     }
+    bool express = dynamic_cast<const ExpressOrder *>(order) != nullptr;
+    long long orderRevenue = std::llround(order->getTotalPrice() * 100.0);
+    auto found = costByOrder.find(order->getOrderID());
+    long long orderCost = found == costByOrder.end() ? 0 : found->second;
+    revenue[express] += orderRevenue;
+    cost[express] += orderCost;
+    lines.push_back(marginLine(order->getOrderID() + (express ? " (EXPRESS)" : " (REGULAR)"),
+                               orderRevenue, orderCost));
   }
+
+  lines.push_back(marginLine("Express", revenue[1], cost[1]));
+  lines.push_back(marginLine("Regular", revenue[0], cost[0]));
+  lines.push_back(marginLine("Total", revenue[0] + revenue[1], cost[0] + cost[1]));
+
+  return storeReport(key, "REP_MAR_001", ReportType::ORDER_MARGIN, lines, probe);
+}
+
+/**
+ * ExportMarginReport - Stream revenue and material cost per order
+ *
+ * Same figures as the margin report, one row per order followed by the
+ * per-type and overall totals (order_id "EXPRESS", "REGULAR", "TOTAL").
+ * Material cost is looked up per order rather than copied as a whole.
+ */
+void ReportManager::exportMarginReport(const OrderManager *orderManager, const ConsumableManager *consumableManager,
+                                       IReportWriter &writer) const
+{
+  writer.beginReport("REP_MAR_001", {"order_id", "type", "revenue_cents", "materials_cents", "margin_cents"});
+
+  long long revenue[2] = {0, 0}; // Regular, express
+  long long cost[2] = {0, 0};
+  for (const Order *order : orderManager->getAllOrders())
+  {
+    if (order->getStatus() == OrderStatus::CANCELLED)
+    {
+      continue;
+    }
+    bool express = dynamic_cast<const ExpressOrder *>(order) != nullptr;
+    long long orderRevenue = std::llround(order->getTotalPrice() * 100.0);
+    long long orderCost = consumableManager->getOrderMaterialCostCents(order->getOrderID());
+    revenue[express] += orderRevenue;
+    cost[express] += orderCost;
+    writer.writeRow({order->getOrderID(), express ? "EXPRESS" : "REGULAR", orderRevenue, orderCost,
+                     orderRevenue - orderCost});
+  }
+
+  writer.writeRow({"EXPRESS", "EXPRESS", revenue[1], cost[1], revenue[1] - cost[1]});
+  writer.writeRow({"REGULAR", "REGULAR", revenue[0], cost[0], revenue[0] - cost[0]});
+  long long totalRevenue = revenue[0] + revenue[1];
+  long long totalCost = cost[0] + cost[1];
+  writer.writeRow({"TOTAL", "ALL", totalRevenue, totalCost, totalRevenue - totalCost});
+  writer.endReport();
+}
+
+void ReportManager::exportConsumablesUsageReport(const ConsumableManager *consumableManager,
+                                                 IReportWriter &writer) const
+{
+  writer.beginReport("REP_CON_001", {"consumable", "units", "uses", "min", "max", "last_used_at"});
+
+  // One row per consumable; the totals are bounded by the catalogue size
+  std::vector<UsageTotal> totals = usageView.isAttachedTo(consumableManager)
+                                       ? usageView.getTotals()
+                                       : consumableManager->getUsageTotals();
+  for (const UsageTotal &total : totals)
+  {
+    if (!total.hasExtremes())
+    {
+      // Totals loaded from an old snapshot: leave min and max empty
+      writer.writeRow({total.consumableName, total.quantity, total.count, "", "",
+                       static_cast<long long>(total.lastUsedAt)});
+      continue;
+    }
+    writer.writeRow({total.consumableName, total.quantity, total.count, total.minQuantity, total.maxQuantity,
+                     static_cast<long long>(total.lastUsedAt)});
+  }
+  writer.endReport();
+}
+
+void ReportManager::exportPeriodRevenueReport(const OrderManager *orderManager, RevenuePeriod period,
+                                              const std::string &date, IReportWriter &writer) const
+{
+  std::int32_t firstDay;
+  std::int32_t endDay;
+  periodRange(period, date, firstDay, endDay);
+
+  writer.beginReport("REP_PER_001", {"date", "paid_cents", "express_cents", "regular_cents"});
+  for (const DailyRevenue &bucket : orderManager->getDailyRevenue(firstDay, endDay))
+  {
+    std::string day = DailyRevenueIndex::formatDay(bucket.day);
+    writer.writeRow({day, bucket.paidCents, bucket.expressCents, bucket.regularCents});
+  }
+  writer.endReport();
 }
 
 const std::vector<Report *> &ReportManager::getAllReports() const
 {
   return reports;
 }
+
+std::uint64_t ReportManager::getCacheHitCount() const
+{
+  return cacheHits;
+}
+
+std::uint64_t ReportManager::getCacheMissCount() const
+{
+  return cacheMisses;
+}
+
+std::uint64_t ReportManager::getCacheEvictionCount() const
+{
+  return cacheEvictions;
+}
@@ -1,28 +1,118 @@
 #ifndef REPORT_MANAGER_H
 #define REPORT_MANAGER_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "entities/Report.h"
 #include "interfaces/IDisplay.h"
+#include "interfaces/IReportWriter.h"
+#include "managers/ReportViews.h"
 
 class OrderManager;
 class ConsumableManager;
 
+/**
+ * ReportManager - Builds reports and keeps the latest one per request
+ *
+ * Generated reports are cached by report type and parameters together
+ * with the data versions of the managers they were built from. Asking
+ * again while both versions are unchanged serves the cached report (and
+ * shows it again) in O(1); otherwise the report is rebuilt and replaces
+ * the stale one. Entries whose source has changed are evicted on the
+ * next rebuild, and at most cacheCapacity reports are kept (least
+ * recently used first out), so getAllReports() stays bounded.
+ *
+ * The manager owns every Report it hands out. A returned pointer is only
+ * valid until the next generate* call (which may evict it) or until the
+ * ReportManager is destroyed; copy the content to keep it longer.
+ *
+ * The export methods stream the same figures row by row into an
+ * IReportWriter instead; they bypass the cache and keep no copy, so
+ * their memory use does not depend on the size of the report.
+ */
 class ReportManager
 {
+public:
+  static const std::size_t DEFAULT_CACHE_CAPACITY = 32;
+
 private:
-  std::vector<Report *> reports;
+  struct CachedReport
+  {
+    Report *report; // Its content is shown again on a hit
+    const OrderManager *orderSource;
+    const ConsumableManager *consumableSource;
+    std::uint64_t orderVersion;
+    std::uint64_t consumableVersion;
+    std::uint64_t lastUsed;
+  };
+
+  std::vector<Report *> reports; // Cached reports, in order of first generation
   const IDisplay *display;
+  RevenueReportView revenueView;
+  UsageReportView usageView;
+
+  std::unordered_map<std::string, CachedReport> cache;
+  std::size_t cacheCapacity;
+  std::uint64_t useClock;
+  std::uint64_t cacheHits;
+  std::uint64_t cacheMisses;
+  std::uint64_t cacheEvictions;
+
+  static std::string cacheKey(ReportType type, const std::string &parameters);
+  bool isCurrent(const CachedReport &entry) const;
+  const Report *findCached(const std::string &key, const OrderManager *orderManager,
+                           const ConsumableManager *consumableManager, CachedReport &probe);
+  const Report *storeReport(const std::string &key, const std::string &reportID, ReportType type,
+                            const std::vector<std::string> &lines, const CachedReport &probe);
+  void evict(std::unordered_map<std::string, CachedReport>::iterator entry);
+  void evictStale();
+  void showLines(const std::vector<std::string> &lines) const;
+  void showContent(const std::string &content) const;
 
 public:
-  ReportManager(const IDisplay *disp);
+  ReportManager(const IDisplay *disp, std::size_t maxCachedReports = DEFAULT_CACHE_CAPACITY);
   ~ReportManager();
 
-  void generateDailyRevenueReport(const OrderManager *orderManager);
-  void generateConsumablesUsageReport(const ConsumableManager *consumableManager);
+  // Disable copy - reports are owned by the manager
+  ReportManager(const ReportManager &) = delete;
+  ReportManager &operator=(const ReportManager &) = delete;
+
+  // Keep the revenue and usage figures materialized as changes happen;
+  // reports for an attached manager then only render the current figures.
+  // The managers must outlive the ReportManager or be detached first.
+  void attachOrderFeed(OrderManager *orderManager);
+  void attachConsumableFeed(ConsumableManager *consumableManager);
+  void detachFeeds();
+  // Threads used when a view has to rescan the order history (0 = all cores)
+  void setAggregationThreadCount(unsigned threadCount);
+
+  // Each returns the cached or rebuilt report; the pointer is owned by the
+  // manager and may dangle after the next generate* call (see above)
+  // Paid revenue and order counts over all orders, not one day
+  const Report *generateRevenueSummaryReport(const OrderManager *orderManager);
+  // Paid revenue of the orders due in the day, week or month containing
+  // date ("YYYY-MM-DD"), with one line per day for weeks and months
+  const Report *generatePeriodRevenueReport(const OrderManager *orderManager, RevenuePeriod period,
+                                            const std::string &date);
+  const Report *generateConsumablesUsageReport(const ConsumableManager *consumableManager);
+  // Revenue minus material cost per order and per order type
+  const Report *generateMarginReport(const OrderManager *orderManager, const ConsumableManager *consumableManager);
+
+  // Streaming exports: one row per order, consumable or day. Money is in
+  // integer cents so that the figures add up exactly.
+  void exportMarginReport(const OrderManager *orderManager, const ConsumableManager *consumableManager,
+                          IReportWriter &writer) const;
+  void exportConsumablesUsageReport(const ConsumableManager *consumableManager, IReportWriter &writer) const;
+  void exportPeriodRevenueReport(const OrderManager *orderManager, RevenuePeriod period,
+                                 const std::string &date, IReportWriter &writer) const;
 
+  // Same lifetime as the generate* results
   const std::vector<Report *> &getAllReports() const;
+  std::uint64_t getCacheHitCount() const;
+  std::uint64_t getCacheMissCount() const;
+  std::uint64_t getCacheEvictionCount() const;
 };
 
 #endif // REPORT_MANAGER_H
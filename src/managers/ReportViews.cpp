@@ -0,0 +1,267 @@
+#include "managers/ReportViews.h"
+#include "managers/OrderManager.h"
+#include "managers/ConsumableManager.h"
+#include "orders/ExpressOrder.h"
+#include <cmath>
+
+static long long orderCents(const Order *order)
+{
+  return std::llround(order->getTotalPrice() * 100.0);
+}
+
+RevenueReportView::RevenueReportView()
+    : source(nullptr), subscriberID(-1), missedSeen(0), version(0), appliedEvents(0), resyncCount(0)
+{
+}
+
+RevenueReportView::~RevenueReportView()
+{
+  detach();
+}
+
+void RevenueReportView::attach(OrderManager *orderManager)
+{
+  if (orderManager == nullptr)
+  {
+    throw InvalidDataException(
+        "Revenue view needs an order manager",
+        "Precondition violation: orderManager == nullptr");
+  }
+
+  detach();
+  subscriberID = orderManager->getChangeFeed().subscribe();
+  source = orderManager;
+  missedSeen = 0;
+  recount();
+}
+
+void RevenueReportView::detach()
+{
+  if (source != nullptr)
+  {
+    source->getChangeFeed().unsubscribe(subscriberID);
+    source = nullptr;
+    subscriberID = -1;
+  }
+}
+
+bool RevenueReportView::isAttachedTo(const OrderManager *orderManager) const
+{
+  return source != nullptr && source == orderManager;
+}
+
+void RevenueReportView::setAggregationThreadCount(unsigned threadCount)
+{
+  aggregator = ReportAggregator(threadCount);
+}
+
+/**
+ * Recount - Rebuild every figure with one scan of the orders
+ *
+ * Used on attach and after the feed lost events; the regular path is
+ * apply(). The scan runs under the shared index lock, so no order is
+ * created meanwhile, and every event published before it started is
+ * already in the scanned state. The cursor is moved past those events
+ * so they are not applied a second time.
+ */
+void RevenueReportView::recount()
+{
+  OrderChangeFeed &feed = source->getChangeFeed();
+  auto readLock = source->lockOrdersShared();
+  std::uint64_t scannedUpTo = feed.getHead();
+  totals = aggregator.aggregate(source->getAllOrders(), &paidCentsByHandle);
+  feed.skipTo(subscriberID, scannedUpTo);
+  version++;
+}
+
+void RevenueReportView::refresh()
+{
+  if (source == nullptr)
+  {
+    return;
+  }
+
+  OrderChangeFeed &feed = source->getChangeFeed();
+  OrderChangeEvent event;
+  while (feed.poll(subscriberID, event))
+  {
+    // Once events were lost the recount replaces the figures, so the rest
+    // of the ring is not worth applying
+    std::uint64_t missed = feed.getMissedCount(subscriberID);
+    if (missed != missedSeen)
+    {
+      missedSeen = missed;
+      resyncCount++;
+      recount();
+      return;
+    }
+    apply(event);
+  }
+}
+
+/**
+ * Apply - Move the figures by one feed event
+ *
+ * Status changes only move counts. A payment event settles the order's
+ * paid amount against what was counted for it before, which also covers
+ * price changes of paid orders.
+ */
+void RevenueReportView::apply(const OrderChangeEvent &event)
+{
+  std::uint32_t handle = event.orderHandle;
+  if (handle >= paidCentsByHandle.size())
+  {
+    paidCentsByHandle.resize(static_cast<std::size_t>(handle) + 1, 0);
+  }
+
+  if (event.oldStatus != event.newStatus)
+  {
+    totals.statusCounts[RevenueTotals::statusIndex(event.oldStatus)]--;
+    totals.statusCounts[RevenueTotals::statusIndex(event.newStatus)]++;
+  }
+  else if (event.paid)
+  {
+    settlePayment(handle);
+  }
+  else
+  {
+    // New order
+    totals.orderCount++;
+    totals.statusCounts[RevenueTotals::statusIndex(OrderStatus::PENDING)]++;
+  }
+
+  appliedEvents++;
+  version++;
+}
+
+void RevenueReportView::settlePayment(std::uint32_t handle)
+{
+  const Order *order = source->findOrderByHandle(handle);
+  if (order == nullptr || !order->getIsPaid())
+  {
+    return;
+  }
+
+  long long cents = orderCents(order);
+  long long delta = cents - paidCentsByHandle[handle];
+  paidCentsByHandle[handle] = cents;
+  totals.paidCents += delta;
+  (dynamic_cast<const ExpressOrder *>(order) ? totals.expressCents : totals.regularCents) += delta;
+}
+
+long long RevenueReportView::getPaidCents() const
+{
+  return totals.paidCents;
+}
+
+long long RevenueReportView::getExpressCents() const
+{
+  return totals.expressCents;
+}
+
+long long RevenueReportView::getRegularCents() const
+{
+  return totals.regularCents;
+}
+
+int RevenueReportView::getTotalOrders() const
+{
+  return static_cast<int>(totals.orderCount);
+}
+
+int RevenueReportView::getOrderCountByStatus(OrderStatus status) const
+{
+  return static_cast<int>(totals.statusCounts[RevenueTotals::statusIndex(status)]);
+}
+
+std::uint64_t RevenueReportView::getVersion() const
+{
+  return version;
+}
+
+std::uint64_t RevenueReportView::getAppliedEventCount() const
+{
+  return appliedEvents;
+}
+
+std::uint64_t RevenueReportView::getResyncCount() const
+{
+  return resyncCount;
+}
+
+UsageReportView::UsageReportView()
+    : source(nullptr), version(0)
+{
+}
+
+UsageReportView::~UsageReportView()
+{
+  detach();
+}
+
+void UsageReportView::attach(ConsumableManager *consumableManager)
+{
+  if (consumableManager == nullptr)
+  {
+    throw InvalidDataException(
+        "Usage view needs a consumable manager",
+        "Precondition violation: consumableManager == nullptr");
+  }
+
+  detach();
+  // Delivers the current totals through onUsageSnapshot
+  consumableManager->addUsageListener(this);
+  source = consumableManager;
+}
+
+void UsageReportView::detach()
+{
+  if (source != nullptr)
+  {
+    source->removeUsageListener(this);
+    source = nullptr;
+  }
+}
+
+bool UsageReportView::isAttachedTo(const ConsumableManager *consumableManager) const
+{
+  return source != nullptr && source == consumableManager;
+}
+
+void UsageReportView::onUsageSnapshot(const std::vector<UsageTotal> &snapshot)
+{
+  std::lock_guard<std::mutex> lock(viewMutex);
+  totals = snapshot;
+  totalIndex.clear();
+  totalIndex.reserve(snapshot.size() * 2);
+  for (const UsageTotal &total : totals)
+  {
+    totalIndex.insert(total.consumableName);
+  }
+  version++;
+}
+
+void UsageReportView::onUsageRecorded(const ConsumableUsage &usage)
+{
+  std::lock_guard<std::mutex> lock(viewMutex);
+  auto inserted = totalIndex.insert(usage.getConsumableName());
+  if (inserted.second)
+  {
+    totals.emplace_back();
+    totals.back().consumableName = usage.getConsumableName();
+  }
+  totals[inserted.first].add(usage.getQuantityUsed(), usage.getUsedAt());
+  version++;
+}
+
+std::vector<UsageTotal> UsageReportView::getTotals() const
+{
+  std::lock_guard<std::mutex> lock(viewMutex);
+  return totals;
+}
+
+std::uint64_t UsageReportView::getVersion() const
+{
+  std::lock_guard<std::mutex> lock(viewMutex);
+  return version;
+}
@@ -0,0 +1,113 @@
+#ifndef REPORT_VIEWS_H
+#define REPORT_VIEWS_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "events/OrderChangeFeed.h"
+#include "interfaces/IUsageListener.h"
+#include "managers/ReportAggregation.h"
+#include "types/Types.h"
+
+class OrderManager;
+class ConsumableManager;
+
+/**
+ * RevenueReportView - Revenue report figures kept up to date from the
+ * order change feed
+ *
+ * attach() counts the orders once (in parallel, see ReportAggregator),
+ * then every creation, status change and payment read from the feed
+ * moves the figures by one event's worth, so refresh() costs O(events
+ * since the last refresh), never O(orders).
+ * Paid amounts are remembered per order handle, so a price change of a
+ * paid order replaces its old amount instead of adding to it. If the feed
+ * overwrote events before they were read, the view recounts from scratch
+ * and resumes reading after the last event the recount covered.
+ *
+ * Attach while no workflow is running; orders loaded into the manager
+ * later are not published on the feed.
+ */
+class RevenueReportView
+{
+private:
+  OrderManager *source;
+  int subscriberID;
+  std::uint64_t missedSeen;
+
+  ReportAggregator aggregator; // Used for recounts
+  RevenueTotals totals;
+  std::vector<long long> paidCentsByHandle; // 0 for unpaid orders
+  std::uint64_t version;                    // Bumped whenever a figure changes
+  std::uint64_t appliedEvents;
+  std::uint64_t resyncCount;
+
+  void recount();
+  void apply(const OrderChangeEvent &event);
+  void settlePayment(std::uint32_t handle);
+
+public:
+  RevenueReportView();
+  ~RevenueReportView();
+
+  // Disable copy - the view owns a feed subscription
+  RevenueReportView(const RevenueReportView &) = delete;
+  RevenueReportView &operator=(const RevenueReportView &) = delete;
+
+  void attach(OrderManager *orderManager);
+  void detach();
+  bool isAttachedTo(const OrderManager *orderManager) const;
+  void setAggregationThreadCount(unsigned threadCount); // 0 = one per hardware thread
+
+  // Applies pending feed events; call from one thread at a time
+  void refresh();
+
+  long long getPaidCents() const;
+  long long getExpressCents() const;
+  long long getRegularCents() const;
+  int getTotalOrders() const;
+  int getOrderCountByStatus(OrderStatus status) const;
+  std::uint64_t getVersion() const;
+  std::uint64_t getAppliedEventCount() const;
+  std::uint64_t getResyncCount() const;
+};
+
+/**
+ * UsageReportView - Per-consumable usage totals kept up to date from
+ * ConsumableManager's usage listener
+ *
+ * Each recorded usage costs one lookup in a flat hash index sized for the
+ * consumables known at attach time; the totals (units, count, min, max,
+ * last used) stay in order of first use, matching
+ * ConsumableManager::getUsageTotals.
+ */
+class UsageReportView : public IUsageListener
+{
+private:
+  ConsumableManager *source;
+  mutable std::mutex viewMutex;
+  std::vector<UsageTotal> totals;
+  FlatStringIndex totalIndex; // Name -> position in totals
+  std::uint64_t version;
+
+public:
+  UsageReportView();
+  ~UsageReportView() override;
+
+  // Disable copy - the view is registered with its source by address
+  UsageReportView(const UsageReportView &) = delete;
+  UsageReportView &operator=(const UsageReportView &) = delete;
+
+  void attach(ConsumableManager *consumableManager);
+  void detach();
+  bool isAttachedTo(const ConsumableManager *consumableManager) const;
+
+  void onUsageSnapshot(const std::vector<UsageTotal> &snapshot) override;
+  void onUsageRecorded(const ConsumableUsage &usage) override;
+
+  std::vector<UsageTotal> getTotals() const;
+  std::uint64_t getVersion() const;
+};
+
+#endif // REPORT_VIEWS_H
@@ -2,29 +2,39 @@
 #include "exceptions/PhotoStudioExceptions.h"
 
 Order::Order(const std::string &id, const std::string &cTime, Client *c)
-    : orderID(id), completionTime(cTime), status(OrderStatus::PENDING),
-      totalPrice(0.0), isPaid(false), client(c)
+    : orderID(id), completionTime(cTime), state(encodeStatus(OrderStatus::PENDING)),
+      totalPrice(0.0), client(c), handle(0)
+{
+  tryValidate(id, cTime, c).throwIfError();
+}
+
+ValidationResult Order::tryValidate(const std::string &id, const std::string &cTime, const Client *c)
 {
   if (id.empty())
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Order ID cannot be empty",
         "Data validation failed in Order constructor");
   }
 
   if (cTime.empty())
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Completion time cannot be empty",
         "Data validation failed in Order constructor");
   }
 
   if (c == nullptr)
   {
-    throw InvalidDataException(
+    return ValidationResult::failure(
+        ErrorCode::INVALID_DATA,
         "Client cannot be null",
         "Data validation failed in Order constructor");
   }
+
+  return ValidationResult::ok();
 }
 
 double Order::calculatePrice()
@@ -37,7 +47,7 @@ double Order::calculatePrice()
   totalPrice = 0.0;
   for (const auto &item : items)
   {
-    totalPrice += item->getSubtotal();
+    totalPrice += item.getSubtotal();
   }
 
   return totalPrice;
@@ -45,12 +55,86 @@ double Order::calculatePrice()
 
 void Order::updateStatus(OrderStatus newStatus, const IDisplay *display)
 {
-  status = newStatus;
+  std::uint32_t current = state.load(std::memory_order_acquire);
+  while (!state.compare_exchange_weak(current, (current & PAID_FLAG) | encodeStatus(newStatus),
+                                      std::memory_order_acq_rel, std::memory_order_acquire))
+  {
+  }
+
+  showStatus(newStatus, display);
+}
+
+void Order::recordPayment(const IDisplay *display)
+{
+  state.fetch_or(PAID_FLAG, std::memory_order_acq_rel);
 
   if (display)
   {
-    std::string statusStr;
-    switch (status)
+    display->log(LogLevel::INFO, "Payment recorded for order {}", orderID);
+  }
+}
+
+/**
+ * TryTransition - Compare-and-swap status change
+ *
+ * Moves the order from 'from' to 'to' only if it is currently in 'from'.
+ * The paid flag is carried over unchanged. When several workers race on the
+ * same order exactly one of them succeeds; the others get false.
+ */
+bool Order::tryTransition(OrderStatus from, OrderStatus to, const IDisplay *display)
+{
+  std::uint32_t current = state.load(std::memory_order_acquire);
+  do
+  {
+    if (decodeStatus(current) != from)
+    {
+      return false;
+    }
+  } while (!state.compare_exchange_weak(current, (current & PAID_FLAG) | encodeStatus(to),
+                                        std::memory_order_acq_rel, std::memory_order_acquire));
+
+  showStatus(to, display);
+  return true;
+}
+
+/**
+ * TryRecordPayment - Compare-and-swap COMPLETED/unpaid -> COMPLETED/paid
+ *
+ * Returns false if the order is not COMPLETED or has already been paid,
+ * so a payment can never be recorded twice.
+ */
+bool Order::tryRecordPayment(const IDisplay *display)
+{
+  std::uint32_t expected = encodeStatus(OrderStatus::COMPLETED);
+  if (!state.compare_exchange_strong(expected, expected | PAID_FLAG,
+                                     std::memory_order_acq_rel, std::memory_order_acquire))
+  {
+    return false;
+  }
+
+  if (display)
+  {
+    display->log(LogLevel::INFO, "Payment recorded for order {}", orderID);
+  }
+  return true;
+}
+
+std::uint32_t Order::encodeStatus(OrderStatus status)
+{
+  return static_cast<std::uint32_t>(status);
+}
+
+OrderStatus Order::decodeStatus(std::uint32_t packedState)
+{
+  return static_cast<OrderStatus>(packedState & STATUS_MASK);
+}
+
+void Order::showStatus(OrderStatus shownStatus, const IDisplay *display) const
+{
+  if (display && display->isEnabled(LogLevel::INFO))
+  {
+    const char *statusStr = "";
+    switch (shownStatus)
     {
     case OrderStatus::PENDING:
       statusStr = "PENDING";
@@ -65,37 +149,21 @@ void Order::updateStatus(OrderStatus newStatus, const IDisplay *display)
       statusStr = "CANCELLED";
       break;
     }
-    display->showLine("Order " + orderID + " status updated to " + statusStr);
-  }
-}
-
-void Order::recordPayment(const IDisplay *display)
-{
-  isPaid = true;
-
-  if (display)
-  {
-    display->showLine("Payment recorded for order " + orderID);
+    display->log(LogLevel::INFO, "Order {} status updated to {}", orderID, statusStr);
   }
 }
 
-void Order::addItem(OrderItem *item)
+void Order::addItem(const OrderItem &item)
 {
-  if (item == nullptr)
-  {
-    throw InvalidDataException(
-        "Cannot add null item to order",
-        "Data validation failed: item == nullptr");
-  }
-
   items.push_back(item);
-  totalPrice += item->getSubtotal();
+  totalPrice += item.getSubtotal();
 }
 
 // Release 4: Methods for restoring state from persistent storage
 void Order::restoreStatus(OrderStatus restoredStatus)
 {
-  status = restoredStatus;
+  std::uint32_t paidBit = state.load(std::memory_order_relaxed) & PAID_FLAG;
+  state.store(paidBit | encodeStatus(restoredStatus), std::memory_order_release);
 }
 
 void Order::restorePrice(double restoredPrice)
@@ -105,10 +173,17 @@ void Order::restorePrice(double restoredPrice)
 
 void Order::restorePaidStatus(bool paid)
 {
-  isPaid = paid;
+  if (paid)
+  {
+    state.fetch_or(PAID_FLAG, std::memory_order_acq_rel);
+  }
+  else
+  {
+    state.fetch_and(~PAID_FLAG, std::memory_order_acq_rel);
+  }
 }
 
-std::string Order::getOrderID() const
+const std::string &Order::getOrderID() const
 {
   return orderID;
 }
@@ -120,7 +195,7 @@ std::string Order::getCompletionTime() const
 
 OrderStatus Order::getStatus() const
 {
-  return status;
+  return decodeStatus(state.load(std::memory_order_acquire));
 }
 
 double Order::getTotalPrice() const
@@ -130,7 +205,7 @@ double Order::getTotalPrice() const
 
 bool Order::getIsPaid() const
 {
-  return isPaid;
+  return (state.load(std::memory_order_acquire) & PAID_FLAG) != 0;
 }
 
 Client *Order::getClient() const
@@ -138,7 +213,22 @@ Client *Order::getClient() const
   return client;
 }
 
-const std::vector<OrderItem *> &Order::getItems() const
+const Order::ItemList &Order::getItems() const
 {
   return items;
 }
+
+std::mutex &Order::getMutex() const
+{
+  return orderMutex;
+}
+
+std::uint32_t Order::getHandle() const
+{
+  return handle;
+}
+
+void Order::assignHandle(std::uint32_t newHandle)
+{
+  handle = newHandle;
+}
@@ -3,25 +3,43 @@
 
 #include <string>
 #include <vector>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
 #include "types/Types.h"
+#include "types/SmallVector.h"
 #include "entities/Client.h"
 #include "entities/OrderItem.h"
 #include "interfaces/IDisplay.h"
 #include "exceptions/PhotoStudioExceptions.h"
+#include "types/ValidationResult.h"
 
 class Order
 {
+public:
+  // Most orders have one to four items; these are stored inside the order
+  static const std::size_t INLINE_ITEM_CAPACITY = 4;
+  typedef SmallVector<OrderItem, INLINE_ITEM_CAPACITY> ItemList;
+
 private:
   std::string orderID;
   std::string completionTime;
-  OrderStatus status;
+  // Status (low byte) and paid flag packed into one word so that workflow
+  // transitions are single compare-and-swap operations
+  std::atomic<std::uint32_t> state;
+  static const std::uint32_t STATUS_MASK = 0xFF;
+  static const std::uint32_t PAID_FLAG = 0x100;
   double totalPrice;
-  bool isPaid;
   Client *client;
-  std::vector<OrderItem *> items;
+  std::uint32_t handle; // Compact ID assigned by OrderManager (used by the change feed)
+  ItemList items;
+  mutable std::mutex orderMutex; // Guards this order in OrderManager's concurrent mode
 
 public:
   Order(const std::string &id, const std::string &cTime, Client *c);
+
+  // Constructor checks without throwing (for bulk imports)
+  static ValidationResult tryValidate(const std::string &id, const std::string &cTime, const Client *c);
   virtual ~Order() = default;
 
   // Virtual function for polymorphism
@@ -29,20 +47,32 @@ public:
 
   void updateStatus(OrderStatus newStatus, const IDisplay *display);
   void recordPayment(const IDisplay *display);
-  void addItem(OrderItem *item);
+
+  // Lock-free workflow: succeed only if the order is still in the expected state
+  bool tryTransition(OrderStatus from, OrderStatus to, const IDisplay *display = nullptr);
+  bool tryRecordPayment(const IDisplay *display = nullptr);
+  void addItem(const OrderItem &item);
 
   // Release 4: Methods for restoring state from persistent storage
   void restoreStatus(OrderStatus restoredStatus);
   void restorePrice(double restoredPrice);
   void restorePaidStatus(bool paid);
 
-  std::string getOrderID() const;
+  const std::string &getOrderID() const;
   std::string getCompletionTime() const;
   OrderStatus getStatus() const;
   double getTotalPrice() const;
   bool getIsPaid() const;
   Client *getClient() const;
-  const std::vector<OrderItem *> &getItems() const;
+  const ItemList &getItems() const;
+  std::mutex &getMutex() const;
+  std::uint32_t getHandle() const;
+  void assignHandle(std::uint32_t newHandle);
+
+private:
+  static std::uint32_t encodeStatus(OrderStatus status);
+  static OrderStatus decodeStatus(std::uint32_t packedState);
+  void showStatus(OrderStatus shownStatus, const IDisplay *display) const;
 };
 
 #endif // ORDER_H
@@ -0,0 +1,143 @@
+#include "repository/BufferedFileSink.h"
+#include "exceptions/PhotoStudioExceptions.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+BufferedFileSink::BufferedFileSink(const std::string &filePath, std::size_t bufferSize)
+    : path(filePath), fileDescriptor(-1), buffer(bufferSize), used(0), bytesWritten(0)
+{
+  if (filePath.empty())
+  {
+    throw InvalidDataException(
+        "Report file path cannot be empty",
+        "Precondition violation: filePath.empty()");
+  }
+  if (bufferSize == 0)
+  {
+    throw InvalidDataException(
+        "Report file buffer cannot be empty",
+        "Precondition violation: bufferSize == 0");
+  }
+
+  fileDescriptor = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fileDescriptor < 0)
+  {
+    throw InvalidDataException(
+        "Could not open report file: " + filePath,
+        "open() failed: " + std::string(std::strerror(errno)));
+  }
+}
+
+BufferedFileSink::~BufferedFileSink()
+{
+  try
+  {
+    close();
+  }
+  catch (...)
+  {
+    // Destructors must not throw; call close() to see write errors
+  }
+}
+
+void BufferedFileSink::writeThrough(const char *data, std::size_t size)
+{
+  while (size > 0)
+  {
+    ssize_t written = ::write(fileDescriptor, data, size);
+    if (written < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      throw InvalidDataException(
+          "Could not write report file: " + path,
+          "write() failed: " + std::string(std::strerror(errno)));
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+}
+
+void BufferedFileSink::rejectClosed(const char *operation) const
+{
+  throw InvalidDataException(
+      "Report file is closed: " + path,
+      "Precondition violation: " + std::string(operation) + "() after close()");
+}
+
+void BufferedFileSink::write(const char *data, std::size_t size)
+{
+  if (fileDescriptor < 0)
+  {
+    rejectClosed("write");
+  }
+
+  bytesWritten += size;
+  if (used + size <= buffer.size())
+  {
+    std::memcpy(buffer.data() + used, data, size);
+    used += size;
+    return;
+  }
+
+  flush();
+  if (size >= buffer.size())
+  {
+    writeThrough(data, size);
+  }
+  else
+  {
+    std::memcpy(buffer.data(), data, size);
+    used = size;
+  }
+}
+
+void BufferedFileSink::flush()
+{
+  if (used > 0 && fileDescriptor >= 0)
+  {
+    std::size_t pending = used;
+    used = 0;
+    writeThrough(buffer.data(), pending);
+  }
+}
+
+void BufferedFileSink::close()
+{
+  if (fileDescriptor < 0)
+  {
+    return;
+  }
+
+  try
+  {
+    flush();
+  }
+  catch (...)
+  {
+    ::close(fileDescriptor);
+    fileDescriptor = -1;
+    throw;
+  }
+  ::close(fileDescriptor);
+  fileDescriptor = -1;
+}
+
+const std::string &BufferedFileSink::getPath() const
+{
+  return path;
+}
+
+std::uint64_t BufferedFileSink::getBytesWritten() const
+{
+  return bytesWritten;
+}
+
+std::size_t BufferedFileSink::getBufferSize() const
+{
+  return buffer.size();
+}
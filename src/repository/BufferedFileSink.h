@@ -0,0 +1,67 @@
+#ifndef BUFFERED_FILE_SINK_H
+#define BUFFERED_FILE_SINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * BufferedFileSink - Append-only file output through a fixed buffer
+ *
+ * Bytes are collected in a buffer of bufferSize bytes and handed to the
+ * file with one write() whenever it fills up; a single write larger than
+ * the buffer goes straight to the file. Memory use is the buffer, however
+ * much is written. The file is created or truncated on construction.
+ * Failures throw InvalidDataException; the destructor flushes and closes
+ * without throwing.
+ */
+class BufferedFileSink
+{
+public:
+  static const std::size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+private:
+  std::string path;
+  int fileDescriptor;
+  std::vector<char> buffer;
+  std::size_t used;
+  std::uint64_t bytesWritten;
+
+  void writeThrough(const char *data, std::size_t size);
+  [[noreturn]] void rejectClosed(const char *operation) const;
+
+public:
+  explicit BufferedFileSink(const std::string &filePath, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+  ~BufferedFileSink();
+
+  // Disable copy - the sink owns its file descriptor
+  BufferedFileSink(const BufferedFileSink &) = delete;
+  BufferedFileSink &operator=(const BufferedFileSink &) = delete;
+
+  void write(const char *data, std::size_t size);
+  void write(std::string_view text) { write(text.data(), text.size()); }
+  void put(char character)
+  {
+    if (fileDescriptor < 0)
+    {
+      rejectClosed("put");
+    }
+    if (used == buffer.size())
+    {
+      flush();
+    }
+    buffer[used++] = character;
+    bytesWritten++;
+  }
+
+  void flush();
+  void close();
+
+  const std::string &getPath() const;
+  std::uint64_t getBytesWritten() const; // Including bytes still buffered
+  std::size_t getBufferSize() const;
+};
+
+#endif // BUFFERED_FILE_SINK_H
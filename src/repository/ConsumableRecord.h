@@ -0,0 +1,45 @@
+#ifndef CONSUMABLE_RECORD_H
+#define CONSUMABLE_RECORD_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * ConsumableRecord - Persistent state of one consumable
+ *
+ * stock is the stock on hand as of the last logged change; reservations
+ * are transient and never stored.
+ */
+struct ConsumableRecord
+{
+  std::string consumableID;
+  std::string name;
+  std::string unitOfMeasure;
+  long long stock;
+  long long unitCostCents;
+
+  ConsumableRecord() : consumableID(""), name(""), unitOfMeasure(""), stock(0), unitCostCents(0) {}
+
+  ConsumableRecord(const std::string &id, const std::string &n, const std::string &unit, long long s,
+                   long long costCents)
+      : consumableID(id), name(n), unitOfMeasure(unit), stock(s), unitCostCents(costCents) {}
+};
+
+/**
+ * OrderUsageRecord - Persistent link between one usage and an order
+ *
+ * slot is the consumable's position in the repository's records and
+ * costCents the material cost charged when the usage was recorded.
+ */
+struct OrderUsageRecord
+{
+  std::string orderID;
+  std::uint32_t slot;
+  int quantity;
+  long long costCents;
+
+  OrderUsageRecord(const std::string &id, std::uint32_t s, int q, long long cost)
+      : orderID(id), slot(s), quantity(q), costCents(cost) {}
+};
+
+#endif // CONSUMABLE_RECORD_H
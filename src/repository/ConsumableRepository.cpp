@@ -0,0 +1,616 @@
+#include "repository/ConsumableRepository.h"
+#include "repository/InventoryFormat.h"
+#include "exceptions/PhotoStudioExceptions.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace InventoryFormat;
+
+/**
+ * MappedFile - Read-only mapping of a whole file, unmapped on scope exit
+ */
+namespace
+{
+  class MappedFile
+  {
+  private:
+    const unsigned char *data;
+    std::size_t size;
+
+  public:
+    explicit MappedFile(const std::string &path) : data(nullptr), size(0)
+    {
+      int descriptor = ::open(path.c_str(), O_RDONLY);
+      if (descriptor < 0)
+      {
+        return;
+      }
+      struct stat info;
+      if (::fstat(descriptor, &info) == 0 && info.st_size > 0)
+      {
+        void *address = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (address != MAP_FAILED)
+        {
+          data = static_cast<const unsigned char *>(address);
+          size = static_cast<std::size_t>(info.st_size);
+        }
+      }
+      ::close(descriptor);
+    }
+
+    ~MappedFile()
+    {
+      if (data)
+      {
+        ::munmap(const_cast<unsigned char *>(data), size);
+      }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const unsigned char *getData() const { return data; }
+    std::size_t getSize() const { return size; }
+  };
+
+  bool writeAll(int descriptor, const unsigned char *data, std::size_t size)
+  {
+    while (size > 0)
+    {
+      ssize_t written = ::write(descriptor, data, size);
+      if (written < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        return false;
+      }
+      data += written;
+      size -= static_cast<std::size_t>(written);
+    }
+    return true;
+  }
+}
+
+ConsumableRepository::ConsumableRepository(const std::string &basePath, const IDisplay *disp,
+                                           std::size_t recordsPerSnapshot)
+    : snapshotPath(basePath + ".snap"), logPath(basePath + ".log"), display(disp),
+      snapshotInterval(recordsPerSnapshot), generation(0), snapshotSlots(0), logDescriptor(-1),
+      loggedSinceSnapshot(0), pendingRecords(0)
+{
+  if (basePath.empty())
+  {
+    throw InvalidDataException(
+        "Inventory path cannot be empty",
+        "Precondition violation: basePath.empty()");
+  }
+  if (recordsPerSnapshot == 0)
+  {
+    throw InvalidDataException(
+        "Snapshot interval must be greater than zero",
+        "Precondition violation: recordsPerSnapshot == 0");
+  }
+}
+
+ConsumableRepository::~ConsumableRepository()
+{
+  commit();
+  closeLog();
+}
+
+bool ConsumableRepository::load(UsageStore &usage)
+{
+  records.clear();
+  slotById.clear();
+  slotByConsumable.clear();
+  orderUsage.clear();
+  pending.clear();
+  pendingRecords = 0;
+  usage.clear();
+  generation = 0;
+  snapshotSlots = 0;
+  loggedSinceSnapshot = 0;
+  closeLog();
+
+  bool loaded = false;
+  {
+    MappedFile snapshot(snapshotPath);
+    const unsigned char *cursor = snapshot.getData();
+    const unsigned char *end = cursor + snapshot.getSize();
+    SnapshotHeader header = {};
+
+    if (snapshot.getSize() >= sizeof(header))
+    {
+      std::memcpy(&header, cursor, sizeof(header));
+      cursor += sizeof(header);
+      loaded = std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0 &&
+               header.version >= SNAPSHOT_VERSION_NO_COST && header.version <= SNAPSHOT_VERSION;
+    }
+    bool hasCost = header.version >= SNAPSHOT_VERSION_NO_EXTREMES;
+    std::size_t entryHeaderSize = hasCost ? CONSUMABLE_HEADER_SIZE : CONSUMABLE_HEADER_SIZE_NO_COST;
+
+    for (std::uint32_t i = 0; loaded && i < header.consumableCount; i++)
+    {
+      if (static_cast<std::size_t>(end - cursor) < entryHeaderSize)
+      {
+        loaded = false;
+        break;
+      }
+      ConsumableRecord record;
+      record.stock = InventoryFormat::load<std::int64_t>(cursor);
+      record.unitCostCents = hasCost ? InventoryFormat::load<std::int64_t>(cursor) : 0;
+      std::uint16_t idLength = InventoryFormat::load<std::uint16_t>(cursor);
+      std::uint16_t nameLength = InventoryFormat::load<std::uint16_t>(cursor);
+      std::uint16_t unitLength = InventoryFormat::load<std::uint16_t>(cursor);
+      cursor += 2;
+      if (static_cast<std::size_t>(end - cursor) < std::size_t(idLength) + nameLength + unitLength)
+      {
+        loaded = false;
+        break;
+      }
+      record.consumableID.assign(reinterpret_cast<const char *>(cursor), idLength);
+      cursor += idLength;
+      record.name.assign(reinterpret_cast<const char *>(cursor), nameLength);
+      cursor += nameLength;
+      record.unitOfMeasure.assign(reinterpret_cast<const char *>(cursor), unitLength);
+      cursor += unitLength;
+
+      slotById.emplace(record.consumableID, static_cast<std::uint32_t>(records.size()));
+      records.push_back(record);
+    }
+
+    if (loaded && header.version > SNAPSHOT_VERSION_NO_ORDERS)
+    {
+      loaded = loadOrderUsage(cursor, end);
+    }
+
+    if (loaded)
+    {
+      loaded = usage.deserialize(cursor, static_cast<std::size_t>(end - cursor),
+                                 header.version >= SNAPSHOT_VERSION);
+    }
+
+    if (loaded)
+    {
+      generation = header.generation;
+      snapshotSlots = records.size();
+    }
+    else
+    {
+      records.clear();
+      slotById.clear();
+      orderUsage.clear();
+      if (snapshot.getSize() > 0 && display)
+      {
+        display->log(LogLevel::WARNING, "Warning: Ignoring unreadable inventory snapshot: {}", snapshotPath);
+      }
+    }
+  }
+
+  if (!loaded)
+  {
+    return false;
+  }
+
+  // Without a writable log, changes are only saved by the next snapshot
+  bool replayed = replayLog(usage);
+  openLog(!replayed);
+
+  if (display)
+  {
+    display->log(LogLevel::INFO, "Loaded {} consumable(s) from inventory ({} logged change(s) replayed).",
+                 records.size(), loggedSinceSnapshot);
+  }
+  return true;
+}
+
+/**
+ * LoadOrderUsage - Read the snapshot's order usage section
+ *
+ * An entry naming a slot past the stored consumables is dropped; a
+ * section cut short makes the whole snapshot unreadable.
+ */
+bool ConsumableRepository::loadOrderUsage(const unsigned char *&cursor, const unsigned char *end)
+{
+  if (end - cursor < 8)
+  {
+    return false;
+  }
+  std::uint32_t count = InventoryFormat::load<std::uint32_t>(cursor);
+  cursor += 4;
+
+  for (std::uint32_t i = 0; i < count; i++)
+  {
+    if (static_cast<std::size_t>(end - cursor) < ORDER_USAGE_HEADER_SIZE)
+    {
+      return false;
+    }
+    std::uint32_t slot = InventoryFormat::load<std::uint32_t>(cursor);
+    std::int32_t quantity = InventoryFormat::load<std::int32_t>(cursor);
+    std::int64_t costCents = InventoryFormat::load<std::int64_t>(cursor);
+    std::uint16_t idLength = InventoryFormat::load<std::uint16_t>(cursor);
+    cursor += 2;
+    if (static_cast<std::size_t>(end - cursor) < idLength)
+    {
+      return false;
+    }
+    if (slot < records.size())
+    {
+      orderUsage.emplace_back(std::string(reinterpret_cast<const char *>(cursor), idLength), slot, quantity,
+                              costCents);
+    }
+    cursor += idLength;
+  }
+  return true;
+}
+
+/**
+ * ReplayLog - Apply the changes logged after the snapshot
+ *
+ * Returns false if there is no log for the current generation (it was
+ * already folded into the snapshot). A torn record left by a crash ends
+ * the replay and is cut off so that new records line up again. A whole
+ * record that names an unknown slot or type is skipped. Every record
+ * carries its payload length, so the changes after it are still replayed.
+ */
+bool ConsumableRepository::replayLog(UsageStore &usage)
+{
+  MappedFile log(logPath);
+  LogHeader header;
+  if (log.getSize() < sizeof(header))
+  {
+    return false;
+  }
+  std::memcpy(&header, log.getData(), sizeof(header));
+  if (std::memcmp(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 || header.version < LOG_VERSION_NO_PAYLOAD ||
+      header.version > LOG_VERSION || header.generation != generation)
+  {
+    return false;
+  }
+
+  std::size_t position = sizeof(header);
+  std::size_t skipped = 0;
+  while (log.getSize() - position >= LOG_RECORD_SIZE)
+  {
+    const unsigned char *in = log.getData() + position;
+    std::uint8_t type = InventoryFormat::load<std::uint8_t>(in);
+    in += 1;
+    std::uint16_t extraLength = InventoryFormat::load<std::uint16_t>(in);
+    std::uint32_t slot = InventoryFormat::load<std::uint32_t>(in);
+    std::int32_t quantity = InventoryFormat::load<std::int32_t>(in);
+    std::uint32_t detail = InventoryFormat::load<std::uint32_t>(in);
+    std::int64_t timestamp = InventoryFormat::load<std::int64_t>(in);
+
+    if (type == RECORD_END || log.getSize() - position - LOG_RECORD_SIZE < extraLength)
+    {
+      break;
+    }
+    std::size_t recordSize = LOG_RECORD_SIZE + extraLength;
+    bool orderUsageValid = type == RECORD_ORDER_USAGE && extraLength >= 8 && detail <= extraLength - 8u;
+    if ((type != RECORD_USAGE && type != RECORD_STOCK && !orderUsageValid) || slot >= records.size())
+    {
+      skipped++;
+      position += recordSize;
+      continue;
+    }
+    if (type == RECORD_STOCK)
+    {
+      records[slot].stock += quantity;
+    }
+    else
+    {
+      records[slot].stock -= quantity;
+      usage.recordRollup(records[slot].name, quantity, timestamp);
+    }
+    if (type == RECORD_ORDER_USAGE)
+    {
+      std::int64_t costCents = InventoryFormat::load<std::int64_t>(in);
+      orderUsage.emplace_back(std::string(reinterpret_cast<const char *>(in), detail), slot, quantity, costCents);
+    }
+    position += recordSize;
+    loggedSinceSnapshot++;
+  }
+
+  if (skipped > 0 && display)
+  {
+    display->log(LogLevel::WARNING, "Warning: Skipped {} unreadable inventory log record(s).", skipped);
+  }
+
+  if (position < log.getSize() && ::truncate(logPath.c_str(), static_cast<off_t>(position)) != 0)
+  {
+    return false;
+  }
+  return true;
+}
+
+bool ConsumableRepository::openLog(bool truncate)
+{
+  closeLog();
+
+  int flags = O_WRONLY | O_CREAT | O_APPEND | (truncate ? O_TRUNC : 0);
+  logDescriptor = ::open(logPath.c_str(), flags, 0644);
+  if (logDescriptor < 0)
+  {
+    if (display)
+    {
+      display->log(LogLevel::ERROR, "Error: Could not open inventory log: {}", logPath);
+    }
+    return false;
+  }
+
+  if (truncate)
+  {
+    LogHeader header;
+    std::memcpy(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+    header.version = LOG_VERSION;
+    header.generation = generation;
+    if (!writeAll(logDescriptor, reinterpret_cast<const unsigned char *>(&header), sizeof(header)))
+    {
+      closeLog();
+      return false;
+    }
+    loggedSinceSnapshot = 0;
+  }
+  return true;
+}
+
+void ConsumableRepository::closeLog()
+{
+  if (logDescriptor >= 0)
+  {
+    ::close(logDescriptor);
+    logDescriptor = -1;
+  }
+}
+
+bool ConsumableRepository::bind(const Consumable *consumable)
+{
+  const std::string &id = consumable->getConsumableID();
+  long long stock = consumable->getCurrentStock();
+
+  auto it = slotById.find(id);
+  if (it == slotById.end())
+  {
+    it = slotById.emplace(id, static_cast<std::uint32_t>(records.size())).first;
+    records.emplace_back(id, consumable->getName(), consumable->getUnitOfMeasure(), stock,
+                         consumable->getUnitCostCents());
+    slotByConsumable[consumable] = it->second;
+    return true;
+  }
+
+  // The live object is the source of truth from now on
+  slotByConsumable[consumable] = it->second;
+  ConsumableRecord &record = records[it->second];
+  bool changed = record.stock != stock || record.name != consumable->getName() ||
+                 record.unitOfMeasure != consumable->getUnitOfMeasure() ||
+                 record.unitCostCents != consumable->getUnitCostCents();
+  record.name = consumable->getName();
+  record.unitOfMeasure = consumable->getUnitOfMeasure();
+  record.stock = stock;
+  record.unitCostCents = consumable->getUnitCostCents();
+  return changed;
+}
+
+// Returns where the record's payload (extraLength bytes, zero-filled) starts
+static unsigned char *appendRecord(std::vector<unsigned char> &pending, std::uint8_t type, std::uint32_t slot,
+                                   int quantity, std::int64_t timestamp, std::uint32_t detail = 0,
+                                   std::uint16_t extraLength = 0)
+{
+  std::size_t offset = pending.size();
+  pending.resize(offset + LOG_RECORD_SIZE + extraLength, 0);
+  unsigned char *out = pending.data() + offset;
+  store<std::uint8_t>(out, type);
+  store<std::uint8_t>(out, 0);
+  store<std::uint16_t>(out, extraLength);
+  store<std::uint32_t>(out, slot);
+  store<std::int32_t>(out, quantity);
+  store<std::uint32_t>(out, detail);
+  store<std::int64_t>(out, timestamp);
+  return out;
+}
+
+void ConsumableRepository::logUsage(const Consumable *consumable, int quantity, std::int64_t timestamp,
+                                    const std::string &orderID, long long costCents)
+{
+  auto it = slotByConsumable.find(consumable);
+  if (it == slotByConsumable.end())
+  {
+    return;
+  }
+  records[it->second].stock -= quantity;
+  if (!orderID.empty())
+  {
+    orderUsage.emplace_back(orderID, it->second, quantity, costCents);
+  }
+  if (it->second >= snapshotSlots)
+  {
+    return;
+  }
+
+  if (orderID.empty())
+  {
+    appendRecord(pending, RECORD_USAGE, it->second, quantity, timestamp);
+  }
+  else
+  {
+    std::size_t payload = 8 + orderID.size();
+    payload = (payload + LOG_PAYLOAD_ALIGNMENT - 1) / LOG_PAYLOAD_ALIGNMENT * LOG_PAYLOAD_ALIGNMENT;
+    unsigned char *out = appendRecord(pending, RECORD_ORDER_USAGE, it->second, quantity, timestamp,
+                                      static_cast<std::uint32_t>(orderID.size()),
+                                      static_cast<std::uint16_t>(payload));
+    store<std::int64_t>(out, costCents);
+    std::memcpy(out, orderID.data(), orderID.size());
+  }
+  pendingRecords++;
+}
+
+void ConsumableRepository::logStockChange(const Consumable *consumable, int quantity)
+{
+  auto it = slotByConsumable.find(consumable);
+  if (it == slotByConsumable.end())
+  {
+    return;
+  }
+  records[it->second].stock += quantity;
+  if (it->second < snapshotSlots)
+  {
+    appendRecord(pending, RECORD_STOCK, it->second, quantity, ConsumableUsage::now());
+    pendingRecords++;
+  }
+}
+
+bool ConsumableRepository::commit()
+{
+  if (pending.empty())
+  {
+    return isSnapshotPending();
+  }
+
+  if (logDescriptor < 0 || !writeAll(logDescriptor, pending.data(), pending.size()))
+  {
+    // The records are still in memory and will be in the next snapshot
+    if (display)
+    {
+      display->log(LogLevel::ERROR, "Error: Could not append to inventory log: {}", logPath);
+    }
+    pending.clear();
+    pendingRecords = 0;
+    return true;
+  }
+
+  loggedSinceSnapshot += pendingRecords;
+  pending.clear();
+  pendingRecords = 0;
+  return loggedSinceSnapshot >= snapshotInterval || isSnapshotPending();
+}
+
+/**
+ * SaveSnapshot - Write all records and usage rollups as a new generation
+ *
+ * The snapshot is written to a temporary file and renamed over the old
+ * one, then the log is restarted for the new generation. A crash at any
+ * point leaves either the old snapshot with its log or the new snapshot,
+ * whose generation makes the old log be ignored.
+ */
+bool ConsumableRepository::saveSnapshot(const UsageStore &usage)
+{
+  std::vector<unsigned char> buffer(sizeof(SnapshotHeader));
+  SnapshotHeader header;
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+  header.version = SNAPSHOT_VERSION;
+  header.generation = generation + 1;
+  header.consumableCount = static_cast<std::uint32_t>(records.size());
+  header.reserved = 0;
+  header.createdAt = ConsumableUsage::now();
+  std::memcpy(buffer.data(), &header, sizeof(header));
+
+  // Unit costs are not logged; take the current ones from the live objects
+  for (const auto &entry : slotByConsumable)
+  {
+    records[entry.second].unitCostCents = entry.first->getUnitCostCents();
+  }
+
+  for (const ConsumableRecord &record : records)
+  {
+    std::size_t offset = buffer.size();
+    buffer.resize(offset + CONSUMABLE_HEADER_SIZE + record.consumableID.size() + record.name.size() +
+                  record.unitOfMeasure.size());
+    unsigned char *out = buffer.data() + offset;
+    store<std::int64_t>(out, record.stock);
+    store<std::int64_t>(out, record.unitCostCents);
+    store<std::uint16_t>(out, static_cast<std::uint16_t>(record.consumableID.size()));
+    store<std::uint16_t>(out, static_cast<std::uint16_t>(record.name.size()));
+    store<std::uint16_t>(out, static_cast<std::uint16_t>(record.unitOfMeasure.size()));
+    store<std::uint16_t>(out, 0);
+    for (const std::string *text : {&record.consumableID, &record.name, &record.unitOfMeasure})
+    {
+      std::memcpy(out, text->data(), text->size());
+      out += text->size();
+    }
+  }
+
+  std::size_t offset = buffer.size();
+  buffer.resize(offset + 8);
+  unsigned char *out = buffer.data() + offset;
+  store<std::uint32_t>(out, static_cast<std::uint32_t>(orderUsage.size()));
+  store<std::uint32_t>(out, 0);
+  for (const OrderUsageRecord &entry : orderUsage)
+  {
+    offset = buffer.size();
+    buffer.resize(offset + ORDER_USAGE_HEADER_SIZE + entry.orderID.size());
+    out = buffer.data() + offset;
+    store<std::uint32_t>(out, entry.slot);
+    store<std::int32_t>(out, entry.quantity);
+    store<std::int64_t>(out, entry.costCents);
+    store<std::uint16_t>(out, static_cast<std::uint16_t>(entry.orderID.size()));
+    store<std::uint16_t>(out, 0);
+    std::memcpy(out, entry.orderID.data(), entry.orderID.size());
+  }
+  usage.serialize(buffer);
+
+  std::string temporaryPath = snapshotPath + ".tmp";
+  int descriptor = ::open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  bool written = descriptor >= 0 && writeAll(descriptor, buffer.data(), buffer.size()) &&
+                 ::fsync(descriptor) == 0;
+  if (descriptor >= 0)
+  {
+    ::close(descriptor);
+  }
+  if (!written || std::rename(temporaryPath.c_str(), snapshotPath.c_str()) != 0)
+  {
+    std::remove(temporaryPath.c_str());
+    if (display)
+    {
+      display->log(LogLevel::ERROR, "Error: Could not write inventory snapshot: {}", snapshotPath);
+    }
+    return false;
+  }
+
+  generation++;
+  snapshotSlots = header.consumableCount;
+  pending.clear(); // Already part of the snapshot
+  pendingRecords = 0;
+  return openLog(true);
+}
+
+int ConsumableRepository::getCount() const
+{
+  return static_cast<int>(records.size());
+}
+
+const ConsumableRecord &ConsumableRepository::getAt(int index) const
+{
+  if (index < 0 || index >= static_cast<int>(records.size()))
+  {
+    throw DataNotFoundException(
+        "Consumable record not found",
+        "Index out of range: " + std::to_string(index));
+  }
+  return records[index];
+}
+
+const std::vector<OrderUsageRecord> &ConsumableRepository::getOrderUsage() const
+{
+  return orderUsage;
+}
+
+std::uint32_t ConsumableRepository::getGeneration() const
+{
+  return generation;
+}
+
+std::size_t ConsumableRepository::getLoggedSinceSnapshot() const
+{
+  return loggedSinceSnapshot;
+}
+
+bool ConsumableRepository::isSnapshotPending() const
+{
+  return snapshotSlots < records.size();
+}
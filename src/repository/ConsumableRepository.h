@@ -0,0 +1,102 @@
+#ifndef CONSUMABLE_REPOSITORY_H
+#define CONSUMABLE_REPOSITORY_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "entities/Consumable.h"
+#include "interfaces/IDisplay.h"
+#include "repository/ConsumableRecord.h"
+#include "repository/UsageStore.h"
+
+/**
+ * ConsumableRepository - Persistent inventory and usage rollups
+ *
+ * State lives in a binary snapshot plus an append-only log of the stock
+ * changes made since (see InventoryFormat.h). Every usage or restock
+ * appends one fixed-size record; after snapshotInterval records the
+ * snapshot is rewritten and the log starts over. Loading maps both files,
+ * reads the snapshot and replays at most snapshotInterval records, so it
+ * takes the same time however much usage has been recorded.
+ *
+ * The snapshot holds the usage totals and rollups, not individual usage
+ * records, so usage IDs and the raw usage tail do not survive a restart.
+ * Usage charged to an order is the exception: each one is kept with the
+ * order's ID, in the log and then in every snapshot, so the material cost
+ * of an order survives a restart (see getOrderUsage).
+ *
+ * Log records refer to snapshot slots. Changes to a consumable added
+ * since the last snapshot are therefore not logged. They are kept in
+ * memory, and commit() reports a snapshot as due until one succeeds.
+ *
+ * Not thread-safe: ConsumableManager calls it under its usage lock.
+ */
+class ConsumableRepository
+{
+public:
+  static const std::size_t DEFAULT_SNAPSHOT_INTERVAL = 4096;
+
+private:
+  std::string snapshotPath;
+  std::string logPath;
+  const IDisplay *display;
+  std::size_t snapshotInterval;
+
+  std::vector<ConsumableRecord> records; // Snapshot slot order
+  std::unordered_map<std::string, std::uint32_t> slotById;
+  std::unordered_map<const Consumable *, std::uint32_t> slotByConsumable;
+  std::vector<OrderUsageRecord> orderUsage; // In the order it was recorded
+
+  std::uint32_t generation;
+  std::size_t snapshotSlots; // Records included in the current snapshot
+  int logDescriptor;
+  std::size_t loggedSinceSnapshot;
+  std::vector<unsigned char> pending; // Records not yet written
+  std::size_t pendingRecords;
+
+  bool loadOrderUsage(const unsigned char *&cursor, const unsigned char *end);
+  bool replayLog(UsageStore &usage);
+  bool openLog(bool truncate);
+  void closeLog();
+
+public:
+  ConsumableRepository(const std::string &basePath, const IDisplay *disp = nullptr,
+                       std::size_t recordsPerSnapshot = DEFAULT_SNAPSHOT_INTERVAL);
+  ~ConsumableRepository();
+
+  // Disable copy - owns the log file descriptor
+  ConsumableRepository(const ConsumableRepository &) = delete;
+  ConsumableRepository &operator=(const ConsumableRepository &) = delete;
+
+  // Reads the snapshot and replays the log into the records and usage;
+  // false if there was no stored inventory
+  bool load(UsageStore &usage);
+
+  // Links a live consumable to its stored record; a consumable that is
+  // not stored yet is added and true is returned (a snapshot is needed
+  // before changes to it can be logged)
+  bool bind(const Consumable *consumable);
+
+  // Queue a change; commit() writes everything queued in one append and
+  // returns true when a snapshot is due (including while a consumable
+  // added since the last snapshot is waiting for one). Usage with an
+  // order ID is also kept in the order usage.
+  void logUsage(const Consumable *consumable, int quantity, std::int64_t timestamp,
+                const std::string &orderID = "", long long costCents = 0);
+  void logStockChange(const Consumable *consumable, int quantity);
+  bool commit();
+
+  // Rewrites the snapshot from the records and usage, then starts a new log
+  bool saveSnapshot(const UsageStore &usage);
+
+  int getCount() const;
+  const ConsumableRecord &getAt(int index) const;
+  // Every stored usage charged to an order; slot indexes getAt
+  const std::vector<OrderUsageRecord> &getOrderUsage() const;
+  std::uint32_t getGeneration() const;
+  std::size_t getLoggedSinceSnapshot() const;
+  bool isSnapshotPending() const;
+};
+
+#endif // CONSUMABLE_REPOSITORY_H
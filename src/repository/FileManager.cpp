@@ -106,7 +106,7 @@ bool FileManager::loadFromFile(OrderRepository &repository)
       skippedCount++;
       if (display)
       {
-        display->showLine("Warning: Skipped invalid line in data file.");
+        display->log(LogLevel::WARNING, "Warning: Skipped invalid line in data file.");
       }
     }
   }
@@ -118,7 +118,7 @@ bool FileManager::loadFromFile(OrderRepository &repository)
     display->showLine("Loaded " + std::to_string(loadedCount) + " order(s) from file.");
     if (skippedCount > 0)
     {
-      display->showLine("Skipped " + std::to_string(skippedCount) + " invalid line(s).");
+      display->log(LogLevel::WARNING, "Skipped {} invalid line(s).", skippedCount);
     }
   }
 
@@ -133,7 +133,7 @@ bool FileManager::saveToFile(const OrderRepository &repository)
   {
     if (display)
     {
-      display->showLine("Error: Could not open file for writing: " + filePath);
+      display->log(LogLevel::ERROR, "Error: Could not open file for writing: {}", filePath);
     }
     return false;
   }
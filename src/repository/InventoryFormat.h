@@ -0,0 +1,94 @@
+#ifndef INVENTORY_FORMAT_H
+#define INVENTORY_FORMAT_H
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * InventoryFormat - On-disk layout used by ConsumableRepository
+ *
+ * Inventory is kept in two files next to each other; all values are in
+ * host byte order.
+ *
+ * "<base>.snap" - snapshot, rewritten as a whole
+ *   SnapshotHeader, then consumableCount entries of
+ *     stock(8) unitCostCents(8) idLength(2) nameLength(2) unitLength(2)
+ *     pad(2) bytes
+ *   (version 1 snapshots have no unitCostCents field)
+ *   then orderUsageCount(4) pad(4) and that many order usage entries of
+ *     slot(4) quantity(4) costCents(8) idLength(2) pad(2) order ID bytes
+ *   (not present before version 4)
+ *   then the usage rollups written by UsageStore::serialize (before
+ *   version 3 without the per-consumable min/max/last-used fields).
+ *
+ * "<base>.log" - append-only log of changes since the snapshot
+ *   LogHeader, then records of LOG_RECORD_SIZE bytes:
+ *     type(1) pad(1) extraLength(2) slot(4) quantity(4) detail(4) timestamp(8)
+ *   each followed by extraLength bytes of payload. A RECORD_ORDER_USAGE
+ *   record keeps the order ID length in detail and carries costCents(8)
+ *   and the order ID, zero-padded to a multiple of 8, as its payload.
+ *   slot is the consumable's position in the snapshot. A zero type byte
+ *   or a partial record at the end marks the end of the data; a record
+ *   with an unknown slot or type is skipped. Version 1 logs have no
+ *   payloads (the extraLength bytes are zero) and are read the same way.
+ *
+ * A snapshot of generation G includes every change logged before it, so
+ * on load only a log whose generation equals the snapshot's is replayed.
+ */
+namespace InventoryFormat
+{
+  const char SNAPSHOT_MAGIC[8] = {'P', 'S', 'I', 'N', 'V', 'S', 'N', '1'};
+  const char LOG_MAGIC[8] = {'P', 'S', 'I', 'N', 'V', 'L', 'G', '1'};
+  const std::uint32_t SNAPSHOT_VERSION = 4;
+  const std::uint32_t SNAPSHOT_VERSION_NO_ORDERS = 3;    // No order usage section
+  const std::uint32_t SNAPSHOT_VERSION_NO_EXTREMES = 2; // Usage totals without min/max/last used
+  const std::uint32_t SNAPSHOT_VERSION_NO_COST = 1;
+  const std::uint32_t LOG_VERSION = 2;
+  const std::uint32_t LOG_VERSION_NO_PAYLOAD = 1;
+
+  const std::uint8_t RECORD_END = 0;
+  const std::uint8_t RECORD_USAGE = 1; // Stock taken and counted as usage
+  const std::uint8_t RECORD_STOCK = 2; // Stock change (restock or correction)
+  const std::uint8_t RECORD_ORDER_USAGE = 3; // Usage charged to an order
+
+  struct SnapshotHeader
+  {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t generation;
+    std::uint32_t consumableCount;
+    std::uint32_t reserved;
+    std::int64_t createdAt; // Seconds since the Unix epoch
+  };
+
+  struct LogHeader
+  {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t generation;
+  };
+
+  const std::size_t CONSUMABLE_HEADER_SIZE = 24;
+  const std::size_t CONSUMABLE_HEADER_SIZE_NO_COST = 16;
+  const std::size_t ORDER_USAGE_HEADER_SIZE = 20;
+  const std::size_t LOG_RECORD_SIZE = 24;
+  const std::size_t LOG_PAYLOAD_ALIGNMENT = 8;
+
+  template <typename T>
+  inline void store(unsigned char *&out, T value)
+  {
+    std::memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+  }
+
+  template <typename T>
+  inline T load(const unsigned char *&in)
+  {
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+    return value;
+  }
+}
+
+#endif // INVENTORY_FORMAT_H
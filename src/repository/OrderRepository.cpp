@@ -48,6 +48,7 @@ void OrderRepository::add(const OrderRecord &record)
   }
 
   records[count] = record;
+  indexById.emplace(record.orderID, count);
   count++;
 }
 
@@ -82,26 +83,17 @@ const OrderRecord &OrderRepository::getAt(int index) const
 
 bool OrderRepository::existsById(const std::string &orderID) const
 {
-  for (int i = 0; i < count; i++)
-  {
-    if (records[i].orderID == orderID)
-    {
-      return true;
-    }
-  }
-  return false;
+  return indexById.find(orderID) != indexById.end();
 }
 
 int OrderRepository::findIndexById(const std::string &orderID) const
 {
-  for (int i = 0; i < count; i++)
+  auto it = indexById.find(orderID);
+  if (it == indexById.end())
   {
-    if (records[i].orderID == orderID)
-    {
-      return i;
-    }
+    return -1;
   }
-  return -1;
+  return it->second;
 }
 
 void OrderRepository::updateAt(int index, const OrderRecord &record)
@@ -113,12 +105,22 @@ void OrderRepository::updateAt(int index, const OrderRecord &record)
         "Index out of bounds: index=" + std::to_string(index) +
             ", count=" + std::to_string(count));
   }
+  if (records[index].orderID != record.orderID)
+  {
+    auto it = indexById.find(records[index].orderID);
+    if (it != indexById.end() && it->second == index)
+    {
+      indexById.erase(it);
+    }
+    indexById.emplace(record.orderID, index);
+  }
   records[index] = record;
 }
 
 void OrderRepository::clear()
 {
   count = 0;
+  indexById.clear();
   // We don't deallocate memory, just reset count
   // This allows reuse without reallocation
 }
@@ -4,6 +4,7 @@
 #include "repository/OrderRecord.h"
 #include "exceptions/PhotoStudioExceptions.h"
 #include <string>
+#include <unordered_map>
 
 /**
  * OrderRepository - Repository with dynamic array
@@ -15,6 +16,8 @@
  * - The current capacity
  *
  * When the array becomes full, capacity is doubled and elements are copied.
+ * An orderID -> index map keeps lookups by ID constant time, so syncing an
+ * order does not rescan the whole array.
  */
 class OrderRepository
 {
@@ -22,6 +25,7 @@ private:
   OrderRecord *records; // Pointer to dynamic array
   int count;            // Current number of elements
   int capacity;         // Current capacity
+  std::unordered_map<std::string, int> indexById; // orderID -> array index
 
   static const int INITIAL_CAPACITY = 4;
 
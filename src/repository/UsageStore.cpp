@@ -0,0 +1,324 @@
+#include "repository/UsageStore.h"
+#include "repository/InventoryFormat.h"
+
+using InventoryFormat::load;
+using InventoryFormat::store;
+
+static const std::size_t SERIES_HEADER_SIZE = 48;
+static const std::size_t SERIES_HEADER_SIZE_NO_EXTREMES = 32;
+static const std::size_t BUCKET_SIZE = 24;
+
+static const std::int64_t MINUTE_SECONDS = 60;
+static const std::int64_t HOUR_SECONDS = 60 * 60;
+static const std::int64_t DAY_SECONDS = 24 * 60 * 60;
+
+UsageStore::UsageStore(std::size_t rawRetentionCount)
+    : rawRetention(rawRetentionCount), recordedCount(0)
+{
+}
+
+std::int64_t UsageStore::bucketStart(std::int64_t timestamp, std::int64_t width)
+{
+  // Floor division so that timestamps before the epoch still round down
+  std::int64_t start = timestamp - timestamp % width;
+  return start > timestamp ? start - width : start;
+}
+
+/**
+ * AddToBuckets - Add one usage to the bucket starting at start
+ *
+ * The newest bucket is almost always the target, so the search starts
+ * from the back. Buckets older than the retained window are dropped.
+ */
+void UsageStore::addToBuckets(std::deque<UsageBucket> &buckets, std::int64_t start,
+                              int quantity, std::size_t limit)
+{
+  auto it = buckets.end();
+  while (it != buckets.begin() && (it - 1)->start > start)
+  {
+    --it;
+  }
+
+  if (it != buckets.begin() && (it - 1)->start == start)
+  {
+    (it - 1)->quantity += quantity;
+    (it - 1)->count++;
+    return;
+  }
+
+  // Late record for a bucket that has already been evicted
+  if (it == buckets.begin() && buckets.size() >= limit)
+  {
+    return;
+  }
+
+  buckets.insert(it, UsageBucket(start, quantity, 1));
+  if (buckets.size() > limit)
+  {
+    buckets.pop_front();
+  }
+}
+
+void UsageStore::reserve(std::size_t consumableCount)
+{
+  seriesIndex.reserve(consumableCount);
+  series.reserve(consumableCount);
+}
+
+const UsageStore::Series *UsageStore::findSeries(const std::string &consumableName) const
+{
+  std::size_t position = seriesIndex.find(consumableName);
+  return position == FlatStringIndex::NOT_FOUND ? nullptr : &series[position];
+}
+
+void UsageStore::recordRollup(const std::string &consumableName, int quantity, std::int64_t timestamp)
+{
+  auto inserted = seriesIndex.insert(consumableName);
+  if (inserted.second)
+  {
+    series.emplace_back();
+    series.back().total.consumableName = consumableName;
+  }
+
+  Series &target = series[inserted.first];
+  target.total.add(quantity, timestamp);
+  addToBuckets(target.minutes, bucketStart(timestamp, MINUTE_SECONDS), quantity, MINUTE_BUCKETS);
+  addToBuckets(target.hours, bucketStart(timestamp, HOUR_SECONDS), quantity, HOUR_BUCKETS);
+  addToBuckets(target.days, bucketStart(timestamp, DAY_SECONDS), quantity, DAY_BUCKETS);
+  recordedCount++;
+}
+
+void UsageStore::record(const ConsumableUsage &usage)
+{
+  recordRollup(usage.getConsumableName(), usage.getQuantityUsed(), usage.getUsedAt());
+
+  if (rawRetention > 0)
+  {
+    if (recent.size() >= rawRetention)
+    {
+      recent.pop_front();
+    }
+    recent.push_back(usage);
+  }
+}
+
+void UsageStore::clear()
+{
+  series.clear();
+  seriesIndex.clear();
+  recent.clear();
+  recordedCount = 0;
+}
+
+/**
+ * Serialize - Append totals and rollups to out
+ *
+ * Layout: seriesCount(4) pad(4) recordedCount(8), then per series
+ *   nameLength(2) pad(2) minutes(4) hours(4) days(4) quantity(8) count(8)
+ *   minQuantity(4) maxQuantity(4) lastUsedAt(8)
+ *   name bytes, then every bucket as start(8) quantity(8) count(4) pad(4)
+ * Snapshots before version 3 have no minQuantity..lastUsedAt fields; their
+ * extremes load as unknown rather than as zero.
+ */
+void UsageStore::serialize(std::vector<unsigned char> &out) const
+{
+  std::size_t bytes = 16;
+  for (const Series &entry : series)
+  {
+    bytes += SERIES_HEADER_SIZE + entry.total.consumableName.size() +
+             BUCKET_SIZE * (entry.minutes.size() + entry.hours.size() + entry.days.size());
+  }
+
+  std::size_t offset = out.size();
+  out.resize(offset + bytes);
+  unsigned char *cursor = out.data() + offset;
+
+  store<std::uint32_t>(cursor, static_cast<std::uint32_t>(series.size()));
+  store<std::uint32_t>(cursor, 0);
+  store<std::uint64_t>(cursor, recordedCount);
+
+  for (const Series &entry : series)
+  {
+    const std::string &name = entry.total.consumableName;
+    store<std::uint16_t>(cursor, static_cast<std::uint16_t>(name.size()));
+    store<std::uint16_t>(cursor, 0);
+    store<std::uint32_t>(cursor, static_cast<std::uint32_t>(entry.minutes.size()));
+    store<std::uint32_t>(cursor, static_cast<std::uint32_t>(entry.hours.size()));
+    store<std::uint32_t>(cursor, static_cast<std::uint32_t>(entry.days.size()));
+    store<std::int64_t>(cursor, entry.total.quantity);
+    store<std::int64_t>(cursor, entry.total.count);
+    store<std::int32_t>(cursor, entry.total.minQuantity);
+    store<std::int32_t>(cursor, entry.total.maxQuantity);
+    store<std::int64_t>(cursor, entry.total.lastUsedAt);
+    std::memcpy(cursor, name.data(), name.size());
+    cursor += name.size();
+
+    for (const std::deque<UsageBucket> *buckets : {&entry.minutes, &entry.hours, &entry.days})
+    {
+      for (const UsageBucket &bucket : *buckets)
+      {
+        store<std::int64_t>(cursor, bucket.start);
+        store<std::int64_t>(cursor, bucket.quantity);
+        store<std::int32_t>(cursor, bucket.count);
+        store<std::int32_t>(cursor, 0);
+      }
+    }
+  }
+}
+
+bool UsageStore::deserialize(const unsigned char *data, std::size_t size, bool withExtremes)
+{
+  std::size_t headerSize = withExtremes ? SERIES_HEADER_SIZE : SERIES_HEADER_SIZE_NO_EXTREMES;
+  clear();
+  const unsigned char *cursor = data;
+  const unsigned char *end = data + size;
+
+  if (size < 16)
+  {
+    return false;
+  }
+  std::uint32_t seriesCount = load<std::uint32_t>(cursor);
+  cursor += 4;
+  std::uint64_t recorded = load<std::uint64_t>(cursor);
+
+  const std::size_t limits[] = {MINUTE_BUCKETS, HOUR_BUCKETS, DAY_BUCKETS};
+  seriesIndex.reserve(seriesCount < 4096 ? seriesCount : 4096);
+  for (std::uint32_t i = 0; i < seriesCount; i++)
+  {
+    if (static_cast<std::size_t>(end - cursor) < headerSize)
+    {
+      clear();
+      return false;
+    }
+    std::uint16_t nameLength = load<std::uint16_t>(cursor);
+    cursor += 2;
+    std::uint32_t counts[3];
+    for (std::uint32_t &count : counts)
+    {
+      count = load<std::uint32_t>(cursor);
+    }
+    Series entry;
+    entry.total.quantity = load<std::int64_t>(cursor);
+    entry.total.count = load<std::int64_t>(cursor);
+    if (withExtremes)
+    {
+      entry.total.minQuantity = load<std::int32_t>(cursor);
+      entry.total.maxQuantity = load<std::int32_t>(cursor);
+      entry.total.lastUsedAt = load<std::int64_t>(cursor);
+    }
+    else
+    {
+      entry.total.forgetExtremes();
+    }
+
+    std::size_t bucketBytes = BUCKET_SIZE * (static_cast<std::size_t>(counts[0]) + counts[1] + counts[2]);
+    if (static_cast<std::size_t>(end - cursor) < nameLength + bucketBytes ||
+        counts[0] > limits[0] || counts[1] > limits[1] || counts[2] > limits[2])
+    {
+      clear();
+      return false;
+    }
+    entry.total.consumableName.assign(reinterpret_cast<const char *>(cursor), nameLength);
+    cursor += nameLength;
+
+    std::deque<UsageBucket> *targets[] = {&entry.minutes, &entry.hours, &entry.days};
+    for (int level = 0; level < 3; level++)
+    {
+      for (std::uint32_t b = 0; b < counts[level]; b++)
+      {
+        UsageBucket bucket;
+        bucket.start = load<std::int64_t>(cursor);
+        bucket.quantity = load<std::int64_t>(cursor);
+        bucket.count = load<std::int32_t>(cursor);
+        cursor += 4;
+        targets[level]->push_back(bucket);
+      }
+    }
+
+    if (!withExtremes && !entry.days.empty())
+    {
+      // Older data: the newest day bucket is the best known last use
+      entry.total.lastUsedAt = entry.days.back().start;
+    }
+
+    if (!seriesIndex.insert(entry.total.consumableName).second)
+    {
+      clear();
+      return false;
+    }
+    series.push_back(std::move(entry));
+  }
+
+  recordedCount = recorded;
+  return true;
+}
+
+std::vector<UsageTotal> UsageStore::getTotals() const
+{
+  std::vector<UsageTotal> totals;
+  totals.reserve(series.size());
+  for (const Series &entry : series)
+  {
+    totals.push_back(entry.total);
+  }
+  return totals;
+}
+
+long long UsageStore::getTotalQuantity(const std::string &consumableName) const
+{
+  const Series *entry = findSeries(consumableName);
+  return entry ? entry->total.quantity : 0;
+}
+
+std::vector<UsageBucket> UsageStore::getHistory(const std::string &consumableName, UsageGranularity granularity,
+                                                std::int64_t from, std::int64_t to) const
+{
+  std::vector<UsageBucket> result;
+  const Series *entry = findSeries(consumableName);
+  if (!entry)
+  {
+    return result;
+  }
+
+  const std::deque<UsageBucket> *buckets = &entry->days;
+  std::int64_t width = DAY_SECONDS;
+  if (granularity == UsageGranularity::MINUTE)
+  {
+    buckets = &entry->minutes;
+    width = MINUTE_SECONDS;
+  }
+  else if (granularity == UsageGranularity::HOUR)
+  {
+    buckets = &entry->hours;
+    width = HOUR_SECONDS;
+  }
+
+  for (const UsageBucket &bucket : *buckets)
+  {
+    if (bucket.start + width > from && bucket.start < to)
+    {
+      result.push_back(bucket);
+    }
+  }
+  return result;
+}
+
+const std::deque<ConsumableUsage> &UsageStore::getRecentUsage() const
+{
+  return recent;
+}
+
+std::uint64_t UsageStore::getRecordedCount() const
+{
+  return recordedCount;
+}
+
+std::size_t UsageStore::getBucketCount() const
+{
+  std::size_t count = 0;
+  for (const Series &entry : series)
+  {
+    count += entry.minutes.size() + entry.hours.size() + entry.days.size();
+  }
+  return count;
+}
@@ -0,0 +1,146 @@
+#ifndef USAGE_STORE_H
+#define USAGE_STORE_H
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <string>
+#include <vector>
+#include "entities/ConsumableUsage.h"
+#include "types/FlatStringIndex.h"
+
+enum class UsageGranularity
+{
+  MINUTE,
+  HOUR,
+  DAY
+};
+
+/**
+ * UsageBucket - Usage of one consumable within one time bucket
+ */
+struct UsageBucket
+{
+  std::int64_t start; // Bucket start, seconds since the Unix epoch
+  long long quantity;
+  int count;
+
+  UsageBucket() : start(0), quantity(0), count(0) {}
+  UsageBucket(std::int64_t s, long long qty, int n) : start(s), quantity(qty), count(n) {}
+};
+
+/**
+ * UsageTotal - All-time usage of one consumable
+ */
+struct UsageTotal
+{
+  std::string consumableName;
+  long long quantity;
+  long long count;
+  int minQuantity; // Smallest and largest single usage; min > max when unknown
+  int maxQuantity;
+  std::int64_t lastUsedAt; // Latest usage time, seconds since the Unix epoch
+
+  UsageTotal() : quantity(0), count(0), minQuantity(0), maxQuantity(0), lastUsedAt(0) {}
+
+  // Older snapshots did not keep the extremes; later usage narrows them again
+  void forgetExtremes()
+  {
+    minQuantity = std::numeric_limits<int>::max();
+    maxQuantity = std::numeric_limits<int>::min();
+  }
+
+  bool hasExtremes() const { return minQuantity <= maxQuantity; }
+
+  void add(int usedQuantity, std::int64_t usedAt)
+  {
+    if (count == 0 || usedQuantity < minQuantity)
+    {
+      minQuantity = usedQuantity;
+    }
+    if (count == 0 || usedQuantity > maxQuantity)
+    {
+      maxQuantity = usedQuantity;
+    }
+    if (count == 0 || usedAt > lastUsedAt)
+    {
+      lastUsedAt = usedAt;
+    }
+    quantity += usedQuantity;
+    count++;
+  }
+};
+
+/**
+ * UsageStore - Consumable usage rolled up into time buckets
+ *
+ * Instead of keeping every ConsumableUsage forever, each consumable has
+ * running totals plus per-minute, per-hour and per-day counters. Every
+ * rollup keeps a fixed number of its most recent buckets, and only the
+ * last rawRetention individual usage records are kept, so memory stays
+ * flat however long the studio runs. Queries and reports cost
+ * O(buckets) or O(consumables), never O(usage records).
+ *
+ * Records normally arrive in time order; a late record still lands in
+ * its bucket as long as that bucket is within the retained window.
+ */
+class UsageStore
+{
+public:
+  static const std::size_t MINUTE_BUCKETS = 24 * 60; // One day
+  static const std::size_t HOUR_BUCKETS = 24 * 90;   // Ninety days
+  static const std::size_t DAY_BUCKETS = 366 * 5;    // Five years
+  static const std::size_t DEFAULT_RAW_RETENTION = 1000;
+
+private:
+  struct Series
+  {
+    UsageTotal total;
+    std::deque<UsageBucket> minutes;
+    std::deque<UsageBucket> hours;
+    std::deque<UsageBucket> days;
+  };
+
+  std::vector<Series> series; // In order of first use
+  FlatStringIndex seriesIndex; // Name -> position in series
+  std::deque<ConsumableUsage> recent;
+  std::size_t rawRetention;
+  std::uint64_t recordedCount;
+
+  static void addToBuckets(std::deque<UsageBucket> &buckets, std::int64_t start,
+                           int quantity, std::size_t limit);
+  static std::int64_t bucketStart(std::int64_t timestamp, std::int64_t width);
+  const Series *findSeries(const std::string &consumableName) const;
+
+public:
+  explicit UsageStore(std::size_t rawRetentionCount = DEFAULT_RAW_RETENTION);
+
+  // Sizes the name index for this many consumables
+  void reserve(std::size_t consumableCount);
+
+  void record(const ConsumableUsage &usage);
+  // Counts usage in the totals and rollups only (replaying a usage log)
+  void recordRollup(const std::string &consumableName, int quantity, std::int64_t timestamp);
+
+  // Totals and rollups in the snapshot layout described in InventoryFormat.h;
+  // raw records are not included. deserialize replaces the current contents
+  // and returns false (leaving the store empty) if the data is malformed;
+  // data written before min/max/last-used were kept has withExtremes false.
+  void serialize(std::vector<unsigned char> &out) const;
+  bool deserialize(const unsigned char *data, std::size_t size, bool withExtremes = true);
+  void clear();
+
+  // Totals per consumable, in order of first use
+  std::vector<UsageTotal> getTotals() const;
+  long long getTotalQuantity(const std::string &consumableName) const;
+
+  // Buckets overlapping [from, to), oldest first
+  std::vector<UsageBucket> getHistory(const std::string &consumableName, UsageGranularity granularity,
+                                      std::int64_t from, std::int64_t to) const;
+
+  const std::deque<ConsumableUsage> &getRecentUsage() const;
+  std::uint64_t getRecordedCount() const;
+  std::size_t getBucketCount() const;
+};
+
+#endif // USAGE_STORE_H
@@ -0,0 +1,146 @@
+#ifndef FLAT_STRING_INDEX_H
+#define FLAT_STRING_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * FlatStringIndex - Open-addressing hash index from strings to dense IDs
+ *
+ * Each distinct key gets the next ID (0, 1, 2, ...), so callers keep
+ * their per-key data in a plain vector indexed by ID. The table is one
+ * flat array of (hash, ID) slots probed linearly and kept at most half
+ * full; the full hash is compared before the key, so a lookup usually
+ * touches one cache line and one string. reserve() sizes the table for
+ * an expected number of keys up front so that aggregation never rehashes.
+ *
+ * Keys cannot be removed individually; clear() drops them all.
+ */
+class FlatStringIndex
+{
+public:
+  static const std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+
+private:
+  struct Slot
+  {
+    std::size_t hash;
+    std::uint32_t idPlusOne; // 0 = empty
+  };
+
+  std::vector<Slot> slots; // Power-of-two size
+  std::vector<std::string> keys;
+
+  static std::size_t hashOf(const std::string &key)
+  {
+    return std::hash<std::string>()(key);
+  }
+
+  std::size_t probe(const std::string &key, std::size_t hash) const
+  {
+    std::size_t mask = slots.size() - 1;
+    std::size_t position = hash & mask;
+    while (slots[position].idPlusOne != 0 &&
+           (slots[position].hash != hash || keys[slots[position].idPlusOne - 1] != key))
+    {
+      position = (position + 1) & mask;
+    }
+    return position;
+  }
+
+  void rehash(std::size_t slotCount)
+  {
+    std::vector<Slot> old(slotCount, Slot{0, 0});
+    old.swap(slots);
+    std::size_t mask = slots.size() - 1;
+    for (const Slot &slot : old)
+    {
+      if (slot.idPlusOne != 0)
+      {
+        std::size_t position = slot.hash & mask;
+        while (slots[position].idPlusOne != 0)
+        {
+          position = (position + 1) & mask;
+        }
+        slots[position] = slot;
+      }
+    }
+  }
+
+public:
+  explicit FlatStringIndex(std::size_t expectedKeys = 0)
+  {
+    reserve(expectedKeys);
+  }
+
+  // Makes room for expectedKeys keys without further rehashing
+  void reserve(std::size_t expectedKeys)
+  {
+    std::size_t slotCount = 8;
+    while (slotCount < expectedKeys * 2)
+    {
+      slotCount *= 2;
+    }
+    if (slotCount > slots.size())
+    {
+      rehash(slotCount);
+    }
+    keys.reserve(expectedKeys);
+  }
+
+  std::size_t find(const std::string &key) const
+  {
+    const Slot &slot = slots[probe(key, hashOf(key))];
+    return slot.idPlusOne == 0 ? NOT_FOUND : slot.idPlusOne - 1;
+  }
+
+  // Returns the key's ID and whether it was added by this call
+  std::pair<std::size_t, bool> insert(const std::string &key)
+  {
+    std::size_t hash = hashOf(key);
+    std::size_t position = probe(key, hash);
+    if (slots[position].idPlusOne != 0)
+    {
+      return std::make_pair(static_cast<std::size_t>(slots[position].idPlusOne - 1), false);
+    }
+
+    if ((keys.size() + 1) * 2 > slots.size())
+    {
+      rehash(slots.size() * 2);
+      position = probe(key, hash);
+    }
+    keys.push_back(key);
+    slots[position] = Slot{hash, static_cast<std::uint32_t>(keys.size())};
+    return std::make_pair(keys.size() - 1, true);
+  }
+
+  const std::string &getKey(std::size_t id) const
+  {
+    return keys[id];
+  }
+
+  std::size_t size() const
+  {
+    return keys.size();
+  }
+
+  std::size_t getSlotCount() const
+  {
+    return slots.size();
+  }
+
+  void clear()
+  {
+    for (Slot &slot : slots)
+    {
+      slot = Slot{0, 0};
+    }
+    keys.clear();
+  }
+};
+
+#endif // FLAT_STRING_INDEX_H
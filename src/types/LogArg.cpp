@@ -0,0 +1,87 @@
+#include "types/LogArg.h"
+#include <cstdio>
+#include <cstdlib>
+
+static void appendArg(std::string &out, const LogArg &arg, int precision)
+{
+  char number[64];
+  switch (arg.getKind())
+  {
+  case LogArg::Kind::INTEGER:
+    std::snprintf(number, sizeof(number), "%lld", arg.getInteger());
+    out += number;
+    break;
+  case LogArg::Kind::UNSIGNED:
+    std::snprintf(number, sizeof(number), "%llu", arg.getUnsigned());
+    out += number;
+    break;
+  case LogArg::Kind::REAL:
+    std::snprintf(number, sizeof(number), "%.*f", precision < 0 ? 6 : precision, arg.getReal());
+    out += number;
+    break;
+  case LogArg::Kind::BOOLEAN:
+    out += arg.getBoolean() ? "true" : "false";
+    break;
+  case LogArg::Kind::TEXT:
+    out += arg.getText();
+    break;
+  }
+}
+
+std::string formatLogMessage(const char *format, const LogArg *args, std::size_t count)
+{
+  std::string out;
+  out.reserve(64);
+  std::size_t next = 0;
+
+  for (const char *p = format; *p; p++)
+  {
+    if (*p == '{' && p[1] == '{')
+    {
+      out += '{';
+      p++;
+      continue;
+    }
+    if (*p == '}' && p[1] == '}')
+    {
+      out += '}';
+      p++;
+      continue;
+    }
+    if (*p != '{')
+    {
+      out += *p;
+      continue;
+    }
+
+    // Placeholder: "{}" or "{:.Nf}"
+    const char *close = p + 1;
+    while (*close && *close != '}')
+    {
+      close++;
+    }
+    if (!*close)
+    {
+      out += p; // Unterminated - copy the rest as is
+      break;
+    }
+
+    int precision = -1;
+    if (p[1] == ':' && p[2] == '.')
+    {
+      precision = std::atoi(p + 3);
+    }
+
+    if (next < count)
+    {
+      appendArg(out, args[next++], precision);
+    }
+    else
+    {
+      out += "{?}";
+    }
+    p = close;
+  }
+
+  return out;
+}
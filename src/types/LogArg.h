@@ -0,0 +1,73 @@
+#ifndef LOG_ARG_H
+#define LOG_ARG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * LogArg - One argument of a deferred display message
+ *
+ * Captures a number, flag or string view by value in a few bytes, without
+ * allocating. Text arguments point at the caller's string, so a LogArg is
+ * only valid for the duration of the IDisplay::log call that created it.
+ */
+class LogArg
+{
+public:
+  enum class Kind : std::uint8_t
+  {
+    INTEGER,
+    UNSIGNED,
+    REAL,
+    BOOLEAN,
+    TEXT
+  };
+
+private:
+  Kind kind;
+  union
+  {
+    long long integer;
+    unsigned long long unsignedInteger;
+    double real;
+    bool boolean;
+    struct
+    {
+      const char *data;
+      std::size_t size;
+    } text;
+  };
+
+public:
+  LogArg(int value) : kind(Kind::INTEGER), integer(value) {}
+  LogArg(long value) : kind(Kind::INTEGER), integer(value) {}
+  LogArg(long long value) : kind(Kind::INTEGER), integer(value) {}
+  LogArg(unsigned value) : kind(Kind::UNSIGNED), unsignedInteger(value) {}
+  LogArg(unsigned long value) : kind(Kind::UNSIGNED), unsignedInteger(value) {}
+  LogArg(unsigned long long value) : kind(Kind::UNSIGNED), unsignedInteger(value) {}
+  LogArg(double value) : kind(Kind::REAL), real(value) {}
+  LogArg(bool value) : kind(Kind::BOOLEAN), boolean(value) {}
+  LogArg(const char *value) : kind(Kind::TEXT), text{value, std::char_traits<char>::length(value)} {}
+  LogArg(const std::string &value) : kind(Kind::TEXT), text{value.data(), value.size()} {}
+  LogArg(std::string_view value) : kind(Kind::TEXT), text{value.data(), value.size()} {}
+
+  Kind getKind() const { return kind; }
+  long long getInteger() const { return integer; }
+  unsigned long long getUnsigned() const { return unsignedInteger; }
+  double getReal() const { return real; }
+  bool getBoolean() const { return boolean; }
+  std::string_view getText() const { return std::string_view(text.data, text.size); }
+};
+
+/**
+ * FormatLogMessage - Expand a deferred message into text
+ *
+ * Each "{}" in the format is replaced by the next argument. Reals print
+ * like std::to_string unless a precision is given ("{:.2f}"). "{{" and
+ * "}}" produce literal braces. Missing arguments print as "{?}".
+ */
+std::string formatLogMessage(const char *format, const LogArg *args, std::size_t count);
+
+#endif // LOG_ARG_H
@@ -0,0 +1,208 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/**
+ * SmallVector - Vector with inline storage for the first N elements
+ *
+ * Elements are stored by value. The first N live in a buffer inside the
+ * object itself, so small collections need no heap allocation and are
+ * contiguous with their owner. Only when more than N elements are added
+ * is the storage moved to a heap block whose capacity doubles as it grows.
+ *
+ * Iterators are plain pointers and are invalidated by growth, as with
+ * std::vector.
+ */
+template <typename T, std::size_t N>
+class SmallVector
+{
+private:
+  alignas(T) unsigned char inlineBuffer[N * sizeof(T)];
+  T *elements;          // Points to inlineBuffer or to the heap block
+  std::size_t count;    // Number of constructed elements
+  std::size_t capacity; // N while inline, heap capacity after spilling
+
+  T *inlineData()
+  {
+    return reinterpret_cast<T *>(inlineBuffer);
+  }
+
+  bool isInline() const
+  {
+    return elements == reinterpret_cast<const T *>(inlineBuffer);
+  }
+
+  // Moves the elements into newElements, a heap block of newCapacity elements
+  void relocate(T *newElements, std::size_t newCapacity)
+  {
+    for (std::size_t i = 0; i < count; i++)
+    {
+      new (&newElements[i]) T(std::move(elements[i]));
+      elements[i].~T();
+    }
+
+    if (!isInline())
+    {
+      ::operator delete(elements);
+    }
+
+    elements = newElements;
+    capacity = newCapacity;
+  }
+
+  void grow(std::size_t newCapacity)
+  {
+    relocate(static_cast<T *>(::operator new(newCapacity * sizeof(T))), newCapacity);
+  }
+
+  void release()
+  {
+    clear();
+    if (!isInline())
+    {
+      ::operator delete(elements);
+    }
+    elements = inlineData();
+    capacity = N;
+  }
+
+public:
+  SmallVector() : elements(inlineData()), count(0), capacity(N) {}
+
+  ~SmallVector()
+  {
+    release();
+  }
+
+  SmallVector(const SmallVector &other) : elements(inlineData()), count(0), capacity(N)
+  {
+    reserve(other.count);
+    for (std::size_t i = 0; i < other.count; i++)
+    {
+      push_back(other.elements[i]);
+    }
+  }
+
+  SmallVector(SmallVector &&other) : elements(inlineData()), count(0), capacity(N)
+  {
+    *this = std::move(other);
+  }
+
+  SmallVector &operator=(const SmallVector &other)
+  {
+    if (this != &other)
+    {
+      clear();
+      reserve(other.count);
+      for (std::size_t i = 0; i < other.count; i++)
+      {
+        push_back(other.elements[i]);
+      }
+    }
+    return *this;
+  }
+
+  SmallVector &operator=(SmallVector &&other)
+  {
+    if (this == &other)
+    {
+      return *this;
+    }
+
+    release();
+
+    if (other.isInline())
+    {
+      for (std::size_t i = 0; i < other.count; i++)
+      {
+        new (&elements[i]) T(std::move(other.elements[i]));
+      }
+      count = other.count;
+      other.clear();
+    }
+    else
+    {
+      // Steal the heap block
+      elements = other.elements;
+      count = other.count;
+      capacity = other.capacity;
+      other.elements = other.inlineData();
+      other.count = 0;
+      other.capacity = N;
+    }
+    return *this;
+  }
+
+  void reserve(std::size_t newCapacity)
+  {
+    if (newCapacity > capacity)
+    {
+      grow(newCapacity);
+    }
+  }
+
+  template <typename... Args>
+  T &emplace_back(Args &&...args)
+  {
+    if (count < capacity)
+    {
+      T *slot = new (&elements[count]) T(std::forward<Args>(args)...);
+      count++;
+      return *slot;
+    }
+
+    // The arguments may refer to an element (v.push_back(v[0])), so the new
+    // element is built in the new block before the old ones are moved out
+    std::size_t newCapacity = capacity > 0 ? capacity * 2 : 1;
+    T *newElements = static_cast<T *>(::operator new(newCapacity * sizeof(T)));
+    T *slot;
+    try
+    {
+      slot = new (&newElements[count]) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      ::operator delete(newElements);
+      throw;
+    }
+    relocate(newElements, newCapacity);
+    count++;
+    return *slot;
+  }
+
+  void push_back(const T &value)
+  {
+    emplace_back(value);
+  }
+
+  void push_back(T &&value)
+  {
+    emplace_back(std::move(value));
+  }
+
+  void clear()
+  {
+    for (std::size_t i = 0; i < count; i++)
+    {
+      elements[i].~T();
+    }
+    count = 0;
+  }
+
+  std::size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  bool isHeapAllocated() const { return !isInline(); }
+
+  T &operator[](std::size_t index) { return elements[index]; }
+  const T &operator[](std::size_t index) const { return elements[index]; }
+
+  T *begin() { return elements; }
+  T *end() { return elements + count; }
+  const T *begin() const { return elements; }
+  const T *end() const { return elements + count; }
+};
+
+#endif // SMALL_VECTOR_H
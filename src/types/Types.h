@@ -13,8 +13,17 @@ enum class OrderStatus
 
 enum class ReportType
 {
-  DAILY_REVENUE,
-  CONSUMABLES_USAGE
+  REVENUE_SUMMARY, // All-time totals
+  CONSUMABLES_USAGE,
+  ORDER_MARGIN,
+  PERIOD_REVENUE
+};
+
+enum class RevenuePeriod
+{
+  DAY,
+  WEEK, // Monday to Sunday
+  MONTH
 };
 
 enum class ServiceType
@@ -23,4 +32,14 @@ enum class ServiceType
   FILM_DEVELOPING
 };
 
+// Severity of display messages, lowest first (OFF disables all output)
+enum class LogLevel
+{
+  DEBUG,
+  INFO,
+  WARNING,
+  ERROR,
+  OFF
+};
+
 #endif // TYPES_H
@@ -0,0 +1,102 @@
+#ifndef VALIDATION_RESULT_H
+#define VALIDATION_RESULT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "exceptions/PhotoStudioExceptions.h"
+
+/**
+ * ErrorCode - Failure category of a ValidationResult
+ *
+ * Each code corresponds to one PhotoStudioException subclass.
+ */
+enum class ErrorCode : std::uint8_t
+{
+  NONE,
+  INVALID_DATA,
+  VALIDATION,
+  BUSINESS_RULE,
+  NOT_FOUND,
+  INSUFFICIENT_STOCK,
+  DUPLICATE
+};
+
+/**
+ * ValidationResult - Non-throwing outcome of a try* validation call
+ *
+ * A result is an error code plus pointers to static message text and a
+ * view of the offending value. Nothing is allocated when it is created;
+ * the user and technical messages are put together only when asked for.
+ * The subject view points into the caller's argument, so read the
+ * messages (or call throwIfError) while that argument is still alive.
+ *
+ * The throwing validators are layered on top: they call the try* variant
+ * and then throwIfError(), which raises the matching exception with the
+ * same messages as before.
+ */
+class [[nodiscard]] ValidationResult
+{
+private:
+  ErrorCode code;
+  const char *userText;      // Static text; the subject is appended to it
+  const char *technicalText; // Static text
+  std::string_view subject;
+
+  ValidationResult(ErrorCode c, const char *user, const char *technical, std::string_view subj)
+      : code(c), userText(user), technicalText(technical), subject(subj) {}
+
+public:
+  ValidationResult() : code(ErrorCode::NONE), userText(""), technicalText(""), subject() {}
+
+  static ValidationResult ok()
+  {
+    return ValidationResult();
+  }
+
+  static ValidationResult failure(ErrorCode c, const char *user, const char *technical,
+                                  std::string_view subj = std::string_view())
+  {
+    return ValidationResult(c, user, technical, subj);
+  }
+
+  bool isOk() const { return code == ErrorCode::NONE; }
+  explicit operator bool() const { return isOk(); }
+  ErrorCode getCode() const { return code; }
+
+  std::string getUserMessage() const
+  {
+    std::string message(userText);
+    message.append(subject.data(), subject.size());
+    return message;
+  }
+
+  std::string getTechnicalMessage() const
+  {
+    return technicalText;
+  }
+
+  void throwIfError() const
+  {
+    switch (code)
+    {
+    case ErrorCode::NONE:
+      return;
+    case ErrorCode::VALIDATION:
+      throw ValidationException(getUserMessage(), getTechnicalMessage());
+    case ErrorCode::BUSINESS_RULE:
+      throw BusinessRuleException(getUserMessage(), getTechnicalMessage());
+    case ErrorCode::NOT_FOUND:
+      throw DataNotFoundException(getUserMessage(), getTechnicalMessage());
+    case ErrorCode::INSUFFICIENT_STOCK:
+      throw InsufficientStockException(getUserMessage(), getTechnicalMessage());
+    case ErrorCode::DUPLICATE:
+      throw DuplicateDataException(getUserMessage(), getTechnicalMessage());
+    case ErrorCode::INVALID_DATA:
+    default:
+      throw InvalidDataException(getUserMessage(), getTechnicalMessage());
+    }
+  }
+};
+
+#endif // VALIDATION_RESULT_H
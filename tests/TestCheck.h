@@ -0,0 +1,26 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <iostream>
+
+/**
+ * TestCheck - Shared assertion helper for the C++ tests
+ *
+ * CHECK reports a failed condition with its location and counts it in
+ * failures instead of aborting, so one run shows every broken check.
+ * Each test's main returns non-zero when failures is not 0.
+ */
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do                                                                           \
+  {                                                                            \
+    if (!(cond))                                                               \
+    {                                                                          \
+      std::cerr << "FAILED: " #cond " (" << __FILE__ << ":" << __LINE__ << ")" \
+                << std::endl;                                                  \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+#endif // TEST_CHECK_H
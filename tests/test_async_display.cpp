@@ -0,0 +1,85 @@
+/**
+ * Test for AsyncConsoleDisplay
+ *
+ * Several threads show numbered lines through one display. After flush()
+ * every accepted line must be in the output exactly once, and each
+ * thread's lines must appear in the order that thread showed them. A tiny
+ * queue must count what it drops instead of blocking.
+ */
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "implementations/AsyncConsoleDisplay.h"
+#include "TestCheck.h"
+
+static const int THREAD_COUNT = 4;
+static const int LINES_PER_THREAD = 2000;
+
+int main()
+{
+  std::ostringstream sink;
+  {
+    AsyncConsoleDisplay display(THREAD_COUNT * LINES_PER_THREAD, sink);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; t++)
+    {
+      threads.emplace_back([&, t]()
+                           {
+        for (int i = 0; i < LINES_PER_THREAD; i++)
+        {
+          display.showLine(std::to_string(t) + " " + std::to_string(i));
+        } });
+    }
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+
+    display.flush();
+    CHECK(display.getDroppedCount() == 0);
+
+    std::vector<int> next(THREAD_COUNT, 0);
+    std::istringstream lines(sink.str());
+    int thread = 0;
+    int index = 0;
+    int total = 0;
+    while (lines >> thread >> index)
+    {
+      CHECK(thread >= 0 && thread < THREAD_COUNT);
+      CHECK(index == next[thread]);
+      next[thread] = index + 1;
+      total++;
+    }
+    CHECK(total == THREAD_COUNT * LINES_PER_THREAD);
+
+    display.show("tail");
+  }
+  CHECK(sink.str().size() >= 4 && sink.str().substr(sink.str().size() - 4) == "tail");
+
+  // Saturation: a two-slot queue drops instead of blocking the caller
+  std::ostringstream smallSink;
+  std::uint64_t dropped = 0;
+  {
+    AsyncConsoleDisplay display(2, smallSink);
+    for (int i = 0; i < 1000; i++)
+    {
+      display.showLine("x");
+    }
+    display.flush();
+    dropped = display.getDroppedCount();
+    CHECK(smallSink.str().size() == 2 * (1000 - dropped));
+  }
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Async display test passed (" << dropped << " of 1000 dropped with a 2-slot queue)" << std::endl;
+  return 0;
+}
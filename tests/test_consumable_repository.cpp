@@ -0,0 +1,239 @@
+/**
+ * Test for ConsumableRepository persistence
+ *
+ * Stock and usage rollups must survive a restart through the snapshot
+ * plus the replayed log, snapshots must roll over at the configured
+ * interval, a torn record at the end of the log must be ignored, and a
+ * log left over from an older generation must not be applied twice. A
+ * failed snapshot after adding a consumable must not cost the changes
+ * logged for the others, and must be retried. Usage charged to an order
+ * must come back under the same order ID from the snapshot and the log.
+ */
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "managers/ConsumableManager.h"
+#include "TestCheck.h"
+
+static const int SNAPSHOT_INTERVAL = 64;
+static const int USAGE_COUNT = 50000;
+
+int main()
+{
+  char directoryTemplate[] = "/tmp/inventory_test_XXXXXX";
+  const char *directory = mkdtemp(directoryTemplate);
+  CHECK(directory != nullptr);
+  if (!directory)
+  {
+    return 1;
+  }
+  std::string base = std::string(directory) + "/inventory";
+
+  // First run: nothing stored yet
+  {
+    ConsumableRepository repository(base, nullptr, SNAPSHOT_INTERVAL);
+    ConsumableManager manager(nullptr);
+    manager.setRepository(&repository);
+    manager.loadData();
+    CHECK(manager.getAllConsumables().empty());
+
+    manager.createConsumable("CON001", "Photo Paper", 1000000, "sheets");
+    manager.createConsumable("CON002", "Developer", 500, "liters");
+
+    for (int i = 0; i < USAGE_COUNT; i++)
+    {
+      manager.recordUsage(ConsumableUsage("U" + std::to_string(i), "Photo Paper", 2));
+    }
+    manager.updateStock("Developer", 25);
+    manager.recordUsageBatch({ConsumableUsage("B1", "Photo Paper", 3), ConsumableUsage("B2", "Developer", 5)});
+    StockReservation hold = manager.reserveStock("Developer", 7);
+    manager.commitUsage(hold, "R1");
+
+    CHECK(repository.getGeneration() > USAGE_COUNT / SNAPSHOT_INTERVAL);
+    CHECK(repository.getLoggedSinceSnapshot() < static_cast<std::size_t>(SNAPSHOT_INTERVAL));
+    // No saveData: the tail of the log must be replayed on the next load
+  }
+
+  CHECK(std::filesystem::file_size(base + ".log") < 2 * 1024);
+
+  // Second run: everything comes back from snapshot + log
+  {
+    ConsumableRepository repository(base, nullptr, SNAPSHOT_INTERVAL);
+    ConsumableManager manager(nullptr);
+    manager.setRepository(&repository);
+
+    auto start = std::chrono::steady_clock::now();
+    manager.loadData();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    CHECK(elapsed < std::chrono::milliseconds(100));
+
+    CHECK(manager.getAllConsumables().size() == 2);
+    Consumable *paper = manager.findConsumableByName("Photo Paper");
+    Consumable *developer = manager.findConsumableById("CON002");
+    CHECK(paper && paper->getCurrentStock() == 1000000 - 2 * USAGE_COUNT - 3);
+    CHECK(developer && developer->getCurrentStock() == 500 + 25 - 5 - 7);
+    CHECK(manager.getTotalUsage("Photo Paper") == 2LL * USAGE_COUNT + 3);
+    CHECK(manager.getTotalUsage("Developer") == 12);
+    CHECK(manager.getRecordedUsageCount() == static_cast<std::uint64_t>(USAGE_COUNT + 3));
+
+    manager.recordUsage(ConsumableUsage("U-next", "Developer", 1));
+    manager.saveData();
+    CHECK(repository.getLoggedSinceSnapshot() == 0);
+  }
+
+  // A torn record at the end of the log is dropped, and a log from an
+  // older generation is ignored
+  std::uintmax_t cleanSize = 0;
+  {
+    ConsumableRepository repository(base, nullptr, SNAPSHOT_INTERVAL);
+    ConsumableManager manager(nullptr);
+    manager.setRepository(&repository);
+    manager.loadData();
+    manager.recordUsage(ConsumableUsage("U-torn", "Developer", 1));
+    cleanSize = std::filesystem::file_size(base + ".log");
+  }
+  {
+    std::ofstream log(base + ".log", std::ios::binary | std::ios::app);
+    log.write("\x01\x00\x00\x00\x00", 5);
+  }
+  std::filesystem::copy_file(base + ".log", base + ".old-log");
+  {
+    ConsumableRepository repository(base, nullptr, SNAPSHOT_INTERVAL);
+    ConsumableManager manager(nullptr);
+    manager.setRepository(&repository);
+    manager.loadData();
+    CHECK(std::filesystem::file_size(base + ".log") == cleanSize);
+    CHECK(manager.findConsumableById("CON002")->getCurrentStock() == 500 + 25 - 5 - 7 - 2);
+    manager.saveData();
+  }
+  std::filesystem::copy_file(base + ".old-log", base + ".log", std::filesystem::copy_options::overwrite_existing);
+  {
+    ConsumableRepository repository(base, nullptr, SNAPSHOT_INTERVAL);
+    ConsumableManager manager(nullptr);
+    manager.setRepository(&repository);
+    manager.loadData();
+    CHECK(manager.findConsumableById("CON002")->getCurrentStock() == 500 + 25 - 5 - 7 - 2);
+    CHECK(manager.getTotalUsage("Developer") == 14);
+  }
+
+  // The snapshot for a new consumable fails (its temporary path is a
+  // non-empty directory); changes to the stored ones must still be logged
+  auto blockSnapshots = [&base]()
+  {
+    std::filesystem::create_directory(base + ".snap.tmp");
+    std::ofstream(base + ".snap.tmp/keep") << "x";
+  };
+  blockSnapshots();
+  {
+    ConsumableRepository repository(base, nullptr, SNAPSHOT_INTERVAL);
+    ConsumableManager manager(nullptr);
+    manager.setRepository(&repository);
+    manager.loadData();
+    std::uint32_t generation = repository.getGeneration();
+
+    manager.createConsumable("CON003", "Fixer", 100, "liters");
+    CHECK(repository.isSnapshotPending());
+    CHECK(repository.getGeneration() == generation);
+    manager.recordUsage(ConsumableUsage("F1", "Fixer", 4));
+    manager.recordUsage(ConsumableUsage("D1", "Developer", 3));
+    manager.updateStock("Developer", 10);
+    CHECK(repository.isSnapshotPending());
+    // No saveData: simulates a crash while snapshots keep failing
+  }
+  {
+    ConsumableRepository repository(base, nullptr, SNAPSHOT_INTERVAL);
+    ConsumableManager manager(nullptr);
+    manager.setRepository(&repository);
+    manager.loadData();
+    CHECK(manager.findConsumableById("CON003") == nullptr); // Never reached a snapshot
+    CHECK(manager.findConsumableById("CON002")->getCurrentStock() == 500 + 25 - 5 - 7 - 2 - 3 + 10);
+    CHECK(manager.getTotalUsage("Developer") == 17);
+
+    // Once snapshots work again the new consumable is stored right away
+    std::filesystem::remove_all(base + ".snap.tmp");
+    manager.createConsumable("CON003", "Fixer", 100, "liters");
+    CHECK(!repository.isSnapshotPending());
+
+    // A failed snapshot is retried with the next change
+    blockSnapshots();
+    manager.createConsumable("CON004", "Toner", 50, "cartridges");
+    CHECK(repository.isSnapshotPending());
+    std::uint32_t generation = repository.getGeneration();
+    std::filesystem::remove_all(base + ".snap.tmp");
+    manager.recordUsage(ConsumableUsage("T1", "Toner", 5));
+    CHECK(!repository.isSnapshotPending());
+    CHECK(repository.getGeneration() == generation + 1);
+    manager.recordUsage(ConsumableUsage("T2", "Toner", 1));
+  }
+  {
+    ConsumableRepository repository(base, nullptr, SNAPSHOT_INTERVAL);
+    ConsumableManager manager(nullptr);
+    manager.setRepository(&repository);
+    manager.loadData();
+    CHECK(manager.findConsumableById("CON004")->getCurrentStock() == 44);
+    CHECK(manager.findConsumableById("CON003")->getCurrentStock() == 100);
+  }
+
+  // Order links come back by order ID, from the snapshot and from the log
+  std::string ordersBase = std::string(directory) + "/orders";
+  {
+    ConsumableRepository repository(ordersBase, nullptr, SNAPSHOT_INTERVAL);
+    ConsumableManager manager(nullptr);
+    manager.setRepository(&repository);
+    manager.loadData();
+    manager.createConsumable("CON001", "Photo Paper", 1000, "sheets", 0.10);
+    manager.createConsumable("CON002", "Developer", 100, "liters", 2.25);
+
+    ConsumableUsage prints("U1", "Photo Paper", 50);
+    prints.assignOrder("O001");
+    manager.recordUsage(prints);
+    manager.saveData(); // In the snapshot
+
+    ConsumableUsage film("U2", "Developer", 2);
+    film.assignOrder("O-second-order-with-a-long-id");
+    manager.recordUsage(film);
+    manager.recordUsage(ConsumableUsage("U3", "Photo Paper", 7)); // Not linked
+    StockReservation hold = manager.reserveStock("Photo Paper", 10);
+    manager.commitUsage(hold, "U4", "O001");
+    CHECK(repository.getLoggedSinceSnapshot() == 3); // In the log only
+  }
+  {
+    ConsumableRepository repository(ordersBase, nullptr, SNAPSHOT_INTERVAL);
+    ConsumableManager manager(nullptr);
+    manager.setRepository(&repository);
+    manager.loadData();
+    CHECK(manager.getOrderMaterialCostCents("O001") == 60 * 10);
+    CHECK(manager.getOrderMaterialCostCents("O-second-order-with-a-long-id") == 2 * 225);
+    std::vector<OrderUsageEntry> entries = manager.getOrderUsage("O001");
+    CHECK(entries.size() == 2 && entries[0].consumable == manager.findConsumableById("CON001"));
+    CHECK(entries.size() == 2 && entries[1].quantity == 10 && entries[1].costCents == 100);
+    CHECK(manager.getMaterialCostByOrder().size() == 2);
+    CHECK(manager.findConsumableById("CON001")->getCurrentStock() == 1000 - 67);
+    manager.saveData(); // Log entries folded into the new snapshot
+  }
+  {
+    ConsumableRepository repository(ordersBase, nullptr, SNAPSHOT_INTERVAL);
+    ConsumableManager manager(nullptr);
+    manager.setRepository(&repository);
+    manager.loadData();
+    CHECK(repository.getLoggedSinceSnapshot() == 0);
+    CHECK(manager.getOrderMaterialCostCents("O001") == 600);
+    CHECK(manager.getOrderUsage("O-second-order-with-a-long-id").size() == 1);
+  }
+
+  std::filesystem::remove_all(directory);
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Consumable repository test passed" << std::endl;
+  return 0;
+}
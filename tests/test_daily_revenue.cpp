@@ -0,0 +1,140 @@
+/**
+ * Test for the per-day revenue index and the period revenue report
+ *
+ * Payments and repricing must land in the bucket of the order's
+ * completion date, day/week/month reads must sum exactly those buckets,
+ * and malformed dates must be counted as undated.
+ */
+#include <iostream>
+#include <string>
+
+#include "config/Config.h"
+#include "entities/Report.h"
+#include "managers/DailyRevenueIndex.h"
+#include "managers/OrderManager.h"
+#include "managers/ReportManager.h"
+#include "TestCheck.h"
+
+static std::int32_t dayOf(const std::string &date)
+{
+  std::int32_t day = 0;
+  DailyRevenueIndex::parseDay(date, day);
+  return day;
+}
+
+static void testCalendar()
+{
+  std::int32_t day;
+  CHECK(DailyRevenueIndex::parseDay("1970-01-01", day) && day == 0);
+  CHECK(DailyRevenueIndex::parseDay("2025-09-01 14:00", day) && DailyRevenueIndex::formatDay(day) == "2025-09-01");
+  CHECK(DailyRevenueIndex::parseDay("2024-02-29", day));
+  CHECK(!DailyRevenueIndex::parseDay("2025-02-29", day));
+  CHECK(!DailyRevenueIndex::parseDay("2025-13-01", day));
+  CHECK(!DailyRevenueIndex::parseDay("tomorrow", day));
+  CHECK(!DailyRevenueIndex::parseDay("2025-09-011", day));
+  CHECK(DailyRevenueIndex::formatDay(dayOf("1969-12-31")) == "1969-12-31");
+
+  // 2025-09-01 is a Monday
+  CHECK(DailyRevenueIndex::weekStart(dayOf("2025-09-07")) == dayOf("2025-09-01"));
+  CHECK(DailyRevenueIndex::weekStart(dayOf("2025-09-01")) == dayOf("2025-09-01"));
+  CHECK(DailyRevenueIndex::monthStart(dayOf("2024-02-17")) == dayOf("2024-02-01"));
+  CHECK(DailyRevenueIndex::nextMonthStart(dayOf("2024-02-17")) == dayOf("2024-03-01"));
+  CHECK(DailyRevenueIndex::nextMonthStart(dayOf("2025-12-31")) == dayOf("2026-01-01"));
+}
+
+static void testIndex()
+{
+  DailyRevenueIndex index;
+  index.add("2025-09-03 10:00", false, 500);
+  index.add("2025-09-01 10:00", true, 1200); // Out of order
+  index.add("2025-09-03 18:00", true, 300);
+  index.add("2025-10-01 09:00", false, 700);
+  index.add("someday", false, 50);
+
+  CHECK(index.getDayCount() == 3);
+  CHECK(index.getTotalCents() == 2750);
+  CHECK(index.getUndated().paidCents == 50);
+
+  std::vector<DailyRevenue> september = index.getDays(dayOf("2025-09-01"), dayOf("2025-10-01"));
+  CHECK(september.size() == 2);
+  CHECK(september[0].day == dayOf("2025-09-01") && september[0].expressCents == 1200);
+  CHECK(september[1].paidCents == 800 && september[1].regularCents == 500);
+
+  DailyRevenue range = index.getRange(dayOf("2025-09-02"), dayOf("2025-10-02"));
+  CHECK(range.paidCents == 1500);
+  CHECK(index.getRange(dayOf("2025-08-01"), dayOf("2025-09-01")).paidCents == 0);
+}
+
+static void testOrderManagerAndReport()
+{
+  Config config;
+  OrderManager orders(nullptr, &config);
+  orders.enableAggregateVerification();
+  Client *client = orders.findOrCreateClient("C001", "Smith");
+
+  Order *monday = orders.createOrder("O001", client, "2025-09-01 14:00", false);
+  orders.addItemToOrder(monday, "I001", 4, 10.0);
+  Order *friday = orders.createOrder("O002", client, "2025-09-05 18:00", false);
+  orders.addItemToOrder(friday, "I002", 1, 7.5);
+  Order *nextWeek = orders.createOrder("O003", client, "2025-09-08 09:00", false);
+  orders.addItemToOrder(nextWeek, "I003", 2, 5.0);
+  Order *unpaid = orders.createOrder("O004", client, "2025-09-02 09:00", false);
+  orders.addItemToOrder(unpaid, "I004", 2, 5.0);
+
+  for (Order *order : {monday, friday, nextWeek})
+  {
+    orders.processOrder(order);
+    orders.completeOrder(order);
+    orders.recordPayment(order);
+  }
+  orders.addItemToOrder(friday, "I005", 1, 2.5); // Repriced after payment
+
+  std::int32_t week = dayOf("2025-09-01");
+  CHECK(orders.getRevenueBetween(week, week + 7).paidCents == 4000 + 1000);
+  CHECK(orders.getRevenueBetween(week, week + 1).paidCents == 4000);
+  CHECK(orders.getDailyRevenue(week, week + 7).size() == 2);
+  CHECK(orders.getRevenueBetween(dayOf("2025-09-01"), dayOf("2025-10-01")).paidCents == 6000);
+  CHECK(orders.getUndatedRevenue().paidCents == 0);
+  orders.verifyAggregates();
+
+  ReportManager reports(nullptr);
+  reports.generatePeriodRevenueReport(&orders, RevenuePeriod::WEEK, "2025-09-03");
+  reports.generatePeriodRevenueReport(&orders, RevenuePeriod::DAY, "2025-09-08");
+  reports.generatePeriodRevenueReport(&orders, RevenuePeriod::MONTH, "2025-09-30");
+  CHECK(reports.getAllReports().size() == 3);
+
+  const std::string &weekly = reports.getAllReports()[0]->getContent();
+  CHECK(weekly.find("Weekly Revenue Report (2025-09-01 to 2025-09-07)") != std::string::npos);
+  CHECK(weekly.find("2025-09-05: $10.000000") != std::string::npos);
+  CHECK(weekly.find("Total Revenue: $50.000000") != std::string::npos);
+  CHECK(reports.getAllReports()[1]->getContent().find("Total Revenue: $10.000000") != std::string::npos);
+  CHECK(reports.getAllReports()[2]->getContent().find("(2025-09-01 to 2025-09-30)") != std::string::npos);
+  CHECK(reports.getAllReports()[2]->getContent().find("Total Revenue: $60.000000") != std::string::npos);
+
+  bool rejected = false;
+  try
+  {
+    reports.generatePeriodRevenueReport(&orders, RevenuePeriod::DAY, "2025-9-1");
+  }
+  catch (const InvalidDataException &)
+  {
+    rejected = true;
+  }
+  CHECK(rejected);
+}
+
+int main()
+{
+  testCalendar();
+  testIndex();
+  testOrderManagerAndReport();
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Daily revenue test passed" << std::endl;
+  return 0;
+}
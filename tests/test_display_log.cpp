@@ -0,0 +1,71 @@
+/**
+ * Test for level-filtered, deferred display messages
+ *
+ * Disabled levels must never reach the sink. Enabled messages must expand
+ * "{}" placeholders the same way the old string concatenation did.
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "interfaces/IDisplay.h"
+#include "TestCheck.h"
+
+class RecordingDisplay : public IDisplay
+{
+public:
+  mutable std::vector<std::string> lines;
+  mutable int events = 0;
+
+  void show(const std::string &message) const override { lines.push_back(message); }
+  void showLine(const std::string &message) const override { lines.push_back(message); }
+
+  void logEvent(LogLevel level, const char *format, const LogArg *args, std::size_t count) const override
+  {
+    events++;
+    IDisplay::logEvent(level, format, args, count);
+  }
+};
+
+int main()
+{
+  RecordingDisplay display;
+  std::string orderID = "O001";
+  double price = 37.5;
+
+  display.log(LogLevel::INFO, "Order {} total price: ${}", orderID, price);
+  CHECK(display.lines.back() == "Order O001 total price: $" + std::to_string(price));
+
+  display.log(LogLevel::INFO, "Stock updated for {}: {} {}", "Photo Paper", 990, std::string("sheets"));
+  CHECK(display.lines.back() == "Stock updated for Photo Paper: 990 sheets");
+
+  display.log(LogLevel::WARNING, "{:.2f} of {} ({}) {{literal}}", 2.0 / 3.0, 7u, true);
+  CHECK(display.lines.back() == "0.67 of 7 (true) {literal}");
+
+  display.log(LogLevel::ERROR, "no args");
+  CHECK(display.lines.back() == "no args");
+
+  display.log(LogLevel::INFO, "missing {} and {}", 1);
+  CHECK(display.lines.back() == "missing 1 and {?}");
+
+  CHECK(display.events == 5);
+
+  // Below the threshold nothing is formatted or delivered
+  display.log(LogLevel::DEBUG, "debug {}", orderID);
+  CHECK(display.events == 5);
+
+  display.setLevel(LogLevel::OFF);
+  CHECK(!display.isEnabled(LogLevel::ERROR));
+  display.log(LogLevel::ERROR, "error {}", orderID);
+  CHECK(display.events == 5);
+  CHECK(display.lines.size() == 5u);
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Display log test passed" << std::endl;
+  return 0;
+}
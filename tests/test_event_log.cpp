@@ -0,0 +1,216 @@
+/**
+ * Test for BinaryEventLog and EventLogReader
+ *
+ * Events are written through a small segment size so the log rotates
+ * several times. The surviving segments must be limited to the configured
+ * count, decode on their own, and render the same text the console display
+ * would have printed. Corrupt segments must be rejected with
+ * InvalidDataException rather than crash the reader. A segment that
+ * cannot be opened must drop events, not throw, until an open succeeds.
+ */
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "exceptions/PhotoStudioExceptions.h"
+#include "implementations/BinaryEventLog.h"
+#include "implementations/EventLogFormat.h"
+#include "implementations/EventLogReader.h"
+#include "TestCheck.h"
+
+static const int EVENT_COUNT = 500;
+static const unsigned KEEP_SEGMENTS = 3;
+
+// Segment header followed by a DEFINE record with the given ID
+static std::vector<unsigned char> segmentWithDefine(std::uint32_t id, const std::string &format)
+{
+  using namespace EventLogFormat;
+  std::vector<unsigned char> bytes(sizeof(SegmentHeader) + DEFINE_HEADER_SIZE + format.size());
+  SegmentHeader header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.segmentNumber = 1;
+  header.createdNs = 0;
+  header.reserved = 0;
+  std::memcpy(bytes.data(), &header, sizeof(header));
+
+  unsigned char *out = bytes.data() + sizeof(header);
+  store<std::uint8_t>(out, RECORD_DEFINE);
+  store<std::uint8_t>(out, 0);
+  store<std::uint16_t>(out, static_cast<std::uint16_t>(format.size()));
+  store<std::uint32_t>(out, id);
+  std::memcpy(out, format.data(), format.size());
+  return bytes;
+}
+
+// True if reading the segment throws InvalidDataException
+static bool rejects(const std::string &path, const std::vector<unsigned char> &bytes)
+{
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  }
+  try
+  {
+    EventLogReader reader(path);
+    DecodedEvent event;
+    while (reader.next(event))
+    {
+    }
+  }
+  catch (const InvalidDataException &)
+  {
+    return true;
+  }
+  return false;
+}
+
+static void testCorruptSegments(const std::string &directory)
+{
+  std::string path = directory + "/corrupt.000001";
+
+  CHECK(!rejects(path, segmentWithDefine(7, "fine {}")));
+  CHECK(rejects(path, segmentWithDefine(0xFFFFFFFF, "wraps {}")));
+  CHECK(rejects(path, segmentWithDefine(EventLogFormat::MAX_FORMATS, "too large {}")));
+
+  std::vector<unsigned char> truncated = segmentWithDefine(1, "cut short {}");
+  truncated.resize(truncated.size() - 4);
+  CHECK(rejects(path, truncated));
+
+  std::vector<unsigned char> unknown = segmentWithDefine(1, "{}");
+  unknown.push_back(0x7F); // Unknown record type after the definition
+  CHECK(rejects(path, unknown));
+}
+
+static void testFailedRotation(const std::string &directory)
+{
+  std::string base = directory + "/blocked.log";
+  BinaryEventLog log(base, 512, KEEP_SEGMENTS);
+
+  // The next segment's path is a directory, so opening it fails
+  std::string blocked = BinaryEventLog::segmentPath(base, 2);
+  std::filesystem::create_directory(blocked);
+  bool threw = false;
+  try
+  {
+    for (int i = 0; i < 100; i++)
+    {
+      log.log(LogLevel::INFO, "Event {}", i);
+    }
+  }
+  catch (const std::exception &)
+  {
+    threw = true;
+  }
+  CHECK(!threw);
+  CHECK(log.getSegmentNumber() == 1);
+  std::uint64_t dropped = log.getDroppedCount();
+  CHECK(dropped > 0 && log.getRecordCount() + dropped == 100);
+
+  // Once the path is free the next event opens the segment
+  std::filesystem::remove(blocked);
+  log.log(LogLevel::INFO, "Event {}", 100);
+  CHECK(log.getSegmentNumber() == 2);
+  CHECK(log.getDroppedCount() == dropped);
+
+  EventLogReader reader(blocked);
+  DecodedEvent event;
+  CHECK(reader.next(event) && event.toText() == "Event 100");
+}
+
+int main()
+{
+  char directoryTemplate[] = "/tmp/eventlog_test_XXXXXX";
+  const char *directory = mkdtemp(directoryTemplate);
+  CHECK(directory != nullptr);
+  if (!directory)
+  {
+    return 1;
+  }
+  std::string base = std::string(directory) + "/events.log";
+
+  std::uint32_t lastSegment = 0;
+  {
+    BinaryEventLog log(base, 2048, KEEP_SEGMENTS);
+    log.setLevel(LogLevel::DEBUG);
+
+    std::string orderID = "O001";
+    for (int i = 0; i < EVENT_COUNT; i++)
+    {
+      log.log(LogLevel::INFO, "Order {} total price: ${} (#{})", orderID, 12.5 * i, i);
+      if (i % 50 == 0)
+      {
+        log.showLine("checkpoint " + std::to_string(i));
+      }
+    }
+    log.log(LogLevel::WARNING, "Express: {} paid: {}", true, 3u);
+
+    CHECK(log.getRecordCount() == EVENT_COUNT + EVENT_COUNT / 50 + 1);
+    CHECK(log.getDroppedCount() == 0);
+    lastSegment = log.getSegmentNumber();
+    CHECK(lastSegment > KEEP_SEGMENTS);
+  }
+
+  // Only the newest segments survive rotation
+  CHECK(!std::filesystem::exists(BinaryEventLog::segmentPath(base, lastSegment - KEEP_SEGMENTS)));
+
+  int previous = -1;
+  int decoded = 0;
+  bool sawWarning = false;
+  for (std::uint32_t n = lastSegment - KEEP_SEGMENTS + 1; n <= lastSegment; n++)
+  {
+    EventLogReader reader(BinaryEventLog::segmentPath(base, n));
+    CHECK(reader.getSegmentNumber() == n);
+
+    DecodedEvent event;
+    while (reader.next(event))
+    {
+      decoded++;
+      if (event.level == LogLevel::WARNING)
+      {
+        sawWarning = true;
+        CHECK(event.toText() == "Express: true paid: 3");
+        continue;
+      }
+      if (event.args.size() == 1)
+      {
+        CHECK(event.toText().rfind("checkpoint ", 0) == 0);
+        continue;
+      }
+
+      CHECK(event.args.size() == 3u);
+      int index = static_cast<int>(event.args[2].getInteger());
+      CHECK(previous < 0 || index == previous + 1);
+      previous = index;
+      CHECK(event.toText() == "Order O001 total price: $" + std::to_string(12.5 * index) +
+                                  " (#" + std::to_string(index) + ")");
+    }
+  }
+  CHECK(sawWarning);
+  CHECK(previous == EVENT_COUNT - 1);
+  CHECK(decoded > 0);
+
+  EventLogReader lastReader(BinaryEventLog::segmentPath(base, lastSegment));
+  DecodedEvent event;
+  CHECK(lastReader.next(event));
+  CHECK(event.toJson().find("\"format\":\"Order {} total price: ${} (#{})\"") != std::string::npos ||
+        event.toJson().find("\"format\":\"{}\"") != std::string::npos);
+
+  testCorruptSegments(directory);
+  testFailedRotation(directory);
+
+  std::filesystem::remove_all(directory);
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Event log test passed (" << lastSegment << " segments written)" << std::endl;
+  return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * Test for OrderManager's running aggregates and verifyAggregates
+ *
+ * With aggregate verification on, every revenue and status query is
+ * cross-checked against a full scan. Creating, processing, completing,
+ * paying and repricing orders (including a paid one), in single calls,
+ * in a batch, on the backlog pool and after a reload, must keep the
+ * running figures equal to what a scan of the orders gives.
+ */
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "config/Config.h"
+#include "managers/OrderManager.h"
+#include "orders/ExpressOrder.h"
+#include "repository/FileManager.h"
+#include "repository/OrderRepository.h"
+#include "TestCheck.h"
+
+static long long cents(double amount)
+{
+  return std::llround(amount * 100.0);
+}
+
+// The aggregate queries must match a scan done here, independently of
+// verifyAggregates, and verifyAggregates must not throw
+static void checkAgainstScan(const OrderManager &manager)
+{
+  long long paid = 0;
+  long long express = 0;
+  long long regular = 0;
+  int counts[4] = {0, 0, 0, 0};
+  for (const Order *order : manager.getAllOrders())
+  {
+    counts[static_cast<int>(order->getStatus())]++;
+    if (order->getIsPaid())
+    {
+      paid += cents(order->getTotalPrice());
+      (dynamic_cast<const ExpressOrder *>(order) ? express : regular) += cents(order->getTotalPrice());
+    }
+  }
+
+  try
+  {
+    manager.verifyAggregates();
+    CHECK(cents(manager.calculateTotalRevenue()) == paid);
+    CHECK(cents(manager.getExpressRevenue()) == express);
+    CHECK(cents(manager.getRegularRevenue()) == regular);
+    for (OrderStatus status : {OrderStatus::PENDING, OrderStatus::IN_PROGRESS, OrderStatus::COMPLETED,
+                               OrderStatus::CANCELLED})
+    {
+      CHECK(manager.getOrderCountByStatus(status) == counts[static_cast<int>(status)]);
+    }
+  }
+  catch (const ValidationException &e)
+  {
+    std::cerr << e.getTechnicalMessage() << std::endl;
+    CHECK(false);
+  }
+}
+
+int main()
+{
+  char directoryTemplate[] = "/tmp/order_aggregates_XXXXXX";
+  const char *directory = mkdtemp(directoryTemplate);
+  CHECK(directory != nullptr);
+  if (!directory)
+  {
+    return 1;
+  }
+  std::string dataFile = std::string(directory) + "/orders.dat";
+
+  Config config;
+  {
+    OrderRepository repository;
+    FileManager fileManager(dataFile);
+    OrderManager manager(nullptr, &config);
+    manager.setRepository(&repository);
+    manager.setFileManager(&fileManager);
+    manager.enableAggregateVerification();
+    checkAgainstScan(manager);
+
+    Client *client = manager.findOrCreateClient("C1", "Smith");
+    Order *regular = manager.createOrder("O1", client, "2025-09-01 14:00", false);
+    Order *express = manager.createOrder("O2", client, "2025-09-02 10:00", true);
+    manager.addItemToOrder(regular, "I1", 3, 12.5);
+    manager.addItemToOrder(express, "I2", 2, 20.0);
+    checkAgainstScan(manager);
+
+    manager.processOrder(regular);
+    manager.processOrder(express);
+    checkAgainstScan(manager);
+    manager.completeOrder(regular);
+    manager.completeOrder(express);
+    checkAgainstScan(manager);
+    manager.recordPayment(regular);
+    manager.recordPayment(express);
+    checkAgainstScan(manager);
+    CHECK(manager.calculateTotalRevenue() > 0);
+
+    // Repricing a paid order moves the revenue by the difference
+    double before = manager.getExpressRevenue();
+    manager.addItemToOrder(express, "I3", 1, 7.5);
+    CHECK(manager.getExpressRevenue() > before);
+    checkAgainstScan(manager);
+
+    // Unpaid and in-progress orders count by status only
+    manager.createOrder("O3", client, "2025-09-03 09:00", false);
+    Order *working = manager.createOrder("O4", client, "2025-09-03 11:00", true);
+    manager.addItemToOrder(working, "I4", 1, 30.0);
+    manager.processOrder(working);
+    checkAgainstScan(manager);
+
+    // Batches and the backlog pool go through the same bookkeeping
+    std::vector<OrderOperationResult> results = manager.applyBatch({
+        OrderOperation::create("B1", "C1", "Smith", "2025-09-04 10:00", false),
+        OrderOperation::addItem("B1", "I5", 4, 5.0),
+        OrderOperation::process("B1"),
+        OrderOperation::complete("B1"),
+        OrderOperation::recordPayment("B1"),
+        OrderOperation::addItem("B1", "I6", 1, 2.5),
+    });
+    for (const OrderOperationResult &result : results)
+    {
+      CHECK(result.success);
+    }
+    checkAgainstScan(manager);
+    manager.processBacklog(2);
+    checkAgainstScan(manager);
+    manager.processBacklog(2);
+    checkAgainstScan(manager);
+
+    manager.saveData();
+  }
+
+  // Loaded orders are counted as they are registered
+  {
+    OrderRepository repository;
+    FileManager fileManager(dataFile);
+    OrderManager manager(nullptr, &config);
+    manager.setRepository(&repository);
+    manager.setFileManager(&fileManager);
+    manager.enableAggregateVerification();
+    manager.loadData();
+    CHECK(manager.getLoadedOrderCount() == 5);
+    checkAgainstScan(manager);
+
+    Order *paid = manager.findOrderById("O1");
+    CHECK(paid != nullptr && paid->getIsPaid());
+    manager.addItemToOrder(paid, "I7", 2, 1.25);
+    checkAgainstScan(manager);
+  }
+
+  std::filesystem::remove_all(directory);
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Order aggregates test passed" << std::endl;
+  return 0;
+}
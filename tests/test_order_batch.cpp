@@ -0,0 +1,110 @@
+/**
+ * Test for OrderManager::applyBatch
+ *
+ * A batch mixing valid and invalid operations must apply the valid ones,
+ * report each rejected one with the message the single-operation API
+ * throws, resolve orders created earlier in the same batch as well as
+ * orders already in the index, and sync every touched order once.
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "config/Config.h"
+#include "managers/OrderManager.h"
+#include "repository/OrderRepository.h"
+#include "TestCheck.h"
+
+// Display that keeps every line it is asked to show
+class CapturingDisplay : public IDisplay
+{
+public:
+  mutable std::vector<std::string> lines;
+
+  void show(const std::string &message) const override { lines.push_back(message); }
+  void showLine(const std::string &message) const override { lines.push_back(message); }
+};
+
+int main()
+{
+  Config config;
+  OrderRepository repository;
+  CapturingDisplay display;
+  OrderManager manager(&display, &config);
+  manager.setRepository(&repository);
+
+  Client *client = manager.findOrCreateClient("C1", "Smith");
+  Order *existing = manager.createOrder("E1", client, "2025-09-01 14:00", false);
+  manager.addItemToOrder(existing, "I0", 1, 15.0);
+  CHECK(repository.getCount() == 1);
+  display.lines.clear();
+
+  std::vector<OrderOperation> batch = {
+      OrderOperation::create("B1", "C1", "Smith", "2025-09-02 10:00", false), // 0
+      OrderOperation::addItem("B1", "I1", 2, 10.0),                          // 1
+      OrderOperation::process("B1"),                                         // 2
+      OrderOperation::complete("B1"),                                        // 3
+      OrderOperation::recordPayment("B1"),                                   // 4
+      OrderOperation::create("B1", "C1", "Smith", "2025-09-02 10:00", false), // 5: duplicate in batch
+      OrderOperation::create("E1", "C1", "Smith", "2025-09-02 10:00", false), // 6: duplicate in index
+      OrderOperation::process("NOPE"),                                       // 7: unknown order
+      OrderOperation::addItem("B1", "I2", 0, 10.0),                          // 8: bad quantity
+      OrderOperation::recordPayment("B1"),                                   // 9: already paid
+      OrderOperation::create("B2", "C2", "Jones", "2025-09-03 09:00", true), // 10: new client
+      OrderOperation::complete("B2"),                                        // 11: still PENDING
+      OrderOperation::process("E1"),                                         // 12: from the index
+      OrderOperation::create("B3", "", "", "2025-09-03 09:00", false),       // 13: no client
+  };
+  std::vector<OrderOperationResult> results = manager.applyBatch(batch);
+
+  CHECK(results.size() == batch.size());
+  for (std::size_t i : {0u, 1u, 2u, 3u, 4u, 10u, 12u})
+  {
+    CHECK(results[i].success && results[i].order != nullptr && results[i].message.empty());
+  }
+  for (std::size_t i : {5u, 6u, 7u, 8u, 9u, 11u, 13u})
+  {
+    CHECK(!results[i].success && results[i].order == nullptr);
+  }
+  CHECK(results[5].message == "Order ID already exists: B1");
+  CHECK(results[6].message == "Order ID already exists: E1");
+  CHECK(results[7].message == "Order not found");
+  CHECK(results[8].message == "Quantity must be greater than zero");
+  CHECK(results[9].message == "Payment already recorded for order B1");
+  CHECK(results[11].message == "Invalid order status - expected IN_PROGRESS");
+  CHECK(results[13].message == "Client information is required");
+
+  // Later operations on B1 see the order the batch created
+  Order *created = manager.findOrderById("B1");
+  CHECK(created != nullptr && results[4].order == created);
+  CHECK(created->getStatus() == OrderStatus::COMPLETED && created->getIsPaid());
+  CHECK(created->getTotalPrice() > 0 && created->getItems().size() == 1);
+  CHECK(results[12].order == existing && existing->getStatus() == OrderStatus::IN_PROGRESS);
+  CHECK(manager.findOrderById("B2")->getStatus() == OrderStatus::PENDING);
+  CHECK(manager.findOrderById("B3") == nullptr);
+  CHECK(manager.getLoadedOrderCount() == 3);
+  CHECK(manager.getAllClients().size() == 2);
+
+  // One sync per touched order, carrying its final state, and one summary
+  CHECK(repository.getCount() == 3);
+  const OrderRecord &record = repository.getAt(repository.findIndexById("B1"));
+  CHECK(record.status == 2 && record.isPaid && record.totalPrice == created->getTotalPrice());
+  CHECK(repository.getAt(repository.findIndexById("E1")).status == 1);
+  CHECK(display.lines.size() == 1);
+  CHECK(display.lines.size() == 1 &&
+        display.lines[0] == "Batch applied: 7 of 14 operation(s) succeeded, 7 rejected, 3 order(s) synced.");
+
+  // An empty batch changes nothing
+  display.lines.clear();
+  CHECK(manager.applyBatch({}).empty());
+  CHECK(repository.getCount() == 3 && manager.getLoadedOrderCount() == 3);
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Order batch test passed" << std::endl;
+  return 0;
+}
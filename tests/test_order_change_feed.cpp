@@ -0,0 +1,301 @@
+/**
+ * Test for OrderChangeFeed
+ *
+ * Both overflow policies must behave as documented: DROP_NEWEST refuses
+ * events while the slowest subscriber is a full ring behind, and
+ * OVERWRITE_OLDEST lets lagging subscribers skip ahead and count what they
+ * missed. Subscribers see events from the moment they subscribed, and a
+ * concurrent producer must never hand a poller an event out of order or
+ * torn.
+ */
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "events/OrderChangeFeed.h"
+#include "exceptions/PhotoStudioExceptions.h"
+#include "TestCheck.h"
+
+static OrderChangeEvent eventFor(std::uint32_t handle)
+{
+  // Status and paid flag follow the handle so torn reads would show up
+  OrderStatus status = static_cast<OrderStatus>(handle % 4);
+  return OrderChangeEvent(handle, status, status, handle % 2 == 1, static_cast<std::int64_t>(handle) * 10);
+}
+
+static bool matches(const OrderChangeEvent &event)
+{
+  OrderChangeEvent expected = eventFor(event.orderHandle);
+  return event.oldStatus == expected.oldStatus && event.newStatus == expected.newStatus &&
+         event.paid == expected.paid && event.timestampNs == expected.timestampNs;
+}
+
+static void testCapacity()
+{
+  OrderChangeFeed feed(5);
+  CHECK(feed.getCapacity() == 8);
+  CHECK(feed.getPolicy() == FeedOverflowPolicy::OVERWRITE_OLDEST);
+
+  bool threw = false;
+  try
+  {
+    OrderChangeFeed empty(0);
+  }
+  catch (const InvalidDataException &)
+  {
+    threw = true;
+  }
+  CHECK(threw);
+}
+
+static void testDropNewest()
+{
+  OrderChangeFeed feed(4, FeedOverflowPolicy::DROP_NEWEST);
+
+  // Nobody subscribed: nothing holds the producer back
+  for (std::uint32_t i = 0; i < 10; i++)
+  {
+    CHECK(feed.publish(eventFor(i)));
+  }
+  CHECK(feed.getDroppedCount() == 0);
+
+  int reader = feed.subscribe();
+  int accepted = 0;
+  for (std::uint32_t i = 100; i < 106; i++)
+  {
+    accepted += feed.publish(eventFor(i)) ? 1 : 0;
+  }
+  CHECK(accepted == 4);
+  CHECK(feed.getDroppedCount() == 2);
+  CHECK(feed.getPublishedCount() == 14);
+  CHECK(feed.getPendingCount(reader) == 4);
+
+  OrderChangeEvent event;
+  for (std::uint32_t i = 100; i < 104; i++)
+  {
+    CHECK(feed.poll(reader, event));
+    CHECK(event.orderHandle == i && matches(event));
+  }
+  CHECK(!feed.poll(reader, event));
+  CHECK(feed.getMissedCount(reader) == 0);
+
+  // Reading made room again
+  CHECK(feed.publish(eventFor(200)));
+  CHECK(feed.poll(reader, event) && event.orderHandle == 200);
+
+  // An unsubscribed reader no longer holds the producer back
+  for (std::uint32_t i = 0; i < 4; i++)
+  {
+    CHECK(feed.publish(eventFor(300 + i)));
+  }
+  CHECK(!feed.publish(eventFor(304)));
+  feed.unsubscribe(reader);
+  CHECK(feed.publish(eventFor(305)));
+  CHECK(feed.getDroppedCount() == 3);
+}
+
+static void testOverwriteOldest()
+{
+  OrderChangeFeed feed(4, FeedOverflowPolicy::OVERWRITE_OLDEST);
+  int reader = feed.subscribe();
+
+  for (std::uint32_t i = 0; i < 10; i++)
+  {
+    CHECK(feed.publish(eventFor(i)));
+  }
+  CHECK(feed.getDroppedCount() == 0);
+  CHECK(feed.getPendingCount(reader) == 4); // Capped at what is still in the ring
+
+  OrderChangeEvent event;
+  for (std::uint32_t i = 6; i < 10; i++)
+  {
+    CHECK(feed.poll(reader, event));
+    CHECK(event.orderHandle == i && matches(event));
+  }
+  CHECK(!feed.poll(reader, event));
+  CHECK(feed.getMissedCount(reader) == 6);
+
+  // A reader that keeps up misses nothing more
+  for (std::uint32_t i = 10; i < 20; i++)
+  {
+    feed.publish(eventFor(i));
+    CHECK(feed.poll(reader, event) && event.orderHandle == i);
+  }
+  CHECK(feed.getMissedCount(reader) == 6);
+}
+
+static void testSubscribers()
+{
+  OrderChangeFeed feed(16);
+  int first = feed.subscribe();
+  feed.publish(eventFor(1));
+  feed.publish(eventFor(2));
+  int second = feed.subscribe(); // Starts at the current end of the feed
+  feed.publish(eventFor(3));
+
+  OrderChangeEvent event;
+  std::vector<std::uint32_t> seen;
+  while (feed.poll(first, event))
+  {
+    seen.push_back(event.orderHandle);
+  }
+  CHECK((seen == std::vector<std::uint32_t>{1, 2, 3}));
+  seen.clear();
+  while (feed.poll(second, event))
+  {
+    seen.push_back(event.orderHandle);
+  }
+  CHECK((seen == std::vector<std::uint32_t>{3}));
+
+  // A freed slot is reused with a fresh cursor and missed counter
+  feed.unsubscribe(first);
+  feed.publish(eventFor(4));
+  int third = feed.subscribe();
+  CHECK(third == first);
+  CHECK(!feed.poll(third, event));
+  CHECK(feed.getMissedCount(third) == 0);
+  CHECK(feed.poll(second, event) && event.orderHandle == 4);
+
+  // Every slot taken: one more subscriber is refused
+  std::vector<int> others;
+  for (int i = 2; i < OrderChangeFeed::MAX_SUBSCRIBERS; i++)
+  {
+    others.push_back(feed.subscribe());
+  }
+  bool threw = false;
+  try
+  {
+    feed.subscribe();
+  }
+  catch (const BusinessRuleException &)
+  {
+    threw = true;
+  }
+  CHECK(threw);
+  feed.unsubscribe(others.back());
+  CHECK(feed.subscribe() == others.back());
+
+  threw = false;
+  try
+  {
+    feed.poll(OrderChangeFeed::MAX_SUBSCRIBERS, event);
+  }
+  catch (const InvalidDataException &)
+  {
+    threw = true;
+  }
+  CHECK(threw);
+  CHECK(feed.getMissedCount(-1) == 0);
+  CHECK(feed.getPendingCount(-1) == 0);
+}
+
+// Poller results are written only by their own thread and read after join
+struct PollerResult
+{
+  std::uint64_t received;
+  bool ordered;
+  bool intact;
+
+  PollerResult() : received(0), ordered(true), intact(true) {}
+};
+
+static void runConcurrent(FeedOverflowPolicy policy, std::uint32_t eventCount, int pollerCount)
+{
+  OrderChangeFeed feed(64, policy);
+  std::vector<int> readers;
+  for (int i = 0; i < pollerCount; i++)
+  {
+    readers.push_back(feed.subscribe());
+  }
+
+  std::atomic<bool> producerDone(false);
+  std::vector<PollerResult> results(pollerCount);
+  std::vector<std::thread> pollers;
+  for (int p = 0; p < pollerCount; p++)
+  {
+    pollers.emplace_back([&, p]()
+                         {
+                           PollerResult &result = results[p];
+                           std::int64_t previous = -1;
+                           OrderChangeEvent event;
+                           while (true)
+                           {
+                             bool done = producerDone.load(std::memory_order_acquire);
+                             bool got = false;
+                             while (feed.poll(readers[p], event))
+                             {
+                               got = true;
+                               result.received++;
+                               result.ordered = result.ordered && static_cast<std::int64_t>(event.orderHandle) > previous;
+                               result.intact = result.intact && matches(event);
+                               previous = event.orderHandle;
+                             }
+                             if (done && !got)
+                             {
+                               break;
+                             }
+                             if (!got)
+                             {
+                               std::this_thread::yield();
+                             }
+                           } });
+  }
+
+  std::uint64_t accepted = 0;
+  for (std::uint32_t i = 0; i < eventCount; i++)
+  {
+    if (feed.publish(eventFor(i)))
+    {
+      accepted++;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+  producerDone.store(true, std::memory_order_release);
+  for (auto &poller : pollers)
+  {
+    poller.join();
+  }
+
+  CHECK(feed.getPublishedCount() == accepted);
+  CHECK(accepted + feed.getDroppedCount() == eventCount);
+  for (int p = 0; p < pollerCount; p++)
+  {
+    CHECK(results[p].ordered);
+    CHECK(results[p].intact);
+    if (policy == FeedOverflowPolicy::DROP_NEWEST)
+    {
+      // Back-pressure: every accepted event reaches every subscriber
+      CHECK(results[p].received == accepted);
+      CHECK(feed.getMissedCount(readers[p]) == 0);
+    }
+    else
+    {
+      CHECK(feed.getDroppedCount() == 0);
+      CHECK(results[p].received + feed.getMissedCount(readers[p]) == accepted);
+    }
+  }
+}
+
+int main()
+{
+  testCapacity();
+  testDropNewest();
+  testOverwriteOldest();
+  testSubscribers();
+  runConcurrent(FeedOverflowPolicy::OVERWRITE_OLDEST, 200000, 3);
+  runConcurrent(FeedOverflowPolicy::DROP_NEWEST, 200000, 3);
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Order change feed test passed" << std::endl;
+  return 0;
+}
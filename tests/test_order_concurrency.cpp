@@ -0,0 +1,191 @@
+/**
+ * Stress test for OrderManager concurrent mode
+ *
+ * Many threads create orders, share clients and race each other through the
+ * PENDING -> IN_PROGRESS -> COMPLETED -> paid workflow. Afterwards every
+ * order must satisfy the postconditions the workflow methods check, and every
+ * transition (including payment) must have been won by exactly one thread.
+ * Saving while the workflow runs must neither deadlock nor lose a sync.
+ */
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "config/Config.h"
+#include "managers/OrderManager.h"
+#include "repository/FileManager.h"
+#include "repository/OrderRepository.h"
+#include "TestCheck.h"
+
+static const int THREAD_COUNT = 8;
+static const int ORDERS_PER_THREAD = 250;
+static const int CLIENT_COUNT = 10;
+
+int main()
+{
+  char directoryTemplate[] = "/tmp/order_concurrency_XXXXXX";
+  const char *directory = mkdtemp(directoryTemplate);
+  CHECK(directory != nullptr);
+  if (!directory)
+  {
+    return 1;
+  }
+
+  Config config;
+  OrderRepository repository;
+  FileManager fileManager(std::string(directory) + "/orders.dat");
+  OrderManager manager(nullptr, &config);
+  manager.setRepository(&repository);
+  manager.setFileManager(&fileManager);
+  manager.enableConcurrentMode();
+
+  std::atomic<int> duplicateWins(0);
+  std::vector<std::thread> threads;
+
+  // Phase 1: concurrent creation with shared clients and one contended ID
+  for (int t = 0; t < THREAD_COUNT; t++)
+  {
+    threads.emplace_back([&, t]()
+                         {
+      for (int i = 0; i < ORDERS_PER_THREAD; i++)
+      {
+        std::string clientID = "C" + std::to_string(i % CLIENT_COUNT);
+        Client *client = manager.findOrCreateClient(clientID, "Client" + clientID);
+        std::string orderID = "T" + std::to_string(t) + "-" + std::to_string(i);
+        Order *order = manager.createOrder(orderID, client, "2025-09-01 14:00", i % 3 == 0);
+        manager.addItemToOrder(order, "I" + orderID, 1 + i % 4, 10.0);
+      }
+
+      try
+      {
+        manager.createOrder("DUP", manager.findOrCreateClient("C0", "ClientC0"), "2025-09-01 14:00", false);
+        duplicateWins++;
+      }
+      catch (const DuplicateDataException &)
+      {
+      } });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  threads.clear();
+
+  const int totalOrders = THREAD_COUNT * ORDERS_PER_THREAD;
+  CHECK(duplicateWins.load() == 1);
+  CHECK(manager.getLoadedOrderCount() == totalOrders + 1);
+  CHECK(static_cast<int>(manager.getAllClients().size()) == CLIENT_COUNT);
+  CHECK(repository.getCount() == totalOrders + 1);
+
+  // Phase 2: every thread tries to drive every order through the workflow
+  // while another one keeps saving
+  std::atomic<int> processed(0);
+  std::atomic<int> completed(0);
+  std::atomic<int> paid(0);
+  std::atomic<bool> workflowDone(false);
+  std::atomic<int> saves(0);
+  std::thread saver([&]()
+                    {
+    while (!workflowDone.load())
+    {
+      manager.saveData();
+      saves++;
+    } });
+
+  for (int t = 0; t < THREAD_COUNT; t++)
+  {
+    threads.emplace_back([&, t]()
+                         {
+      for (int n = 0; n < totalOrders; n++)
+      {
+        int index = (n + t * ORDERS_PER_THREAD) % totalOrders;
+        std::string orderID = "T" + std::to_string(index / ORDERS_PER_THREAD) + "-" +
+                              std::to_string(index % ORDERS_PER_THREAD);
+        Order *order = manager.findOrderById(orderID);
+
+        try
+        {
+          manager.processOrder(order);
+          processed++;
+        }
+        catch (const BusinessRuleException &)
+        {
+        }
+
+        try
+        {
+          manager.completeOrder(order);
+          completed++;
+        }
+        catch (const BusinessRuleException &)
+        {
+        }
+
+        try
+        {
+          manager.recordPayment(order);
+          paid++;
+        }
+        catch (const BusinessRuleException &)
+        {
+        }
+      } });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  workflowDone = true;
+  saver.join();
+
+  CHECK(saves.load() > 0);
+  CHECK(repository.getCount() == totalOrders + 1);
+  CHECK(processed.load() == totalOrders);
+  CHECK(completed.load() == totalOrders);
+  CHECK(paid.load() == totalOrders);
+
+  for (int i = 0; i < repository.getCount(); i++)
+  {
+    const OrderRecord &record = repository.getAt(i);
+    Order *order = manager.findOrderById(record.orderID);
+    CHECK(order != nullptr);
+    if (record.orderID == "DUP")
+    {
+      CHECK(record.status == 0);
+      continue;
+    }
+    CHECK(order->getStatus() == OrderStatus::COMPLETED);
+    CHECK(order->getIsPaid());
+    CHECK(order->getTotalPrice() > 0);
+    CHECK(record.status == 2);
+    CHECK(record.isPaid);
+  }
+
+  // Running aggregates must agree with a full scan after the storm
+  try
+  {
+    manager.verifyAggregates();
+  }
+  catch (const ValidationException &e)
+  {
+    std::cerr << e.getTechnicalMessage() << std::endl;
+    CHECK(false);
+  }
+  CHECK(manager.getOrderCountByStatus(OrderStatus::COMPLETED) == totalOrders);
+  CHECK(manager.getOrderCountByStatus(OrderStatus::PENDING) == 1);
+  CHECK(manager.calculateTotalRevenue() > 0);
+  std::filesystem::remove_all(directory);
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Order concurrency test passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * Test for the order -> material cost index and the margin report
+ *
+ * Usage charged to orders through every recording path must land in the
+ * index at the unit cost in force at the time, unlinked usage must not,
+ * and the margin report must join revenue with those costs per order.
+ */
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+#include "config/Config.h"
+#include "entities/Report.h"
+#include "managers/ConsumableManager.h"
+#include "managers/OrderManager.h"
+#include "managers/ReportManager.h"
+#include "TestCheck.h"
+
+int main()
+{
+  Config config;
+  OrderManager orders(nullptr, &config);
+  ConsumableManager consumables(nullptr);
+  ReportManager reports(nullptr);
+
+  Consumable *paper = consumables.createConsumable("CON001", "Photo Paper", 1000, "sheets", 0.10);
+  consumables.createConsumable("CON002", "Developer", 100, "liters", 2.25);
+
+  Client *client = orders.findOrCreateClient("C001", "Smith");
+  Order *first = orders.createOrder("O001", client, "2025-09-01 14:00", false);
+  orders.addItemToOrder(first, "I001", 4, 10.0);
+  Order *second = orders.createOrder("O002", client, "2025-09-01 18:00", true);
+  orders.addItemToOrder(second, "I002", 2, 10.0);
+  orders.processOrder(first);
+  orders.processOrder(second);
+
+  ConsumableUsage prints("U001", "Photo Paper", 30);
+  prints.assignOrder("O001");
+  consumables.recordUsage(prints);
+
+  consumables.recordUsage(ConsumableUsage("U002", "Photo Paper", 500)); // Not linked
+
+  ConsumableUsage film("U003", "Developer", 2);
+  ConsumableUsage sleeves("U004", "Photo Paper", 5);
+  film.assignOrder("O002");
+  sleeves.assignOrder("O002");
+  consumables.recordUsageBatch({film, sleeves});
+
+  paper->setUnitCost(0.20); // Later usage is charged at the new cost
+  StockReservation hold = consumables.reserveStock("Photo Paper", 10);
+  consumables.commitUsage(hold, "U005", "O001");
+
+  CHECK(consumables.getOrderMaterialCostCents("O001") == 30 * 10 + 10 * 20);
+  CHECK(consumables.getOrderMaterialCostCents("O002") == 2 * 225 + 5 * 10);
+  CHECK(consumables.getOrderUsage("O001").size() == 2);
+  CHECK(consumables.getOrderUsage("O002")[0].consumable->getName() == "Developer");
+  CHECK(consumables.getOrderUsage("O099").empty());
+  CHECK(consumables.getOrderMaterialCostCents("O099") == 0);
+
+  // Usage for an order that is not loaded is kept but left out of the report
+  ConsumableUsage stray("U006", "Photo Paper", 1);
+  stray.assignOrder("O999");
+  consumables.recordUsage(stray);
+  CHECK(consumables.getOrderMaterialCostCents("O999") == 20);
+  std::unordered_map<std::string, long long> costByOrder = consumables.getMaterialCostByOrder();
+  CHECK(costByOrder.size() == 3);
+  CHECK(costByOrder["O001"] == 500 && costByOrder["O002"] == 500);
+
+  reports.generateMarginReport(&orders, &consumables);
+  CHECK(reports.getAllReports().size() == 1);
+  const std::string &content = reports.getAllReports()[0]->getContent();
+  CHECK(content.find("O001 (REGULAR): revenue $40.000000, materials $5.000000, margin $35.000000") != std::string::npos);
+  std::string expressRevenue = std::to_string(second->getTotalPrice());
+  std::string expressMargin = std::to_string(second->getTotalPrice() - 5.0);
+  CHECK(content.find("O002 (EXPRESS): revenue $" + expressRevenue + ", materials $5.000000, margin $" +
+                     expressMargin) != std::string::npos);
+  CHECK(content.find("Total: revenue $" + std::to_string(40.0 + second->getTotalPrice()) +
+                     ", materials $10.000000") != std::string::npos);
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Order margin test passed" << std::endl;
+  return 0;
+}
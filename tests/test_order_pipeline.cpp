@@ -0,0 +1,166 @@
+/**
+ * Test for the coroutine order pipeline
+ *
+ * Queued orders are pushed through the pipeline twice (PENDING ->
+ * IN_PROGRESS, then IN_PROGRESS -> COMPLETED + paid). A finished order
+ * must be rejected at the validate stage. Every stage must have run for
+ * every accepted order and the repository must match the working orders.
+ * A persist stage or display that throws must fail the order, not hang
+ * drain().
+ */
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "config/Config.h"
+#include "managers/OrderManager.h"
+#include "managers/OrderPipeline.h"
+#include "repository/OrderRepository.h"
+#include "TestCheck.h"
+
+static const int ORDER_COUNT = 200;
+
+// Display whose output fails, as a closed terminal or pipe would
+class ThrowingDisplay : public IDisplay
+{
+public:
+  void show(const std::string &) const override { throw std::runtime_error("display failed"); }
+  void showLine(const std::string &) const override { throw std::runtime_error("display failed"); }
+};
+
+static void testFailures()
+{
+  Config config;
+  OrderManager manager(nullptr, &config);
+  Client *client = manager.findOrCreateClient("C1", "Client");
+  for (int i = 0; i < 20; i++)
+  {
+    Order *order = manager.createOrder("F" + std::to_string(i), client, "2025-09-01 14:00", false);
+    manager.addItemToOrder(order, "I" + std::to_string(i), 1, 10.0);
+  }
+
+  // Persisting every other order fails
+  {
+    OrderPipeline pipeline(&manager, nullptr, 2);
+    pipeline.setPersistStep([](Order *order)
+                            {
+                              if (order->getOrderID().back() % 2 == 0)
+                              {
+                                throw std::runtime_error("disk full");
+                              }
+                            });
+    for (Order *order : manager.getAllOrders())
+    {
+      pipeline.submit(order);
+    }
+    pipeline.drain();
+    CHECK(pipeline.getCompletedCount() == 10);
+    CHECK(pipeline.getFailedCount() == 10);
+    CHECK(pipeline.getStageLatency(PipelineStage::PERSIST).count == 20u);
+    CHECK(pipeline.getStageLatency(PipelineStage::NOTIFY).count == 20u);
+    CHECK(!pipeline.getUnexpectedError());
+  }
+
+  // An exception outside any stage's error handling still releases the order
+  {
+    ThrowingDisplay display;
+    OrderPipeline pipeline(&manager, &display, 2);
+    for (Order *order : manager.getAllOrders())
+    {
+      pipeline.submit(order);
+    }
+    pipeline.drain();
+    CHECK(pipeline.getCompletedCount() == 0);
+    CHECK(pipeline.getFailedCount() == 20);
+    bool rethrown = false;
+    try
+    {
+      std::rethrow_exception(pipeline.getUnexpectedError());
+    }
+    catch (const std::runtime_error &e)
+    {
+      rethrown = std::string(e.what()) == "display failed";
+    }
+    CHECK(rethrown);
+  }
+}
+
+int main()
+{
+  Config config;
+  OrderRepository repository;
+  OrderManager manager(nullptr, &config);
+  manager.setRepository(&repository);
+
+  for (int i = 0; i < ORDER_COUNT; i++)
+  {
+    Client *client = manager.findOrCreateClient("C" + std::to_string(i % 7), "Client");
+    Order *order = manager.createOrder("P" + std::to_string(i), client, "2025-09-01 14:00", i % 4 == 0);
+    manager.addItemToOrder(order, "I" + std::to_string(i), 1 + i % 3, 12.5);
+  }
+
+  {
+    OrderPipeline pipeline(&manager, nullptr, 4);
+
+    for (int round = 0; round < 2; round++)
+    {
+      for (Order *order : manager.getAllOrders())
+      {
+        pipeline.submit(order);
+      }
+      pipeline.drain();
+    }
+
+    CHECK(pipeline.getCompletedCount() == 2 * ORDER_COUNT);
+    CHECK(pipeline.getFailedCount() == 0);
+
+    // Third round: every order is finished and must be turned away
+    for (Order *order : manager.getAllOrders())
+    {
+      pipeline.submit(order);
+    }
+    pipeline.drain();
+    CHECK(pipeline.getFailedCount() == ORDER_COUNT);
+
+    CHECK(pipeline.getStageLatency(PipelineStage::VALIDATE).count == 3u * ORDER_COUNT);
+    CHECK(pipeline.getStageLatency(PipelineStage::PRICE).count == 2u * ORDER_COUNT);
+    CHECK(pipeline.getStageLatency(PipelineStage::PERSIST).count == 2u * ORDER_COUNT);
+    CHECK(pipeline.getStageLatency(PipelineStage::NOTIFY).count == 3u * ORDER_COUNT);
+    CHECK(pipeline.getStageLatency(PipelineStage::PRICE).maxMicros >=
+          pipeline.getStageLatency(PipelineStage::PRICE).averageMicros);
+  }
+
+  for (int i = 0; i < repository.getCount(); i++)
+  {
+    const OrderRecord &record = repository.getAt(i);
+    Order *order = manager.findOrderById(record.orderID);
+    CHECK(order != nullptr);
+    CHECK(order->getStatus() == OrderStatus::COMPLETED);
+    CHECK(order->getIsPaid());
+    CHECK(record.status == 2);
+    CHECK(record.isPaid);
+    CHECK(record.totalPrice == order->getTotalPrice());
+  }
+
+  try
+  {
+    manager.verifyAggregates();
+  }
+  catch (const ValidationException &e)
+  {
+    std::cerr << e.getTechnicalMessage() << std::endl;
+    CHECK(false);
+  }
+  CHECK(manager.getOrderCountByStatus(OrderStatus::COMPLETED) == ORDER_COUNT);
+
+  testFailures();
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Order pipeline test passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * Test for the parallel report aggregation
+ *
+ * Totals must be bit-identical for every thread count and chunk size,
+ * match a plain serial loop, and agree with OrderManager's running
+ * aggregates when scanning real orders.
+ */
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "config/Config.h"
+#include "managers/OrderManager.h"
+#include "managers/ReportAggregation.h"
+#include "TestCheck.h"
+
+static void testFiguresAreDeterministic()
+{
+  std::mt19937_64 random(46);
+  std::vector<OrderFigure> figures;
+  RevenueTotals expected;
+  for (int i = 0; i < 300000; i++)
+  {
+    OrderStatus status = static_cast<OrderStatus>(random() % 4);
+    bool paid = status == OrderStatus::COMPLETED && random() % 2 == 0;
+    bool express = random() % 3 == 0;
+    long long cents = static_cast<long long>(random() % 100000);
+    figures.emplace_back(cents, status, paid, express);
+    expected.add(status, paid, express, cents);
+  }
+
+  CHECK(sizeof(OrderFigure) == 16);
+  for (unsigned threads : {1u, 2u, 3u, 8u})
+  {
+    for (std::size_t chunk : {static_cast<std::size_t>(1000), ReportAggregator::DEFAULT_CHUNK_SIZE,
+                              static_cast<std::size_t>(1000000)})
+    {
+      ReportAggregator aggregator(threads, chunk);
+      CHECK(aggregator.aggregate(figures.data(), figures.size()) == expected);
+    }
+  }
+
+  RevenueTotals empty = ReportAggregator(4).aggregate(figures.data(), 0);
+  CHECK(empty == RevenueTotals());
+  CHECK(expected.expressCents + expected.regularCents == expected.paidCents);
+}
+
+static void testOrdersMatchRunningAggregates()
+{
+  Config config;
+  OrderManager orders(nullptr, &config);
+  Client *client = orders.findOrCreateClient("C001", "Smith");
+  for (int i = 0; i < 5000; i++)
+  {
+    Order *order = orders.createOrder("O" + std::to_string(i), client, "2025-09-01 14:00", i % 4 == 0);
+    orders.addItemToOrder(order, "I" + std::to_string(i), 1 + i % 5, 3.35);
+  }
+  orders.processBacklog(2);
+  orders.processBacklog(2);
+
+  std::vector<long long> paidByHandle;
+  RevenueTotals totals = ReportAggregator(3, 512).aggregate(orders.getAllOrders(), &paidByHandle);
+  CHECK(totals.orderCount == orders.getLoadedOrderCount());
+  CHECK(totals.paidCents == static_cast<long long>(orders.calculateTotalRevenue() * 100.0 + 0.5));
+  CHECK(totals.expressCents == static_cast<long long>(orders.getExpressRevenue() * 100.0 + 0.5));
+  CHECK(totals.statusCounts[RevenueTotals::statusIndex(OrderStatus::COMPLETED)] ==
+        orders.getOrderCountByStatus(OrderStatus::COMPLETED));
+  CHECK(paidByHandle.size() == orders.getAllOrders().size());
+
+  long long handleSum = 0;
+  for (long long cents : paidByHandle)
+  {
+    handleSum += cents;
+  }
+  CHECK(handleSum == totals.paidCents);
+  CHECK(ReportAggregator(1).aggregate(orders.getAllOrders()) == totals);
+}
+
+int main()
+{
+  testFiguresAreDeterministic();
+  testOrdersMatchRunningAggregates();
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Report aggregation test passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * Test for the version-keyed report cache
+ *
+ * Repeated requests must be served from the cache while the managers'
+ * data versions are unchanged, any change must force a rebuild that
+ * replaces the stale report, and the number of kept reports must stay
+ * within the cache capacity.
+ */
+#include <iostream>
+#include <string>
+
+#include "config/Config.h"
+#include "entities/Report.h"
+#include "managers/ConsumableManager.h"
+#include "managers/OrderManager.h"
+#include "managers/ReportManager.h"
+#include "TestCheck.h"
+
+static void testVersionsAndHits()
+{
+  Config config;
+  OrderManager orders(nullptr, &config);
+  ConsumableManager consumables(nullptr);
+  consumables.createConsumable("CON001", "Photo Paper", 1000, "sheets", 0.10);
+  Client *client = orders.findOrCreateClient("C001", "Smith");
+
+  std::uint64_t orderVersion = orders.getDataVersion();
+  Order *order = orders.createOrder("O001", client, "2025-09-01 14:00", false);
+  CHECK(orders.getDataVersion() > orderVersion);
+  orderVersion = orders.getDataVersion();
+  orders.addItemToOrder(order, "I001", 4, 10.0); // Unpaid prices still show in the margin report
+  CHECK(orders.getDataVersion() > orderVersion);
+
+  std::uint64_t usageVersion = consumables.getDataVersion();
+  consumables.recordUsage(ConsumableUsage("U001", "Photo Paper", 10));
+  CHECK(consumables.getDataVersion() > usageVersion);
+
+  ReportManager reports(nullptr);
+  reports.attachOrderFeed(&orders);
+  const Report *revenue = reports.generateRevenueSummaryReport(&orders);
+  const Report *usage = reports.generateConsumablesUsageReport(&consumables);
+  const Report *margin = reports.generateMarginReport(&orders, &consumables);
+  CHECK(reports.getCacheMissCount() == 3);
+
+  // Unchanged data: the same reports come back
+  for (int i = 0; i < 100; i++)
+  {
+    CHECK(reports.generateRevenueSummaryReport(&orders) == revenue);
+    CHECK(reports.generateConsumablesUsageReport(&consumables) == usage);
+    CHECK(reports.generateMarginReport(&orders, &consumables) == margin);
+  }
+  CHECK(reports.getCacheHitCount() == 300);
+  CHECK(reports.getAllReports().size() == 3);
+
+  // Paying the order changes revenue and margin, not usage
+  orders.processOrder(order);
+  orders.completeOrder(order);
+  orders.recordPayment(order);
+  const Report *paidRevenue = reports.generateRevenueSummaryReport(&orders);
+  CHECK(paidRevenue->getContent().find("Total Revenue: $40.000000") != std::string::npos);
+  CHECK(reports.getCacheEvictionCount() == 2); // Revenue and margin were stale
+  CHECK(reports.getAllReports().size() == 2);
+  CHECK(reports.generateConsumablesUsageReport(&consumables) == usage);
+
+  consumables.recordUsage(ConsumableUsage("U002", "Photo Paper", 5));
+  const Report *newUsage = reports.generateConsumablesUsageReport(&consumables);
+  CHECK(newUsage->getContent().find("Photo Paper: 15 units") != std::string::npos);
+  CHECK(reports.getAllReports().size() == 2);
+}
+
+static void testCapacityAndParameters()
+{
+  Config config;
+  OrderManager orders(nullptr, &config);
+  ReportManager reports(nullptr, 4);
+
+  // Dates in the same week share one entry
+  const Report *week = reports.generatePeriodRevenueReport(&orders, RevenuePeriod::WEEK, "2025-09-01");
+  CHECK(reports.generatePeriodRevenueReport(&orders, RevenuePeriod::WEEK, "2025-09-07") == week);
+  CHECK(reports.generatePeriodRevenueReport(&orders, RevenuePeriod::DAY, "2025-09-01") != week);
+
+  for (int day = 1; day <= 20; day++)
+  {
+    std::string date = std::string("2025-10-") + (day < 10 ? "0" : "") + std::to_string(day);
+    reports.generatePeriodRevenueReport(&orders, RevenuePeriod::DAY, date);
+  }
+  CHECK(reports.getAllReports().size() == 4);
+  CHECK(reports.getCacheEvictionCount() == 18);
+
+  bool rejected = false;
+  try
+  {
+    ReportManager empty(nullptr, 0);
+  }
+  catch (const InvalidDataException &)
+  {
+    rejected = true;
+  }
+  CHECK(rejected);
+}
+
+int main()
+{
+  testVersionsAndHits();
+  testCapacityAndParameters();
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Report cache test passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,197 @@
+/**
+ * Test for the materialized revenue and usage report views
+ *
+ * After attaching, the views must follow order creation, status changes,
+ * payments, repricing of paid orders and usage recording without a scan,
+ * agree with the managers' own aggregates, and recount when the change
+ * feed overwrote events they had not read yet, without applying the
+ * events the recount already covered a second time.
+ */
+#include <iostream>
+#include <string>
+
+#include "config/Config.h"
+#include "entities/Report.h"
+#include "managers/ConsumableManager.h"
+#include "managers/OrderManager.h"
+#include "managers/ReportManager.h"
+#include "managers/ReportViews.h"
+#include "TestCheck.h"
+
+static void finish(OrderManager &orders, Order *order)
+{
+  orders.processOrder(order);
+  orders.completeOrder(order);
+  orders.recordPayment(order);
+}
+
+static bool matchesManager(const RevenueReportView &view, const OrderManager &orders)
+{
+  return view.getPaidCents() == static_cast<long long>(orders.calculateTotalRevenue() * 100.0 + 0.5) &&
+         view.getExpressCents() == static_cast<long long>(orders.getExpressRevenue() * 100.0 + 0.5) &&
+         view.getRegularCents() == static_cast<long long>(orders.getRegularRevenue() * 100.0 + 0.5) &&
+         view.getTotalOrders() == orders.getLoadedOrderCount() &&
+         view.getOrderCountByStatus(OrderStatus::PENDING) == orders.getOrderCountByStatus(OrderStatus::PENDING) &&
+         view.getOrderCountByStatus(OrderStatus::COMPLETED) == orders.getOrderCountByStatus(OrderStatus::COMPLETED);
+}
+
+static void testRevenueView()
+{
+  Config config;
+  OrderManager orders(nullptr, &config);
+  Client *client = orders.findOrCreateClient("C001", "Smith");
+
+  // Existing orders are counted once on attach
+  Order *early = orders.createOrder("O001", client, "2025-09-01 14:00", false);
+  orders.addItemToOrder(early, "I001", 4, 10.0);
+  finish(orders, early);
+
+  RevenueReportView view;
+  view.attach(&orders);
+  CHECK(view.isAttachedTo(&orders));
+  CHECK(view.getPaidCents() == 4000);
+  CHECK(view.getTotalOrders() == 1);
+
+  Order *regular = orders.createOrder("O002", client, "2025-09-02 14:00", false);
+  orders.addItemToOrder(regular, "I002", 3, 5.0);
+  Order *express = orders.createOrder("O003", client, "2025-09-02 18:00", true);
+  orders.addItemToOrder(express, "I003", 2, 10.0);
+  finish(orders, regular);
+  finish(orders, express);
+  orders.createOrder("O004", client, "2025-09-03 10:00", false);
+
+  std::uint64_t before = view.getVersion();
+  view.refresh();
+  CHECK(view.getVersion() > before);
+  CHECK(view.getAppliedEventCount() > 0);
+  CHECK(view.getResyncCount() == 0);
+  CHECK(view.getTotalOrders() == 4);
+  CHECK(view.getOrderCountByStatus(OrderStatus::PENDING) == 1);
+  CHECK(view.getOrderCountByStatus(OrderStatus::COMPLETED) == 3);
+  CHECK(view.getRegularCents() == 4000 + 1500);
+  CHECK(matchesManager(view, orders));
+
+  // A price change of a paid order replaces its counted amount
+  orders.addItemToOrder(regular, "I004", 1, 2.5);
+  view.refresh();
+  CHECK(view.getRegularCents() == 4000 + 1750);
+  CHECK(matchesManager(view, orders));
+
+  // Nothing new: refreshing leaves the figures and version alone
+  before = view.getVersion();
+  view.refresh();
+  CHECK(view.getVersion() == before);
+
+  // More events than the feed holds: the view recounts
+  std::size_t burst = orders.getChangeFeed().getCapacity() + 100;
+  for (std::size_t i = 0; i < burst; i++)
+  {
+    orders.createOrder("B" + std::to_string(i), client, "2025-09-04 10:00", false);
+  }
+  view.refresh();
+  CHECK(view.getResyncCount() == 1);
+  CHECK(view.getTotalOrders() == static_cast<int>(4 + burst));
+  CHECK(matchesManager(view, orders));
+
+  // Events published after the overflow are in the recount and must not
+  // be applied again from the ring
+  for (std::size_t i = 0; i < burst; i++)
+  {
+    orders.createOrder("C" + std::to_string(i), client, "2025-09-05 10:00", false);
+  }
+  for (int i = 0; i < 5; i++)
+  {
+    Order *order = orders.findOrderById("C" + std::to_string(i));
+    orders.addItemToOrder(order, "I1", 1, 10.0);
+    finish(orders, order);
+  }
+  view.refresh();
+  CHECK(view.getResyncCount() == 2);
+  CHECK(orders.getChangeFeed().getPendingCount(0) == 0);
+  CHECK(matchesManager(view, orders));
+  before = view.getVersion();
+  view.refresh();
+  CHECK(view.getVersion() == before);
+  CHECK(matchesManager(view, orders));
+
+  view.detach();
+  CHECK(!view.isAttachedTo(&orders));
+}
+
+static void testUsageView()
+{
+  ConsumableManager consumables(nullptr);
+  consumables.createConsumable("CON001", "Photo Paper", 1000, "sheets");
+  consumables.createConsumable("CON002", "Developer", 100, "liters");
+  consumables.recordUsage(ConsumableUsage("U001", "Developer", 3));
+
+  UsageReportView view;
+  view.attach(&consumables);
+  CHECK(view.getTotals().size() == 1);
+
+  consumables.recordUsage(ConsumableUsage("U002", "Photo Paper", 20));
+  consumables.recordUsageBatch({ConsumableUsage("U003", "Developer", 2), ConsumableUsage("U004", "Photo Paper", 5)});
+  StockReservation hold = consumables.reserveStock("Photo Paper", 10);
+  consumables.commitUsage(hold, "U005");
+
+  std::vector<UsageTotal> totals = view.getTotals();
+  CHECK(totals.size() == 2);
+  CHECK(totals[0].consumableName == "Developer" && totals[0].quantity == 5 && totals[0].count == 2);
+  CHECK(totals[1].consumableName == "Photo Paper" && totals[1].quantity == 35 && totals[1].count == 3);
+
+  std::vector<UsageTotal> expected = consumables.getUsageTotals();
+  CHECK(expected.size() == totals.size());
+  for (std::size_t i = 0; i < expected.size() && i < totals.size(); i++)
+  {
+    CHECK(expected[i].consumableName == totals[i].consumableName);
+    CHECK(expected[i].quantity == totals[i].quantity);
+  }
+
+  // Detached views stop following the manager
+  view.detach();
+  consumables.recordUsage(ConsumableUsage("U006", "Developer", 1));
+  CHECK(view.getTotals()[0].quantity == 5);
+}
+
+static void testReportManagerRendersViews()
+{
+  Config config;
+  OrderManager orders(nullptr, &config);
+  ConsumableManager consumables(nullptr);
+  consumables.createConsumable("CON001", "Photo Paper", 1000, "sheets");
+
+  ReportManager reports(nullptr);
+  reports.attachOrderFeed(&orders);
+  reports.attachConsumableFeed(&consumables);
+
+  Client *client = orders.findOrCreateClient("C001", "Smith");
+  Order *order = orders.createOrder("O001", client, "2025-09-01 14:00", false);
+  orders.addItemToOrder(order, "I001", 4, 10.0);
+  finish(orders, order);
+  consumables.recordUsage(ConsumableUsage("U001", "Photo Paper", 12));
+
+  reports.generateRevenueSummaryReport(&orders);
+  reports.generateConsumablesUsageReport(&consumables);
+  CHECK(reports.getAllReports().size() == 2);
+  const std::string &revenue = reports.getAllReports()[0]->getContent();
+  CHECK(revenue.find("Total Revenue: $40.000000") != std::string::npos);
+  CHECK(revenue.find("Total Orders: 1") != std::string::npos);
+  CHECK(revenue.find("Completed Orders: 1") != std::string::npos);
+  CHECK(reports.getAllReports()[1]->getContent().find("Photo Paper: 12 units") != std::string::npos);
+}
+
+int main()
+{
+  testRevenueView();
+  testUsageView();
+  testReportManagerRendersViews();
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Report views test passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,271 @@
+/**
+ * Test for the streaming report writers
+ *
+ * The buffered sink must write exactly the bytes it was given through a
+ * fixed buffer, the CSV and JSON Lines writers must quote and escape
+ * fields correctly, and the ReportManager exports must stream the same
+ * figures as the text reports.
+ */
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "config/Config.h"
+#include "implementations/CsvReportWriter.h"
+#include "implementations/JsonLinesReportWriter.h"
+#include "managers/ConsumableManager.h"
+#include "managers/OrderManager.h"
+#include "managers/ReportManager.h"
+#include "repository/BufferedFileSink.h"
+#include "TestCheck.h"
+
+static std::string readFile(const std::string &path)
+{
+  std::ifstream input(path, std::ios::binary);
+  std::ostringstream content;
+  content << input.rdbuf();
+  return content.str();
+}
+
+static void testSink(const std::string &directory)
+{
+  std::string path = directory + "/sink.txt";
+  std::string expected;
+  {
+    BufferedFileSink sink(path, 16);
+    sink.write("hello");
+    sink.put(' ');
+    std::string large(100, 'x'); // Larger than the buffer: written through
+    sink.write(large);
+    for (int i = 0; i < 50; i++)
+    {
+      sink.write("0123456789", 10);
+    }
+    expected = "hello " + large;
+    for (int i = 0; i < 50; i++)
+    {
+      expected += "0123456789";
+    }
+    CHECK(sink.getBytesWritten() == expected.size());
+    CHECK(sink.getBufferSize() == 16);
+  }
+  CHECK(readFile(path) == expected);
+
+  BufferedFileSink closed(directory + "/closed.txt");
+  closed.write("data");
+  closed.close();
+  CHECK(readFile(directory + "/closed.txt") == "data");
+  bool threw = false;
+  try
+  {
+    closed.write("more");
+  }
+  catch (const InvalidDataException &)
+  {
+    threw = true;
+  }
+  CHECK(threw);
+  threw = false;
+  try
+  {
+    closed.put('!');
+  }
+  catch (const InvalidDataException &e)
+  {
+    threw = e.getUserMessage() == "Report file is closed: " + directory + "/closed.txt";
+  }
+  CHECK(threw);
+  CHECK(closed.getBytesWritten() == 4);
+
+  threw = false;
+  try
+  {
+    BufferedFileSink missing(directory + "/no/such/dir/file.txt");
+  }
+  catch (const InvalidDataException &)
+  {
+    threw = true;
+  }
+  CHECK(threw);
+}
+
+static void testCsv(const std::string &directory)
+{
+  std::string path = directory + "/report.csv";
+  {
+    BufferedFileSink sink(path, 32);
+    CsvReportWriter writer(sink);
+    writer.beginReport("R1", {"name", "count", "ratio", "ok"});
+    writer.writeRow({"plain", 3, 0.5, true});
+    writer.writeRow({"a,b", -7LL, 1.25, false});
+    writer.writeRow({"say \"hi\"", 0U, 2.0, true});
+    writer.writeRow({"two\nlines", 18446744073709551615ULL, -0.125, false});
+    writer.endReport();
+    writer.beginReport("R2", {"only"});
+    writer.writeRow({""});
+    writer.endReport();
+    CHECK(writer.getRowCount() == 5);
+
+    bool threw = false;
+    try
+    {
+      writer.beginReport("R3", {"a", "b"});
+      writer.writeRow({1});
+    }
+    catch (const InvalidDataException &)
+    {
+      threw = true;
+    }
+    CHECK(threw);
+  }
+
+  std::string expected = "name,count,ratio,ok\n"
+                         "plain,3,0.5,true\n"
+                         "\"a,b\",-7,1.25,false\n"
+                         "\"say \"\"hi\"\"\",0,2,true\n"
+                         "\"two\nlines\",18446744073709551615,-0.125,false\n"
+                         "\n"
+                         "only\n"
+                         "\"\"\n"
+                         "\n"
+                         "a,b\n";
+  CHECK(readFile(path) == expected);
+}
+
+static void testJsonLines(const std::string &directory)
+{
+  std::string path = directory + "/report.jsonl";
+  {
+    BufferedFileSink sink(path, 32);
+    JsonLinesReportWriter writer(sink);
+    writer.beginReport("R\"1", {"name", "n", "x", "ok"});
+    writer.writeRow({"plain", 3, 0.5, true});
+    writer.writeRow({std::string("q\"b\\s\n\t\x01", 8), -7LL, std::nan(""), false});
+    writer.endReport();
+    CHECK(writer.getRowCount() == 2);
+  }
+
+  std::string expected = "{\"report\":\"R\\\"1\",\"name\":\"plain\",\"n\":3,\"x\":0.5,\"ok\":true}\n"
+                         "{\"report\":\"R\\\"1\",\"name\":\"q\\\"b\\\\s\\n\\t\\u0001\",\"n\":-7,\"x\":null,\"ok\":false}\n";
+  CHECK(readFile(path) == expected);
+}
+
+static void testExports(const std::string &directory)
+{
+  Config config;
+  OrderManager orders(nullptr, &config);
+  ConsumableManager consumables(nullptr);
+  consumables.createConsumable("CON001", "Photo Paper", 1000, "sheets", 0.10);
+  Client *client = orders.findOrCreateClient("C001", "Smith");
+
+  Order *regular = orders.createOrder("O001", client, "2025-09-01 14:00", false);
+  orders.addItemToOrder(regular, "I001", 4, 10.0);
+  Order *express = orders.createOrder("O002", client, "2025-09-03 10:00", true);
+  orders.addItemToOrder(express, "I002", 1, 20.0);
+  for (Order *order : {regular, express})
+  {
+    orders.processOrder(order);
+    orders.completeOrder(order);
+    orders.recordPayment(order);
+  }
+
+  StockReservation reservation = consumables.reserveStock("Photo Paper", 30);
+  consumables.commitUsage(reservation, "U001", regular->getOrderID());
+
+  ReportManager reports(nullptr);
+  std::string csvPath = directory + "/margin.csv";
+  {
+    BufferedFileSink sink(csvPath);
+    CsvReportWriter writer(sink);
+    reports.exportMarginReport(&orders, &consumables, writer);
+  }
+  std::string margin = readFile(csvPath);
+  long long expressCents = std::llround(express->getTotalPrice() * 100.0);
+  CHECK(margin.rfind("order_id,type,revenue_cents,materials_cents,margin_cents\n", 0) == 0);
+  CHECK(margin.find("O001,REGULAR,4000,300,3700\n") != std::string::npos);
+  CHECK(margin.find("O002,EXPRESS," + std::to_string(expressCents) + ",0,") != std::string::npos);
+  CHECK(margin.find("TOTAL,ALL," + std::to_string(4000 + expressCents) + ",300,") != std::string::npos);
+  CHECK(reports.getAllReports().empty()); // Exports keep nothing
+
+  std::string jsonPath = directory + "/usage.jsonl";
+  {
+    BufferedFileSink sink(jsonPath);
+    JsonLinesReportWriter writer(sink);
+    reports.exportConsumablesUsageReport(&consumables, writer);
+    reports.exportPeriodRevenueReport(&orders, RevenuePeriod::WEEK, "2025-09-03", writer);
+  }
+  std::string lines = readFile(jsonPath);
+  CHECK(lines.find("{\"report\":\"REP_CON_001\",\"consumable\":\"Photo Paper\",\"units\":30,\"uses\":1,"
+                   "\"min\":30,\"max\":30,\"last_used_at\":") == 0);
+  CHECK(lines.find("{\"report\":\"REP_PER_001\",\"date\":\"2025-09-01\",\"paid_cents\":4000,"
+                   "\"express_cents\":0,\"regular_cents\":4000}\n") != std::string::npos);
+  CHECK(lines.find("\"date\":\"2025-09-03\",\"paid_cents\":" + std::to_string(expressCents)) != std::string::npos);
+
+  bool threw = false;
+  try
+  {
+    BufferedFileSink sink(directory + "/bad.csv");
+    CsvReportWriter writer(sink);
+    reports.exportPeriodRevenueReport(&orders, RevenuePeriod::DAY, "2025-13-01", writer);
+  }
+  catch (const InvalidDataException &)
+  {
+    threw = true;
+  }
+  CHECK(threw);
+}
+
+static void testConstantMemory(const std::string &directory)
+{
+  // The sink's buffer is all the memory a report takes, whatever its size
+  std::string path = directory + "/large.csv";
+  const int rows = 200000;
+  std::uint64_t bytes;
+  {
+    BufferedFileSink sink(path, 4096);
+    CsvReportWriter writer(sink);
+    writer.beginReport("LARGE", {"row", "label", "value"});
+    std::string label = "row label";
+    for (int i = 0; i < rows; i++)
+    {
+      writer.writeRow({i, label, i * 0.25});
+    }
+    writer.endReport();
+    CHECK(writer.getRowCount() == static_cast<std::uint64_t>(rows));
+    CHECK(sink.getBufferSize() == 4096);
+    bytes = sink.getBytesWritten();
+  }
+  CHECK(std::filesystem::file_size(path) == bytes);
+}
+
+int main()
+{
+  char directoryTemplate[] = "/tmp/report_writers_test_XXXXXX";
+  const char *directory = mkdtemp(directoryTemplate);
+  CHECK(directory != nullptr);
+  if (!directory)
+  {
+    return 1;
+  }
+
+  testSink(directory);
+  testCsv(directory);
+  testJsonLines(directory);
+  testExports(directory);
+  testConstantMemory(directory);
+
+  std::filesystem::remove_all(directory);
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Report writers test passed" << std::endl;
+  return 0;
+}
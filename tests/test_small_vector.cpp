@@ -0,0 +1,165 @@
+/**
+ * Test for SmallVector
+ *
+ * Elements must stay inline up to N and move to the heap beyond it, copies
+ * and moves must carry every element across, pushing a reference to an
+ * element of a full vector must copy it before it is relocated, and every
+ * constructed element must be destroyed exactly once.
+ */
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "types/SmallVector.h"
+#include "TestCheck.h"
+
+// Counts live instances; a destroyed or moved-from element reads as -1
+struct Tracked
+{
+  static int live;
+  int value;
+
+  explicit Tracked(int v) : value(v) { live++; }
+  Tracked(const Tracked &other) : value(other.value) { live++; }
+  Tracked(Tracked &&other) : value(other.value)
+  {
+    other.value = -1;
+    live++;
+  }
+  Tracked &operator=(const Tracked &other) = default;
+  ~Tracked()
+  {
+    value = -1;
+    live--;
+  }
+};
+
+int Tracked::live = 0;
+
+static void testGrowth()
+{
+  {
+    SmallVector<Tracked, 4> items;
+    for (int i = 0; i < 4; i++)
+    {
+      items.emplace_back(i);
+    }
+    CHECK(!items.isHeapAllocated());
+    CHECK(items.size() == 4);
+
+    for (int i = 4; i < 100; i++)
+    {
+      items.push_back(Tracked(i));
+    }
+    CHECK(items.isHeapAllocated());
+    CHECK(items.size() == 100);
+    bool inOrder = true;
+    for (int i = 0; i < 100; i++)
+    {
+      inOrder = inOrder && items[i].value == i;
+    }
+    CHECK(inOrder);
+    CHECK(Tracked::live == 100);
+
+    items.clear();
+    CHECK(items.empty());
+    CHECK(Tracked::live == 0);
+    items.emplace_back(7);
+    CHECK(items[0].value == 7);
+  }
+  CHECK(Tracked::live == 0);
+}
+
+static void testCopyAndMove()
+{
+  {
+    SmallVector<Tracked, 4> small;
+    small.emplace_back(1);
+    small.emplace_back(2);
+    SmallVector<Tracked, 4> large;
+    for (int i = 0; i < 10; i++)
+    {
+      large.emplace_back(i);
+    }
+
+    SmallVector<Tracked, 4> smallCopy(small);
+    SmallVector<Tracked, 4> largeCopy(large);
+    CHECK(smallCopy.size() == 2 && smallCopy[1].value == 2 && !smallCopy.isHeapAllocated());
+    CHECK(largeCopy.size() == 10 && largeCopy[9].value == 9 && largeCopy.isHeapAllocated());
+    CHECK(small.size() == 2 && large.size() == 10);
+
+    smallCopy = large;
+    CHECK(smallCopy.size() == 10 && smallCopy[5].value == 5);
+    smallCopy = smallCopy;
+    CHECK(smallCopy.size() == 10);
+
+    // Moving an inline vector moves the elements; moving a heap one steals the block
+    const Tracked *largeData = large.begin();
+    SmallVector<Tracked, 4> movedSmall(std::move(small));
+    SmallVector<Tracked, 4> movedLarge(std::move(large));
+    CHECK(movedSmall.size() == 2 && movedSmall[0].value == 1 && !movedSmall.isHeapAllocated());
+    CHECK(movedLarge.size() == 10 && movedLarge.begin() == largeData);
+    CHECK(small.empty() && large.empty() && !large.isHeapAllocated());
+
+    large.emplace_back(42); // A moved-from vector is usable again
+    CHECK(large.size() == 1 && large[0].value == 42);
+
+    movedSmall = std::move(movedLarge);
+    CHECK(movedSmall.size() == 10 && movedSmall[9].value == 9);
+    CHECK(movedLarge.empty());
+    CHECK(Tracked::live == 10 + 10 + 10 + 1 + 0); // small/large copies, moved, large
+  }
+  CHECK(Tracked::live == 0);
+}
+
+static void testSelfAliasingPush()
+{
+  {
+    // Full inline buffer: push_back(v[0]) has to spill to the heap
+    SmallVector<Tracked, 2> items;
+    items.emplace_back(10);
+    items.emplace_back(20);
+    items.push_back(items[0]);
+    CHECK(items.isHeapAllocated());
+    CHECK(items.size() == 3);
+    CHECK(items[0].value == 10 && items[1].value == 20 && items[2].value == 10);
+
+    // Full heap block (capacity 4)
+    items.push_back(items[1]);
+    CHECK(items.size() == 4);
+    items.push_back(items[3]);
+    CHECK(items.size() == 5 && items[4].value == 20);
+
+    // Moving out of an element of a full vector
+    items.push_back(items[1]);
+    items.push_back(items[2]);
+    items.push_back(items[0]);
+    CHECK(items.size() == 8);
+    items.push_back(std::move(items[7]));
+    CHECK(items.size() == 9 && items[8].value == 10 && items[7].value == -1);
+    CHECK(Tracked::live == 9);
+  }
+  CHECK(Tracked::live == 0);
+
+  SmallVector<std::string, 1> names;
+  names.push_back(std::string(64, 'x'));
+  names.push_back(names[0]);
+  names.push_back(names[1]);
+  CHECK(names.size() == 3 && names[2] == std::string(64, 'x'));
+}
+
+int main()
+{
+  testGrowth();
+  testCopyAndMove();
+  testSelfAliasingPush();
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Small vector test passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,149 @@
+/**
+ * Test for reorder-level stock alerts
+ *
+ * A stock level hovering around the reorder level must produce a single
+ * LOW_STOCK alert until it climbs past the hysteresis band, and racing
+ * threads must not duplicate an alert for the same crossing or leave the
+ * alert state out of step with the stock. Changing the reorder level must
+ * check the stock on hand against the new level straight away.
+ */
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "managers/ConsumableManager.h"
+#include "TestCheck.h"
+
+class CountingListener : public IStockAlertListener
+{
+public:
+  std::atomic<int> low{0};
+  std::atomic<int> recovered{0};
+  std::atomic<int> lastStock{0};
+
+  void onStockAlert(const StockAlert &alert) override
+  {
+    if (alert.type == StockAlertType::LOW_STOCK)
+    {
+      low++;
+    }
+    else
+    {
+      recovered++;
+    }
+    lastStock = alert.stock;
+  }
+};
+
+static const int THREAD_COUNT = 8;
+
+int main()
+{
+  ConsumableManager manager(nullptr);
+  CountingListener listener;
+  manager.addStockAlertListener(&listener);
+  Consumable *paper = manager.createConsumable("CON001", "Photo Paper", 120, "sheets");
+  manager.setReorderLevel("Photo Paper", 100, 20);
+
+  // No alert above the level
+  manager.recordUsage(ConsumableUsage("U1", "Photo Paper", 10));
+  CHECK(listener.low == 0);
+
+  // Crossing alerts once; hovering inside the band stays quiet
+  manager.recordUsage(ConsumableUsage("U2", "Photo Paper", 15));
+  CHECK(listener.low == 1 && listener.lastStock == 95);
+  CHECK(paper->isLowStock());
+  manager.updateStock("Photo Paper", 10); // 105: above the level, inside the band
+  manager.recordUsage(ConsumableUsage("U3", "Photo Paper", 8));
+  manager.updateStock("Photo Paper", 15); // 112
+  CHECK(listener.low == 1 && listener.recovered == 0);
+
+  // Leaving the band recovers and re-arms the alert
+  manager.updateStock("Photo Paper", 10); // 122
+  CHECK(listener.recovered == 1 && !paper->isLowStock());
+  StockReservation hold = manager.reserveStock("Photo Paper", 30);
+  manager.commitUsage(hold, "U4"); // 92
+  CHECK(listener.low == 2);
+
+  // Changing the level checks the stock on hand at once
+  manager.setReorderLevel("Photo Paper", 50, 10); // 92: no longer low
+  CHECK(listener.recovered == 2 && !paper->isLowStock());
+  manager.setReorderLevel("Photo Paper", 92);
+  CHECK(listener.low == 3 && listener.lastStock == 92 && paper->isLowStock());
+  manager.setReorderLevel("Photo Paper", 100, 20); // Still low: no new alert
+  CHECK(listener.low == 3 && listener.recovered == 2 && paper->isLowStock());
+
+  // Racing consumers and restockers around the level: alerts alternate,
+  // so the counts can differ by at most one
+  Consumable developer("CON002", "Developer", 1000, "liters");
+  manager.addConsumable(&developer);
+  manager.setReorderLevel("Developer", 500, 50);
+  CountingListener raceListener;
+  developer.addAlertListener(&raceListener);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREAD_COUNT; t++)
+  {
+    threads.emplace_back([&, t]()
+                         {
+      for (int i = 0; i < 2000; i++)
+      {
+        if ((i + t) % 2 == 0)
+        {
+          developer.tryConsume(7);
+        }
+        else
+        {
+          developer.updateStock(7, nullptr);
+        }
+      } });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  int difference = raceListener.low - raceListener.recovered;
+  CHECK(difference == 0 || difference == 1);
+  CHECK(developer.isLowStock() == (difference == 1));
+
+  // Racing across the level: every round ends back at the starting stock,
+  // so the alert state must have recovered and the alerts must pair up
+  Consumable toner("CON003", "Toner", 530, "cartridges");
+  toner.setReorderLevel(500, 0);
+  CountingListener tonerListener;
+  toner.addAlertListener(&tonerListener);
+  for (int round = 0; round < 50; round++)
+  {
+    std::vector<std::thread> crossers;
+    for (int t = 0; t < THREAD_COUNT; t++)
+    {
+      crossers.emplace_back([&toner]()
+                            {
+        for (int i = 0; i < 200; i++)
+        {
+          if (toner.tryConsume(60))
+          {
+            toner.updateStock(60, nullptr);
+          }
+        } });
+    }
+    for (auto &thread : crossers)
+    {
+      thread.join();
+    }
+    CHECK(toner.getCurrentStock() == 530);
+    CHECK(!toner.isLowStock());
+    CHECK(tonerListener.low == tonerListener.recovered);
+  }
+  CHECK(tonerListener.low > 0);
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Stock alert test passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,154 @@
+/**
+ * Stress test for lock-free consumable stock
+ *
+ * Threads race to reserve, commit, release and directly consume two
+ * consumables until stock runs out. Stock must never go negative, no
+ * reservation may be left behind, and what was taken must equal what
+ * the successful calls asked for.
+ */
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "managers/ConsumableManager.h"
+#include "TestCheck.h"
+
+static const int THREAD_COUNT = 8;
+static const int ROUNDS_PER_THREAD = 2000;
+static const int PAPER_STOCK = 20000;
+static const int DEVELOPER_STOCK = 3000;
+
+int main()
+{
+  ConsumableManager manager(nullptr);
+  Consumable paper("CON001", "Photo Paper", PAPER_STOCK, "sheets");
+  Consumable developer("CON002", "Developer", DEVELOPER_STOCK, "liters");
+  manager.addConsumable(&paper);
+  manager.addConsumable(&developer);
+
+  std::atomic<int> paperTaken(0);
+  std::atomic<int> developerTaken(0);
+  std::atomic<int> committedJobs(0);
+  std::atomic<int> rejected(0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREAD_COUNT; t++)
+  {
+    threads.emplace_back([&, t]()
+                         {
+      for (int i = 0; i < ROUNDS_PER_THREAD; i++)
+      {
+        // A print job holds paper and developer together, then commits or gives up
+        try
+        {
+          StockReservation paperHold = manager.reserveStock("Photo Paper", 3);
+          StockReservation developerHold = manager.reserveStock("Developer", 1);
+          if (i % 4 != 0)
+          {
+            manager.commitUsage(paperHold, "U" + std::to_string(t) + "-" + std::to_string(i) + "p");
+            manager.commitUsage(developerHold, "U" + std::to_string(t) + "-" + std::to_string(i) + "d");
+            paperTaken += 3;
+            developerTaken += 1;
+            committedJobs++;
+          }
+          // Every fourth job is abandoned: both holds are released on scope exit
+        }
+        catch (const InsufficientStockException &)
+        {
+          rejected++;
+        }
+
+        try
+        {
+          manager.recordUsage(ConsumableUsage("D" + std::to_string(t) + "-" + std::to_string(i), "Photo Paper", 1));
+          paperTaken += 1;
+        }
+        catch (const InsufficientStockException &)
+        {
+          rejected++;
+        }
+      } });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  CHECK(paper.getCurrentStock() >= 0);
+  CHECK(developer.getCurrentStock() >= 0);
+  CHECK(paper.getReservedStock() == 0);
+  CHECK(developer.getReservedStock() == 0);
+  CHECK(PAPER_STOCK - paper.getCurrentStock() == paperTaken.load());
+  CHECK(DEVELOPER_STOCK - developer.getCurrentStock() == developerTaken.load());
+  CHECK(static_cast<int>(manager.getRecordedUsageCount()) ==
+        2 * committedJobs.load() + (paperTaken.load() - 3 * committedJobs.load()));
+  CHECK(manager.getTotalUsage("Photo Paper") == paperTaken.load());
+  CHECK(manager.getTotalUsage("Developer") == developerTaken.load());
+  CHECK(rejected.load() > 0); // The run is sized to exhaust developer stock
+
+  // Stock cannot be cut below what is reserved
+  manager.updateStock("Photo Paper", 10);
+  StockReservation hold = paper.reserve(paper.getAvailableStock());
+  CHECK(hold.isActive());
+  bool blocked = false;
+  try
+  {
+    paper.updateStock(-1, nullptr);
+  }
+  catch (const BusinessRuleException &)
+  {
+    blocked = true;
+  }
+  CHECK(blocked);
+  hold.release();
+  CHECK(paper.getReservedStock() == 0);
+
+  // A usage batch is applied completely or not at all
+  Consumable ink("CON003", "Ink", 100, "ml");
+  manager.addConsumable(&ink);
+  int paperBefore = paper.getCurrentStock();
+  std::uint64_t recordedBefore = manager.getRecordedUsageCount();
+
+  std::vector<ConsumableUsage> job = {
+      ConsumableUsage("B1", "Photo Paper", 2),
+      ConsumableUsage("B2", "Ink", 60),
+      ConsumableUsage("B3", "Ink", 60)}; // 120 ml of ink in total, only 100 in stock
+  ValidationResult result = manager.tryRecordUsageBatch(job);
+  CHECK(result.getCode() == ErrorCode::INSUFFICIENT_STOCK);
+  CHECK(paper.getCurrentStock() == paperBefore);
+  CHECK(paper.getReservedStock() == 0);
+  CHECK(ink.getCurrentStock() == 100);
+  CHECK(manager.getRecordedUsageCount() == recordedBefore);
+
+  job.pop_back();
+  job.push_back(ConsumableUsage("B4", "Toner", 1));
+  bool notFound = false;
+  try
+  {
+    manager.recordUsageBatch(job);
+  }
+  catch (const DataNotFoundException &)
+  {
+    notFound = true;
+  }
+  CHECK(notFound);
+  CHECK(ink.getCurrentStock() == 100);
+
+  job.pop_back();
+  manager.recordUsageBatch(job);
+  CHECK(paper.getCurrentStock() == paperBefore - 2);
+  CHECK(ink.getCurrentStock() == 40);
+  CHECK(manager.getRecordedUsageCount() == recordedBefore + 2);
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Stock concurrency test passed (" << committedJobs.load() << " jobs committed, "
+            << rejected.load() << " rejected)" << std::endl;
+  return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * Test for the hash-aggregated usage totals
+ *
+ * The flat index must hand out dense IDs without rehashing once sized,
+ * every usage path must keep units, count, min, max and last use per
+ * consumable, the extremes must survive a snapshot round trip, and
+ * snapshots written before they were kept must still load.
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "managers/ConsumableManager.h"
+#include "managers/ReportViews.h"
+#include "repository/UsageStore.h"
+#include "types/FlatStringIndex.h"
+#include "TestCheck.h"
+
+// 2024-01-01 00:00:00 UTC
+static const std::int64_t START = 1704067200;
+
+static void testFlatIndex()
+{
+  FlatStringIndex index(1000);
+  std::size_t slots = index.getSlotCount();
+  CHECK(slots >= 2000);
+
+  for (int i = 0; i < 1000; i++)
+  {
+    auto inserted = index.insert("C" + std::to_string(i));
+    CHECK(inserted.second && inserted.first == static_cast<std::size_t>(i));
+  }
+  CHECK(index.getSlotCount() == slots); // Pre-sized: no rehash
+  CHECK(index.size() == 1000);
+  CHECK(index.find("C737") == 737);
+  CHECK(index.getKey(737) == "C737");
+  CHECK(index.find("C1000") == FlatStringIndex::NOT_FOUND);
+  CHECK(!index.insert("C5").second);
+
+  // Growing past the reserved size still works
+  for (int i = 1000; i < 5000; i++)
+  {
+    index.insert("C" + std::to_string(i));
+  }
+  CHECK(index.find("C4999") == 4999 && index.find("C0") == 0);
+
+  index.clear();
+  CHECK(index.size() == 0 && index.find("C0") == FlatStringIndex::NOT_FOUND);
+}
+
+static void testExtremesAndSnapshot()
+{
+  UsageStore store;
+  store.reserve(2);
+  store.record(ConsumableUsage("U001", "Photo Paper", 10, START + 5));
+  store.record(ConsumableUsage("U002", "Photo Paper", 30, START + 500));
+  store.record(ConsumableUsage("U003", "Photo Paper", 4, START + 50)); // Late
+  store.record(ConsumableUsage("U004", "Developer", 2, START + 90));
+
+  std::vector<UsageTotal> totals = store.getTotals();
+  CHECK(totals.size() == 2);
+  CHECK(totals[0].quantity == 44 && totals[0].count == 3);
+  CHECK(totals[0].minQuantity == 4 && totals[0].maxQuantity == 30);
+  CHECK(totals[0].lastUsedAt == START + 500);
+  CHECK(totals[1].minQuantity == 2 && totals[1].maxQuantity == 2 && totals[1].lastUsedAt == START + 90);
+
+  std::vector<unsigned char> bytes;
+  store.serialize(bytes);
+  UsageStore restored;
+  CHECK(restored.deserialize(bytes.data(), bytes.size()));
+  std::vector<UsageTotal> again = restored.getTotals();
+  CHECK(again.size() == 2);
+  CHECK(again[0].minQuantity == 4 && again[0].maxQuantity == 30 && again[0].lastUsedAt == START + 500);
+  CHECK(restored.getTotalQuantity("Developer") == 2);
+
+  // Older layout: the same series header without the 16 bytes of extremes
+  UsageStore single;
+  single.record(ConsumableUsage("U005", "Ink", 6, START + 7200));
+  std::vector<unsigned char> oldBytes;
+  single.serialize(oldBytes);
+  oldBytes.erase(oldBytes.begin() + 16 + 32, oldBytes.begin() + 16 + 48);
+  CHECK(restored.deserialize(oldBytes.data(), oldBytes.size(), false));
+  CHECK(restored.getTotals().size() == 1 && restored.getTotalQuantity("Ink") == 6);
+  CHECK(restored.getTotals()[0].lastUsedAt == START); // Newest day bucket
+  CHECK(!restored.getTotals()[0].hasExtremes()); // Not known, not zero
+  restored.record(ConsumableUsage("U006", "Ink", 3, START + 7300));
+  CHECK(restored.getTotals()[0].minQuantity == 3 && restored.getTotals()[0].maxQuantity == 3);
+  CHECK(!restored.deserialize(oldBytes.data(), oldBytes.size(), true));
+}
+
+static void testManagerAndView()
+{
+  ConsumableManager consumables(nullptr);
+  consumables.createConsumable("CON001", "Photo Paper", 1000, "sheets");
+  consumables.createConsumable("CON002", "Developer", 100, "liters");
+
+  UsageReportView view;
+  view.attach(&consumables);
+  consumables.recordUsage(ConsumableUsage("U001", "Photo Paper", 12, START + 10));
+  consumables.recordUsageBatch({ConsumableUsage("U002", "Photo Paper", 3, START + 20),
+                                ConsumableUsage("U003", "Developer", 1, START + 30)});
+  StockReservation hold = consumables.reserveStock("Photo Paper", 7);
+  consumables.commitUsage(hold, "U004");
+
+  std::vector<UsageTotal> fromView = view.getTotals();
+  std::vector<UsageTotal> fromStore = consumables.getUsageTotals();
+  CHECK(fromView.size() == 2 && fromStore.size() == 2);
+  CHECK(fromView[0].quantity == 22 && fromView[0].count == 3);
+  CHECK(fromView[0].minQuantity == 3 && fromView[0].maxQuantity == 12);
+  CHECK(fromView[0].lastUsedAt >= START + 20); // commitUsage stamps the current time
+  for (std::size_t i = 0; i < fromView.size() && i < fromStore.size(); i++)
+  {
+    CHECK(fromView[i].consumableName == fromStore[i].consumableName);
+    CHECK(fromView[i].count == fromStore[i].count);
+    CHECK(fromView[i].minQuantity == fromStore[i].minQuantity);
+    CHECK(fromView[i].maxQuantity == fromStore[i].maxQuantity);
+    CHECK(fromView[i].lastUsedAt == fromStore[i].lastUsedAt);
+  }
+}
+
+int main()
+{
+  testFlatIndex();
+  testExtremesAndSnapshot();
+  testManagerAndView();
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Usage aggregation test passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * Unit test for the time-bucketed usage store
+ *
+ * Checks the minute/hour/day rollups, late records, range queries and
+ * that both the raw tail and the bucket count stay bounded when far more
+ * usage is recorded than any retention limit.
+ */
+#include <iostream>
+#include <string>
+
+#include "repository/UsageStore.h"
+#include "TestCheck.h"
+
+// 2024-01-01 00:00:00 UTC
+static const std::int64_t START = 1704067200;
+
+int main()
+{
+  UsageStore store(4);
+
+  store.record(ConsumableUsage("U001", "Photo Paper", 10, START + 5));
+  store.record(ConsumableUsage("U002", "Photo Paper", 20, START + 50));
+  store.record(ConsumableUsage("U003", "Developer", 2, START + 90));
+  store.record(ConsumableUsage("U004", "Photo Paper", 5, START + 3600 + 10));
+  store.record(ConsumableUsage("U005", "Photo Paper", 1, START + 30)); // Late
+
+  CHECK(store.getRecordedCount() == 5);
+  CHECK(store.getTotalQuantity("Photo Paper") == 36);
+  CHECK(store.getTotalQuantity("Developer") == 2);
+  CHECK(store.getTotalQuantity("Toner") == 0);
+
+  std::vector<UsageTotal> totals = store.getTotals();
+  CHECK(totals.size() == 2);
+  CHECK(totals[0].consumableName == "Photo Paper" && totals[0].count == 4);
+  CHECK(totals[1].consumableName == "Developer" && totals[1].quantity == 2);
+
+  std::vector<UsageBucket> minutes = store.getHistory("Photo Paper", UsageGranularity::MINUTE, START, START + 7200);
+  CHECK(minutes.size() == 2);
+  CHECK(minutes[0].start == START && minutes[0].quantity == 31 && minutes[0].count == 3);
+  CHECK(minutes[1].start == START + 3600 && minutes[1].quantity == 5);
+
+  std::vector<UsageBucket> hours = store.getHistory("Photo Paper", UsageGranularity::HOUR, START + 3600, START + 7200);
+  CHECK(hours.size() == 1 && hours[0].quantity == 5);
+
+  std::vector<UsageBucket> days = store.getHistory("Photo Paper", UsageGranularity::DAY, START, START + 86400);
+  CHECK(days.size() == 1 && days[0].quantity == 36 && days[0].count == 4);
+
+  // Raw records keep only the newest ones
+  CHECK(store.getRecentUsage().size() == 4);
+  CHECK(store.getRecentUsage().front().getUsageID() == "U002");
+
+  // A year of one usage per minute: memory stays bounded, totals stay exact
+  UsageStore yearly(16);
+  const int MINUTES = 365 * 24 * 60;
+  for (int i = 0; i < MINUTES; i++)
+  {
+    yearly.record(ConsumableUsage("U" + std::to_string(i), "Photo Paper", 1, START + 60LL * i));
+  }
+  CHECK(yearly.getTotalQuantity("Photo Paper") == MINUTES);
+  CHECK(yearly.getRecentUsage().size() == 16);
+  CHECK(yearly.getBucketCount() <= UsageStore::MINUTE_BUCKETS + UsageStore::HOUR_BUCKETS + UsageStore::DAY_BUCKETS);
+  std::vector<UsageBucket> year = yearly.getHistory("Photo Paper", UsageGranularity::DAY, START, START + 366LL * 86400);
+  CHECK(year.size() == 365);
+  CHECK(year.back().quantity == 24 * 60);
+
+  // Records older than the retained minute window are still counted in the
+  // coarser rollups that cover them
+  yearly.record(ConsumableUsage("ULATE", "Photo Paper", 7, START + 60));
+  CHECK(yearly.getTotalQuantity("Photo Paper") == MINUTES + 7);
+  CHECK(yearly.getHistory("Photo Paper", UsageGranularity::DAY, START, START + 1)[0].quantity == 24 * 60 + 7);
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Usage store test passed (" << yearly.getBucketCount() << " buckets for "
+            << yearly.getRecordedCount() << " records)" << std::endl;
+  return 0;
+}
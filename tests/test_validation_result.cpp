@@ -0,0 +1,201 @@
+/**
+ * Test for ValidationResult and the try* validators
+ *
+ * Every error code must raise its matching exception from throwIfError,
+ * the user message must be put together from the static text and the
+ * subject only when asked for, and each try* validator must report the
+ * same code and messages as the throwing API layered on top of it. Stock
+ * changes past the packed field's maximum must be rejected, not wrapped.
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "config/Config.h"
+#include "entities/Consumable.h"
+#include "entities/ConsumableUsage.h"
+#include "managers/ConsumableManager.h"
+#include "managers/OrderManager.h"
+#include "orders/Order.h"
+#include "TestCheck.h"
+
+// The throwing call must raise Expected with the messages of 'result'
+template <typename Expected, typename Action>
+static void checkSameFailure(const ValidationResult &result, Action action)
+{
+  CHECK(!result.isOk());
+  try
+  {
+    action();
+    CHECK(false);
+  }
+  catch (const Expected &e)
+  {
+    CHECK(e.getUserMessage() == result.getUserMessage());
+    CHECK(e.getTechnicalMessage() == result.getTechnicalMessage());
+  }
+  catch (const PhotoStudioException &e)
+  {
+    std::cerr << "Unexpected exception: " << e.getUserMessage() << std::endl;
+    CHECK(false);
+  }
+}
+
+template <typename Expected>
+static void checkCode(ErrorCode code)
+{
+  ValidationResult result = ValidationResult::failure(code, "User text", "Technical text");
+  CHECK(result.getCode() == code);
+  checkSameFailure<Expected>(result, [&]() { result.throwIfError(); });
+}
+
+static void testResult()
+{
+  ValidationResult ok = ValidationResult::ok();
+  CHECK(ok.isOk() && static_cast<bool>(ok) && ok.getCode() == ErrorCode::NONE);
+  CHECK(ok.getUserMessage().empty() && ok.getTechnicalMessage().empty());
+  ok.throwIfError(); // Must not throw
+
+  // The subject is only appended when the message is read
+  std::string subject = "A1";
+  ValidationResult missing = ValidationResult::failure(ErrorCode::NOT_FOUND, "Missing: ", "Lookup failed", subject);
+  CHECK(!missing && missing.getCode() == ErrorCode::NOT_FOUND);
+  subject[1] = '2';
+  CHECK(missing.getUserMessage() == "Missing: A2");
+  CHECK(missing.getTechnicalMessage() == "Lookup failed");
+
+  checkCode<InvalidDataException>(ErrorCode::INVALID_DATA);
+  checkCode<ValidationException>(ErrorCode::VALIDATION);
+  checkCode<BusinessRuleException>(ErrorCode::BUSINESS_RULE);
+  checkCode<DataNotFoundException>(ErrorCode::NOT_FOUND);
+  checkCode<InsufficientStockException>(ErrorCode::INSUFFICIENT_STOCK);
+  checkCode<DuplicateDataException>(ErrorCode::DUPLICATE);
+  checkSameFailure<DataNotFoundException>(missing, [&]() { missing.throwIfError(); });
+}
+
+static void testEntityValidators()
+{
+  Client client("C1", "Smith");
+  CHECK(Order::tryValidate("O1", "2025-09-01 14:00", &client).isOk());
+  ValidationResult noTime = Order::tryValidate("O1", "", &client);
+  CHECK(noTime.getCode() == ErrorCode::INVALID_DATA && noTime.getUserMessage() == "Completion time cannot be empty");
+  checkSameFailure<InvalidDataException>(noTime, [&]() { Order order("O1", "", &client); });
+  checkSameFailure<InvalidDataException>(Order::tryValidate("O1", "2025-09-01 14:00", nullptr),
+                                         [&]() { Order order("O1", "2025-09-01 14:00", nullptr); });
+
+  CHECK(Consumable::tryValidate("CON1", "Paper", 10, "sheets", 0.1).isOk());
+  ValidationResult negative = Consumable::tryValidate("CON1", "Paper", -1, "sheets", 0.1);
+  CHECK(negative.getUserMessage() == "Initial stock cannot be negative");
+  checkSameFailure<InvalidDataException>(negative, []() { Consumable paper("CON1", "Paper", -1, "sheets", 0.1); });
+  checkSameFailure<InvalidDataException>(Consumable::tryValidate("CON1", "Paper", 1, "", 0.1),
+                                         []() { Consumable paper("CON1", "Paper", 1, "", 0.1); });
+  CHECK(!Consumable::tryValidate("CON1", "Paper", 1, "sheets", -0.5));
+
+  CHECK(ConsumableUsage::tryValidate("U1", "Paper", 1).isOk());
+  checkSameFailure<InvalidDataException>(ConsumableUsage::tryValidate("U1", "Paper", 0),
+                                         []() { ConsumableUsage usage("U1", "Paper", 0); });
+  checkSameFailure<InvalidDataException>(ConsumableUsage::tryValidate("", "Paper", 1),
+                                         []() { ConsumableUsage usage("", "Paper", 1); });
+}
+
+static void testManagerValidators()
+{
+  Config config;
+  OrderManager orders(nullptr, &config);
+  Client *client = orders.findOrCreateClient("C1", "Smith");
+  CHECK(orders.tryValidateOrderCreation("O1", client, "2025-09-01 14:00").isOk());
+  orders.createOrder("O1", client, "2025-09-01 14:00", false);
+
+  std::string duplicateID = "O1";
+  ValidationResult duplicate = orders.tryValidateOrderCreation(duplicateID, client, "2025-09-01 14:00");
+  CHECK(duplicate.getCode() == ErrorCode::DUPLICATE && duplicate.getUserMessage() == "Order ID already exists: O1");
+  checkSameFailure<DuplicateDataException>(
+      duplicate, [&]() { orders.createOrder(duplicateID, client, "2025-09-01 14:00", false); });
+  checkSameFailure<InvalidDataException>(orders.tryValidateOrderCreation("O2", nullptr, "2025-09-01 14:00"),
+                                         [&]() { orders.createOrder("O2", nullptr, "2025-09-01 14:00", false); });
+  CHECK(orders.getLoadedOrderCount() == 1);
+
+  Order *order = orders.findOrderById("O1");
+  CHECK(orders.tryValidateOrderItem("I1", 1, 10.0).isOk());
+  checkSameFailure<InvalidDataException>(orders.tryValidateOrderItem("I1", 1, -1.0),
+                                         [&]() { orders.addItemToOrder(order, "I1", 1, -1.0); });
+  checkSameFailure<InvalidDataException>(orders.tryValidateOrderItem("", 1, 1.0),
+                                         [&]() { orders.addItemToOrder(order, "", 1, 1.0); });
+  CHECK(order->getItems().empty());
+
+  ConsumableManager consumables(nullptr);
+  Consumable *paper = consumables.createConsumable("CON1", "Paper", 10, "sheets");
+  ConsumableUsage unknown("U1", "Ink", 1);
+  ValidationResult notFound = consumables.tryValidateConsumableUsage(unknown);
+  CHECK(notFound.getCode() == ErrorCode::NOT_FOUND && notFound.getUserMessage() == "Consumable not found: Ink");
+  checkSameFailure<DataNotFoundException>(notFound, [&]() { consumables.recordUsage(unknown); });
+  CHECK(consumables.tryValidateConsumableUsage(ConsumableUsage("U2", "Paper", 4)).isOk());
+
+  // A batch that cannot be covered fails as a whole and leaves stock alone
+  std::vector<ConsumableUsage> tooMuch = {ConsumableUsage("U3", "Paper", 6), ConsumableUsage("U4", "Paper", 6)};
+  ValidationResult shortage = consumables.tryRecordUsageBatch(tooMuch);
+  CHECK(shortage.getCode() == ErrorCode::INSUFFICIENT_STOCK);
+  CHECK(shortage.getUserMessage() == "Insufficient stock for Paper");
+  CHECK(paper->getCurrentStock() == 10 && paper->getReservedStock() == 0);
+  checkSameFailure<InsufficientStockException>(shortage, [&]() { consumables.recordUsageBatch(tooMuch); });
+  CHECK(consumables.tryRecordUsageBatch({ConsumableUsage("U5", "Paper", 6)}).isOk());
+  CHECK(paper->getCurrentStock() == 4);
+}
+
+static void testStockLimits()
+{
+  ConsumableManager consumables(nullptr);
+  Consumable *paper = consumables.createConsumable("CON1", "Paper", Consumable::MAX_STOCK - 5, "sheets");
+
+  // Past the packed field: rejected and the stock is left alone
+  bool threw = false;
+  try
+  {
+    paper->updateStock(10, nullptr);
+  }
+  catch (const InvalidDataException &)
+  {
+    threw = true;
+  }
+  CHECK(threw);
+  threw = false;
+  try
+  {
+    consumables.updateStock("Paper", 6);
+  }
+  catch (const InvalidDataException &)
+  {
+    threw = true;
+  }
+  CHECK(threw);
+  CHECK(paper->getCurrentStock() == Consumable::MAX_STOCK - 5);
+
+  // Up to the maximum is fine, and so is reserving all of it
+  consumables.updateStock("Paper", 5);
+  CHECK(paper->getCurrentStock() == Consumable::MAX_STOCK);
+  CHECK(paper->tryReserve(Consumable::MAX_STOCK - 1));
+  CHECK(!paper->tryReserve(Consumable::MAX_STOCK));
+  CHECK(paper->tryReserve(1) && !paper->tryReserve(1));
+  CHECK(paper->getReservedStock() == Consumable::MAX_STOCK && paper->getAvailableStock() == 0);
+  ValidationResult shortage = consumables.tryRecordUsageBatch({ConsumableUsage("U1", "Paper", 1)});
+  CHECK(shortage.getCode() == ErrorCode::INSUFFICIENT_STOCK);
+  paper->releaseReserved(Consumable::MAX_STOCK);
+  CHECK(paper->getCurrentStock() == Consumable::MAX_STOCK && paper->getAvailableStock() == Consumable::MAX_STOCK);
+}
+
+int main()
+{
+  testResult();
+  testEntityValidators();
+  testManagerValidators();
+  testStockLimits();
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Validation result test passed" << std::endl;
+  return 0;
+}
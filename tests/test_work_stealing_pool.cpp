@@ -0,0 +1,198 @@
+/**
+ * Test for WorkStealingPool and OrderManager::processBacklog
+ *
+ * Tasks a busy worker pushes onto its own deque must be stolen by the
+ * others, waitIdle() must cover tasks submitted from inside tasks, and a
+ * task that throws must be counted without stopping the pool. The
+ * backlog must advance every queued order with no failed tasks and put
+ * concurrent mode back the way it found it, even when it throws.
+ */
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "concurrency/WorkStealingPool.h"
+#include "config/Config.h"
+#include "managers/OrderManager.h"
+#include "repository/OrderRepository.h"
+#include "TestCheck.h"
+
+static const int SUBTASK_COUNT = 64;
+
+// Display whose output fails once broken, as a closed terminal or pipe would
+class BreakableDisplay : public IDisplay
+{
+public:
+  bool broken = false;
+
+  void show(const std::string &) const override { fail(); }
+  void showLine(const std::string &) const override { fail(); }
+
+private:
+  void fail() const
+  {
+    if (broken)
+    {
+      throw std::runtime_error("display failed");
+    }
+  }
+};
+
+static void testStealing()
+{
+  WorkStealingPool pool(4);
+  CHECK(pool.getThreadCount() == 4);
+
+  std::atomic<int> done(0);
+  std::atomic<bool> ownerRanOne(false);
+  std::thread::id owner;
+  std::mutex threadsMutex;
+  std::set<std::thread::id> thieves;
+
+  // The parent fills its own deque and then stays busy until every
+  // subtask has run, so each one must have been stolen
+  pool.submit([&]()
+              {
+    owner = std::this_thread::get_id();
+    for (int i = 0; i < SUBTASK_COUNT; i++)
+    {
+      pool.submit([&]()
+                  {
+        if (std::this_thread::get_id() == owner)
+        {
+          ownerRanOne = true;
+        }
+        {
+          std::lock_guard<std::mutex> lock(threadsMutex);
+          thieves.insert(std::this_thread::get_id());
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        done++; });
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (done.load() < SUBTASK_COUNT && std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::yield();
+    } });
+
+  pool.waitIdle();
+  CHECK(done.load() == SUBTASK_COUNT);
+  CHECK(!ownerRanOne.load());
+  CHECK(pool.getStealCount() >= static_cast<std::uint64_t>(SUBTASK_COUNT));
+  CHECK(!thieves.empty() && thieves.size() <= 3);
+  CHECK(pool.getFailedTaskCount() == 0);
+}
+
+static void testWaitIdleAndFailures()
+{
+  WorkStealingPool pool(3);
+  pool.waitIdle(); // Nothing submitted: returns at once
+
+  // Tasks that fan out further must all be finished when waitIdle returns
+  std::atomic<int> leaves(0);
+  for (int i = 0; i < 10; i++)
+  {
+    pool.submit([&]()
+                {
+      for (int j = 0; j < 10; j++)
+      {
+        pool.submit([&]()
+                    {
+          std::this_thread::sleep_for(std::chrono::microseconds(50));
+          leaves++; });
+      } });
+  }
+  pool.waitIdle();
+  CHECK(leaves.load() == 100);
+
+  // Throwing tasks are counted and the workers keep going
+  std::atomic<int> ran(0);
+  for (int i = 0; i < 40; i++)
+  {
+    pool.submit([&, i]()
+                {
+      ran++;
+      if (i % 4 == 0)
+      {
+        throw std::runtime_error("task failed");
+      } });
+  }
+  pool.waitIdle();
+  CHECK(ran.load() == 40);
+  CHECK(pool.getFailedTaskCount() == 10);
+
+  pool.submit([&]()
+              { ran++; });
+  pool.waitIdle();
+  CHECK(ran.load() == 41);
+}
+
+static void testBacklog()
+{
+  Config config;
+  OrderRepository repository;
+  OrderManager manager(nullptr, &config);
+  manager.setRepository(&repository);
+  Client *client = manager.findOrCreateClient("C1", "Smith");
+  for (int i = 0; i < 100; i++)
+  {
+    Order *order = manager.createOrder("B" + std::to_string(i), client, "2025-09-01 14:00", i % 2 == 0);
+    manager.addItemToOrder(order, "I" + std::to_string(i), 1, 10.0);
+  }
+
+  BacklogResult first = manager.processBacklog(4);
+  CHECK(first.processed == 100 && first.failed == 0 && first.failedTasks == 0);
+  CHECK(first.threadCount == 4);
+  CHECK(!manager.isConcurrentMode());
+
+  BacklogResult second = manager.processBacklog(4);
+  CHECK(second.completed == 100 && second.paid == 100 && second.failedTasks == 0);
+  CHECK(manager.getOrderCountByStatus(OrderStatus::COMPLETED) == 100);
+  CHECK(repository.getCount() == 100);
+  CHECK(!manager.isConcurrentMode());
+
+  // Stays on when it was on before
+  manager.enableConcurrentMode();
+  CHECK(manager.processBacklog(2).processed == 0);
+  CHECK(manager.isConcurrentMode());
+
+  // A summary line that throws must not leave concurrent mode switched on
+  BreakableDisplay display;
+  OrderManager failing(&display, &config);
+  Client *other = failing.findOrCreateClient("C2", "Jones");
+  failing.createOrder("F1", other, "2025-09-01 14:00", false);
+  display.broken = true;
+  bool threw = false;
+  try
+  {
+    failing.processBacklog(2);
+  }
+  catch (const std::runtime_error &)
+  {
+    threw = true;
+  }
+  CHECK(threw);
+  CHECK(!failing.isConcurrentMode());
+  CHECK(failing.findOrderById("F1")->getStatus() == OrderStatus::IN_PROGRESS);
+}
+
+int main()
+{
+  testStealing();
+  testWaitIdleAndFailures();
+  testBacklog();
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "✅ Work-stealing pool test passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * eventlog_decode - Render BinaryEventLog segments as text or JSON lines
+ *
+ * Usage: eventlog_decode [--json] <segment> [<segment> ...]
+ *
+ * Segments are decoded in the order given; pass them oldest first
+ * (the zero-padded numbering makes a shell glob sort correctly).
+ */
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+#include "implementations/EventLogReader.h"
+#include "exceptions/PhotoStudioExceptions.h"
+
+static std::string formatTimestamp(std::int64_t timestampNs)
+{
+  std::time_t seconds = static_cast<std::time_t>(timestampNs / 1000000000);
+  long micros = static_cast<long>((timestampNs % 1000000000) / 1000);
+  std::tm local;
+  localtime_r(&seconds, &local);
+
+  char text[40];
+  std::size_t length = std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+  std::snprintf(text + length, sizeof(text) - length, ".%06ld", micros);
+  return text;
+}
+
+int main(int argc, char **argv)
+{
+  bool json = false;
+  int first = 1;
+  if (argc > 1 && std::strcmp(argv[1], "--json") == 0)
+  {
+    json = true;
+    first = 2;
+  }
+
+  if (first >= argc)
+  {
+    std::cerr << "Usage: " << argv[0] << " [--json] <segment> [<segment> ...]" << std::endl;
+    return 2;
+  }
+
+  try
+  {
+    for (int i = first; i < argc; i++)
+    {
+      EventLogReader reader(argv[i]);
+      DecodedEvent event;
+      while (reader.next(event))
+      {
+        if (json)
+        {
+          std::cout << event.toJson() << '\n';
+        }
+        else
+        {
+          std::cout << formatTimestamp(event.timestampNs) << " "
+                    << EventLogReader::levelName(event.level) << " "
+                    << event.toText() << '\n';
+        }
+      }
+    }
+  }
+  catch (const PhotoStudioException &e)
+  {
+    std::cout.flush();
+    std::cerr << "Error: " << e.getUserMessage() << " (" << e.getTechnicalMessage() << ")" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * report_aggregation_bench - Revenue aggregation over large histories
+ *
+ * Usage: report_aggregation_bench [order-count ...]
+ *
+ * For each size (default 1M, 10M and 100M) fills a compact OrderFigure
+ * history and aggregates it with 1, 2, 4 and 8 threads, printing orders
+ * per second and checking that every thread count gives bit-identical
+ * totals. OrderFigure is 16 bytes, so 100M orders need 1.6 GB; sizes that
+ * cannot be allocated are reported and skipped. The first size is also
+ * run over real Order objects through OrderManager, capped at 1M.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "config/Config.h"
+#include "managers/OrderManager.h"
+#include "managers/ReportAggregation.h"
+
+static const unsigned THREAD_COUNTS[] = {1, 2, 4, 8};
+static const std::size_t ORDER_OBJECT_LIMIT = 1000000;
+
+static double ordersPerSecond(std::size_t orders, std::chrono::steady_clock::duration elapsed)
+{
+  double seconds = std::chrono::duration<double>(elapsed).count();
+  return seconds > 0 ? orders / seconds : 0;
+}
+
+static OrderFigure makeFigure(std::size_t i)
+{
+  OrderStatus status = static_cast<OrderStatus>(i % 4);
+  return OrderFigure(static_cast<long long>(500 + (i * 7919) % 20000), status,
+                     status == OrderStatus::COMPLETED && i % 8 != 2, i % 5 == 0);
+}
+
+template <typename Aggregate>
+static bool runThreads(const char *label, std::size_t count, Aggregate aggregate)
+{
+  RevenueTotals reference;
+  bool identical = true;
+  for (unsigned threads : THREAD_COUNTS)
+  {
+    ReportAggregator aggregator(threads);
+    auto start = std::chrono::steady_clock::now();
+    RevenueTotals totals = aggregate(aggregator);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    if (threads == THREAD_COUNTS[0])
+    {
+      reference = totals;
+    }
+    bool same = totals == reference;
+    identical = identical && same;
+    std::printf("%-8s %11zu orders  %u thread(s)  %12.0f orders/s  paid %lld cents%s\n", label, count, threads,
+                ordersPerSecond(count, elapsed), totals.paidCents, same ? "" : "  MISMATCH");
+  }
+  return identical;
+}
+
+static bool benchFigures(std::size_t count)
+{
+  std::vector<OrderFigure> figures;
+  try
+  {
+    figures.resize(count);
+  }
+  catch (const std::bad_alloc &)
+  {
+    std::printf("figures  %11zu orders  skipped: %zu MB could not be allocated\n", count,
+                count * sizeof(OrderFigure) / (1024 * 1024));
+    return true;
+  }
+  for (std::size_t i = 0; i < count; i++)
+  {
+    figures[i] = makeFigure(i);
+  }
+
+  return runThreads("figures", count, [&figures](const ReportAggregator &aggregator)
+                    { return aggregator.aggregate(figures.data(), figures.size()); });
+}
+
+static bool benchOrders(std::size_t count)
+{
+  Config config;
+  OrderManager manager(nullptr, &config);
+  Client *client = manager.findOrCreateClient("C001", "Bench");
+  for (std::size_t i = 0; i < count; i++)
+  {
+    Order *order = manager.createOrder("O" + std::to_string(i), client, "2025-09-01 14:00", i % 5 == 0);
+    manager.addItemToOrder(order, "I", 1 + static_cast<int>(i % 4), 2.5);
+  }
+  manager.processBacklog();
+  manager.processBacklog();
+
+  return runThreads("orders", count, [&manager](const ReportAggregator &aggregator)
+                    { return aggregator.aggregate(manager.getAllOrders()); });
+}
+
+int main(int argc, char **argv)
+{
+  std::vector<std::size_t> sizes;
+  for (int i = 1; i < argc; i++)
+  {
+    long long size = std::atoll(argv[i]);
+    if (size <= 0)
+    {
+      std::fprintf(stderr, "Usage: %s [order-count ...]\n", argv[0]);
+      return 1;
+    }
+    sizes.push_back(static_cast<std::size_t>(size));
+  }
+  if (sizes.empty())
+  {
+    sizes = {1000000, 10000000, 100000000};
+  }
+
+  bool identical = true;
+  for (std::size_t size : sizes)
+  {
+    identical = benchFigures(size) && identical;
+  }
+  identical = benchOrders(sizes[0] < ORDER_OBJECT_LIMIT ? sizes[0] : ORDER_OBJECT_LIMIT) && identical;
+
+  std::printf("%s\n", identical ? "Totals identical across thread counts" : "Totals DIFFER across thread counts");
+  return identical ? 0 : 1;
+}